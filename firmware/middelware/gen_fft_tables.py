@@ -0,0 +1,107 @@
+#!/usr/bin/env python3
+"""Generates the const FFT twiddle factor tables of esp-dsp for a maximum FFT size.
+
+The tables have the same layout as the ones built at run time by
+dsps_fft2r_init_fc32(), dsps_fft2r_init_sc16() and dsps_fft4r_init_fc32(), so
+those functions only have to point to them (see CONFIG_DSP_FFT_CONST_TABLES).
+
+    gen_fft_tables.py --size <CONFIG_DSP_MAX_FFT_SIZE> --output <file.c>
+"""
+
+import argparse
+import math
+
+
+def bit_reverse(value, bits):
+    result = 0
+    for _ in range(bits):
+        result = (result << 1) | (value & 1)
+        value >>= 1
+    return result
+
+
+def twiddles_r2(size):
+    """cos/sin of 2*pi*i/size, i < size/2, in bit reversed order (dsps_gen_w_r2 + dsps_bit_rev)"""
+    bits = int(math.log2(size // 2))
+    angles = [2 * math.pi * bit_reverse(i, bits) / size for i in range(size // 2)]
+    return [(math.cos(a), math.sin(a)) for a in angles]
+
+
+def twiddles_r4(max_fft_size):
+    """cos/sin of 2*pi*i/(2*max_fft_size), natural order (dsps_fft4r_init_fc32)"""
+    size = 2 * max_fft_size
+    return [(math.cos(2 * math.pi * i / size), math.sin(2 * math.pi * i / size)) for i in range(size)]
+
+
+def format_float(value):
+    text = '%.9g' % value
+    if 'e' not in text and '.' not in text:
+        text += '.0'
+    return text + 'f'
+
+
+def format_table(values, per_line):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append('    ' + ', '.join(values[i:i + per_line]) + ',')
+    return '\n'.join(lines)
+
+
+def generate(size):
+    r2 = twiddles_r2(size)
+    r4 = twiddles_r4(size // 2)
+    fc32_r2 = [format_float(v) for pair in r2 for v in pair]
+    # Same rounding as dsps_gen_w_r2_sc16(): truncation of INT16_MAX * value
+    sc16_r2 = [str(int(32767 * v)) for pair in r2 for v in pair]
+    fc32_r4 = [format_float(v) for pair in r4 for v in pair]
+
+    return f'''// Generated by gen_fft_tables.py for CONFIG_DSP_MAX_FFT_SIZE = {size}, do not edit.
+
+#include <stdint.h>
+#include "sdkconfig.h"
+#include "dsps_fft2r.h"
+
+#if CONFIG_DSP_MAX_FFT_SIZE != {size}
+#error "FFT tables generated for a different CONFIG_DSP_MAX_FFT_SIZE"
+#endif
+
+const int dsps_fft_const_tables_size = {size};
+
+// Radix 2, {size // 2} complex values in bit reversed order
+const float dsps_fft2r_w_table_fc32_const[{2 * len(r2)}] __attribute__((aligned(16))) = {{
+{format_table(fc32_r2, 8)}
+}};
+
+const int16_t dsps_fft2r_w_table_sc16_const[{2 * len(r2)}] __attribute__((aligned(16))) = {{
+{format_table(sc16_r2, 16)}
+}};
+
+// Radix 4 (and real FFT unpacking) for FFTs of up to {size // 2} complex values
+const float dsps_fft4r_w_table_fc32_const[{2 * len(r4)}] __attribute__((aligned(16))) = {{
+{format_table(fc32_r4, 8)}
+}};
+'''
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('--size', type=int, required=True, help='CONFIG_DSP_MAX_FFT_SIZE')
+    parser.add_argument('--output', required=True, help='Generated C file')
+    args = parser.parse_args()
+    if args.size < 4 or (args.size & (args.size - 1)) != 0:
+        parser.error('size must be a power of two')
+
+    content = generate(args.size)
+    # Keep the file (and its timestamp) when nothing changed
+    try:
+        with open(args.output) as f:
+            if f.read() == content:
+                return
+    except OSError:
+        pass
+    with open(args.output, 'w') as f:
+        f.write(content)
+
+
+if __name__ == '__main__':
+    main()
@@ -60,6 +60,8 @@ extern "C"
 
 #ifdef __cplusplus
 #include "mat.h"
+#include "mat_fixed.h"
+#include "mat_factor.h"
 #endif
 
 #endif // _esp_dsp_H_
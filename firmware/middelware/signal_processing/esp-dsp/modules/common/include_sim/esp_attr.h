@@ -17,5 +17,7 @@
 #ifndef _esp_attr_h_
 #define _esp_attr_h_
 
+#define IRAM_ATTR
+#define FORCE_INLINE_ATTR static inline __attribute__((always_inline))
 
 #endif // _esp_attr_h_
@@ -0,0 +1,34 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// RISC-V (RV32IMAC) C implementation: 16x16 products are formed with the 32 bit
+// multiplier and added in pairs to a 64 bit accumulator. Results are bit exact
+// with dsps_dotprod_s16_ansi().
+
+#include "dsps_dotprod.h"
+
+esp_err_t dsps_dotprod_s16_rv32(const int16_t *src1, const int16_t *src2, int16_t *dest, int len, int8_t shift)
+{
+    const int16_t *restrict x = src1;
+    const int16_t *restrict y = src2;
+    // To make correct round operation we have to shift round value
+    long long acc = 0x7fff >> shift;
+    int i = 0;
+    for (; i <= len - 4; i += 4) {
+        int32_t p0 = (int32_t)x[i + 0] * y[i + 0];
+        int32_t p1 = (int32_t)x[i + 1] * y[i + 1];
+        int32_t p2 = (int32_t)x[i + 2] * y[i + 2];
+        int32_t p3 = (int32_t)x[i + 3] * y[i + 3];
+        acc += (long long)p0 + p1;
+        acc += (long long)p2 + p3;
+    }
+    for (; i < len; i++) {
+        acc += (int32_t)x[i] * y[i];
+    }
+    int final_shift = shift - 15;
+    if (final_shift > 0) {
+        *dest = (acc << final_shift);
+    } else {
+        *dest = (acc >> (-final_shift));
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// RISC-V (RV32IMAC) C implementation: four independent accumulators hide the
+// latency of the (soft-float) additions and halve the loop overhead.
+
+#include "dsps_dotprod.h"
+
+esp_err_t dsps_dotprod_f32_rv32(const float *src1, const float *src2, float *dest, int len)
+{
+    const float *restrict x = src1;
+    const float *restrict y = src2;
+    float acc0 = 0;
+    float acc1 = 0;
+    float acc2 = 0;
+    float acc3 = 0;
+    int i = 0;
+    for (; i <= len - 4; i += 4) {
+        acc0 += x[i + 0] * y[i + 0];
+        acc1 += x[i + 1] * y[i + 1];
+        acc2 += x[i + 2] * y[i + 2];
+        acc3 += x[i + 3] * y[i + 3];
+    }
+    for (; i < len; i++) {
+        acc0 += x[i] * y[i];
+    }
+    *dest = (acc0 + acc1) + (acc2 + acc3);
+    return ESP_OK;
+}
@@ -28,5 +28,10 @@
 #define dsps_dotprod_f32_aes3_enabled 1
 #endif
 
+#if defined(__riscv) && !CONFIG_DSP_ANSI
+#define dsps_dotprod_s16_rv32_enabled 1
+#define dsps_dotprod_f32_rv32_enabled 1
+#endif // __riscv
+
 
 #endif // _dsps_dotprod_platform_H_
@@ -78,6 +78,14 @@ esp_err_t dsps_fft2r_init_sc16(int16_t *fft_table_buff, int table_size)
     if (table_size == 0) {
         return result;
     }
+#if CONFIG_DSP_FFT_CONST_TABLES
+    if ((fft_table_buff == NULL) && !dsps_fft2r_sc16_mem_allocated) {
+        dsps_fft_w_table_sc16 = (int16_t *)dsps_fft2r_w_table_sc16_const;
+        dsps_fft_w_table_sc16_size = dsps_fft_const_tables_size;
+        dsps_fft2r_sc16_initialized = 1;
+        return ESP_OK;
+    }
+#endif // CONFIG_DSP_FFT_CONST_TABLES
     if (fft_table_buff != NULL) {
         if (dsps_fft2r_sc16_mem_allocated) {
             return ESP_ERR_DSP_REINITIALIZED;
@@ -191,6 +199,21 @@ esp_err_t dsps_bit_rev_sc16_ansi(int16_t *data, int N)
     int j, k;
     uint32_t temp;
     uint32_t *in_data = (uint32_t *)data;
+
+    // The fc32 lookup tables (in flash) hold the same swaps, as offsets of 8 byte complex values
+    int pow = dsp_power_of_two(N);
+    if ((pow >= 4) && (pow <= 12)) {
+        const uint16_t *table = dsps_fft2r_rev_tables_fc32[pow - 4];
+        for (int n = 0; n < dsps_fft2r_rev_tables_fc32_size[pow - 4]; n++) {
+            uint16_t i = table[n * 2 + 0] >> 3;
+            uint16_t m = table[n * 2 + 1] >> 3;
+            temp = in_data[m];
+            in_data[m] = in_data[i];
+            in_data[i] = temp;
+        }
+        return result;
+    }
+
     j = 0;
     for (int i = 1; i < (N - 1); i++) {
         k = N >> 1;
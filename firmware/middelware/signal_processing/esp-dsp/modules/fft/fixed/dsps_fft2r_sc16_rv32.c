@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// RISC-V (RV32IMAC) C implementation of the radix-2 sc16 FFT. Each butterfly
+// computes the two cross products once and shares them between both outputs,
+// with 32 bit wrap-around arithmetic. Results are bit exact with
+// dsps_fft2r_sc16_ansi().
+
+#include "dsps_fft2r.h"
+#include "dsp_common.h"
+#include "dsp_types.h"
+
+esp_err_t dsps_fft2r_sc16_rv32_(int16_t *data, int N, int16_t *sc_table)
+{
+    if (!dsp_is_power_of_two(N)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if (!dsps_fft2r_sc16_initialized) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+
+    const uint32_t *restrict w = (const uint32_t *)sc_table;
+    uint32_t *restrict in_data = (uint32_t *)data;
+
+    int ie = 1;
+    for (int N2 = N / 2; N2 > 0; N2 >>= 1) {
+        uint32_t *a_ptr = in_data;
+        for (int j = 0; j < ie; j++) {
+            sc16_t cs;
+            cs.data = w[j];
+            const int32_t c = cs.re;
+            const int32_t s = cs.im;
+            uint32_t *m_ptr = a_ptr + N2;
+            for (int i = 0; i < N2; i++) {
+                sc16_t a_data;
+                sc16_t m_data;
+                a_data.data = a_ptr[i];
+                m_data.data = m_ptr[i];
+                // (a * 0x7fff -/+ (w * m) + 0x7fff) >> 16
+                uint32_t t_re = (uint32_t)(c * m_data.re) + (uint32_t)(s * m_data.im);
+                uint32_t t_im = (uint32_t)(c * m_data.im) - (uint32_t)(s * m_data.re);
+                uint32_t base_re = (uint32_t)(a_data.re * 0x7fff) + 0x7fff;
+                uint32_t base_im = (uint32_t)(a_data.im * 0x7fff) + 0x7fff;
+                sc16_t m1;
+                m1.re = (int16_t)((int32_t)(base_re - t_re) >> 16);
+                m1.im = (int16_t)((int32_t)(base_im - t_im) >> 16);
+                m_ptr[i] = m1.data;
+                sc16_t m2;
+                m2.re = (int16_t)((int32_t)(base_re + t_re) >> 16);
+                m2.im = (int16_t)((int32_t)(base_im + t_im) >> 16);
+                a_ptr[i] = m2.data;
+            }
+            a_ptr += 2 * N2;
+        }
+        ie <<= 1;
+    }
+    return ESP_OK;
+}
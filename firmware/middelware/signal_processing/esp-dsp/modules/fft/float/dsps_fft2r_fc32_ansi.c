@@ -49,6 +49,15 @@ esp_err_t dsps_fft2r_init_fc32(float *fft_table_buff, int table_size)
     if (table_size == 0) {
         return result;
     }
+#if CONFIG_DSP_FFT_CONST_TABLES
+    if ((fft_table_buff == NULL) && !dsps_fft2r_mem_allocated) {
+        // Bit reversed tables are valid for any FFT up to their size, nothing to compute or allocate
+        dsps_fft_w_table_fc32 = (float *)dsps_fft2r_w_table_fc32_const;
+        dsps_fft_w_table_size = dsps_fft_const_tables_size;
+        dsps_fft2r_initialized = 1;
+        return ESP_OK;
+    }
+#endif // CONFIG_DSP_FFT_CONST_TABLES
     if (fft_table_buff != NULL) {
         if (dsps_fft2r_mem_allocated) {
             return ESP_ERR_DSP_REINITIALIZED;
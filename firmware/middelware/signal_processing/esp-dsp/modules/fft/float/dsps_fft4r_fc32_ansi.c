@@ -43,6 +43,16 @@ esp_err_t dsps_fft4r_init_fc32(float *fft_table_buff, int max_fft_size)
     if (max_fft_size == 0) {
         return result;
     }
+#if CONFIG_DSP_FFT_CONST_TABLES
+    // The const table covers FFTs of up to CONFIG_DSP_MAX_FFT_SIZE / 2 complex values,
+    // (real FFTs of CONFIG_DSP_MAX_FFT_SIZE samples), bigger ones use a table in RAM
+    if ((fft_table_buff == NULL) && !dsps_fft4r_mem_allocated && (max_fft_size <= dsps_fft_const_tables_size / 2)) {
+        dsps_fft4r_w_table_fc32 = (float *)dsps_fft4r_w_table_fc32_const;
+        dsps_fft4r_w_table_size = dsps_fft_const_tables_size;
+        dsps_fft4r_initialized = 1;
+        return ESP_OK;
+    }
+#endif // CONFIG_DSP_FFT_CONST_TABLES
     if (fft_table_buff != NULL) {
         if (dsps_fft4r_mem_allocated) {
             return ESP_ERR_DSP_REINITIALIZED;
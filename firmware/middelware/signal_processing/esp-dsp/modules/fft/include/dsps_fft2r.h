@@ -97,6 +97,7 @@ esp_err_t dsps_fft2r_fc32_aes3_(float *data, int N, float *w);
 esp_err_t dsps_fft2r_sc16_ansi_(int16_t *data, int N, int16_t *w);
 esp_err_t dsps_fft2r_sc16_ae32_(int16_t *data, int N, int16_t *w);
 esp_err_t dsps_fft2r_sc16_aes3_(int16_t *data, int N, int16_t *w);
+esp_err_t dsps_fft2r_sc16_rv32_(int16_t *data, int N, int16_t *w);
 /**@}*/
 // This is workaround because linker generates permanent error when assembler uses
 // direct access to the table pointer
@@ -106,6 +107,7 @@ esp_err_t dsps_fft2r_sc16_aes3_(int16_t *data, int N, int16_t *w);
 #define dsps_fft2r_sc16_aes3(data, N) dsps_fft2r_sc16_aes3_(data, N, dsps_fft_w_table_sc16)
 #define dsps_fft2r_fc32_ansi(data, N) dsps_fft2r_fc32_ansi_(data, N, dsps_fft_w_table_fc32)
 #define dsps_fft2r_sc16_ansi(data, N) dsps_fft2r_sc16_ansi_(data, N, dsps_fft_w_table_sc16)
+#define dsps_fft2r_sc16_rv32(data, N) dsps_fft2r_sc16_rv32_(data, N, dsps_fft_w_table_sc16)
 
 
 /**@{*/
@@ -205,6 +207,7 @@ esp_err_t dsps_gen_bitrev2r_table(int N, int step, char *name_ext);
 #if CONFIG_DSP_OPTIMIZED
 #define dsps_bit_rev_fc32 dsps_bit_rev_fc32_ansi
 #define dsps_cplx2reC_fc32 dsps_cplx2reC_fc32_ansi
+#define dsps_bit_rev_sc16 dsps_bit_rev_sc16_ansi
 
 #if (dsps_fft2r_fc32_aes3_enabled == 1)
 #define dsps_fft2r_fc32 dsps_fft2r_fc32_aes3
@@ -218,6 +221,8 @@ esp_err_t dsps_gen_bitrev2r_table(int N, int step, char *name_ext);
 #define dsps_fft2r_sc16 dsps_fft2r_sc16_aes3
 #elif (dsps_fft2r_sc16_ae32_enabled == 1)
 #define dsps_fft2r_sc16 dsps_fft2r_sc16_ae32
+#elif (dsps_fft2r_sc16_rv32_enabled == 1)
+#define dsps_fft2r_sc16 dsps_fft2r_sc16_rv32
 #else
 #define dsps_fft2r_sc16 dsps_fft2r_sc16_ansi
 #endif
@@ -235,6 +240,11 @@ esp_err_t dsps_gen_bitrev2r_table(int N, int step, char *name_ext);
 #else // CONFIG_DSP_OPTIMIZED
 
 #define dsps_fft2r_fc32 dsps_fft2r_fc32_ansi
+#if (dsps_fft2r_sc16_rv32_enabled == 1)
+#define dsps_fft2r_sc16 dsps_fft2r_sc16_rv32
+#else
+#define dsps_fft2r_sc16 dsps_fft2r_sc16_ansi
+#endif
 #define dsps_bit_rev_fc32 dsps_bit_rev_fc32_ansi
 #define dsps_cplx2reC_fc32 dsps_cplx2reC_fc32_ansi
 #define dsps_bit_rev_sc16 dsps_bit_rev_sc16_ansi
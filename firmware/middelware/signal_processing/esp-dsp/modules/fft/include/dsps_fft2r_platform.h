@@ -32,5 +32,9 @@
 #define dsps_fft2r_sc16_aes3_enabled 1
 #endif
 
+#if defined(__riscv) && !CONFIG_DSP_ANSI
+#define dsps_fft2r_sc16_rv32_enabled 1
+#endif // __riscv
+
 
 #endif // _dsps_fft2r_platform_H_
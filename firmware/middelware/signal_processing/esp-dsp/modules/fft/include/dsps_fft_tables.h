@@ -82,6 +82,14 @@ void dsps_fft4r_rev_tables_init_fc32(void);
 extern uint16_t *dsps_fft4r_rev_tables_fc32[];
 extern const uint16_t dsps_fft4r_rev_tables_fc32_size[];
 
+#if CONFIG_DSP_FFT_CONST_TABLES
+// Twiddle factor tables generated at build time (gen_fft_tables.py) for CONFIG_DSP_MAX_FFT_SIZE
+extern const int dsps_fft_const_tables_size;
+extern const float dsps_fft2r_w_table_fc32_const[];
+extern const int16_t dsps_fft2r_w_table_sc16_const[];
+extern const float dsps_fft4r_w_table_fc32_const[];
+#endif // CONFIG_DSP_FFT_CONST_TABLES
+
 #ifdef __cplusplus
 }
 #endif
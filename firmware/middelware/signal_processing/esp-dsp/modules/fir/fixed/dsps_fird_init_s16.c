@@ -33,7 +33,7 @@ esp_err_t dsps_fird_init_s16(fir_s16_t *fir, int16_t *coeffs, int16_t *delay, in
         return ESP_ERR_DSP_PARAM_OUTOFRANGE;
     }
 
-#if CONFIG_DSP_OPTIMIZED
+#if CONFIG_DSP_OPTIMIZED && ((dsps_fird_s16_ae32_enabled == 1) || (dsps_fird_s16_aes3_enabled == 1))
 
     // Rounding value buffer primary for a purpose of ee.ld.accx.ip, but used for both the esp32 and esp32s3
     // dsps_fird_s16_aexx_free() must be called to free the memory after the FIR function is finished
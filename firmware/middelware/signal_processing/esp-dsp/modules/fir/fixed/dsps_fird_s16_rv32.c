@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// RISC-V (RV32IMAC) C implementation: the circular delay line is walked as two
+// linear segments, 16x16 products are formed with the 32 bit multiplier and added
+// in pairs to a 64 bit accumulator. Results are bit exact with dsps_fird_s16_ansi().
+
+#include "dsps_fir.h"
+
+// Coefficients are applied in reverse order: coeffs[len - 1 - i] * delay[i]
+static inline long long dsps_fird_s16_rv32_mac(long long acc, const int16_t *restrict coeffs, const int16_t *restrict delay, int len)
+{
+    int i = 0;
+    for (; i <= len - 2; i += 2) {
+        int32_t p0 = (int32_t)coeffs[-i] * delay[i];
+        int32_t p1 = (int32_t)coeffs[-i - 1] * delay[i + 1];
+        acc += (long long)p0 + p1;
+    }
+    if (i < len) {
+        acc += (int32_t)coeffs[-i] * delay[i];
+    }
+    return acc;
+}
+
+int32_t dsps_fird_s16_rv32(fir_s16_t *fir, const int16_t *input, int16_t *output, int32_t len)
+{
+    const int32_t final_shift = fir->shift - 15;
+    const int16_t *coeffs = fir->coeffs;
+    int16_t *delay = fir->delay;
+    int32_t N = fir->coeffs_len;
+    int32_t pos = fir->pos;
+    int32_t input_pos = 0;
+    long long rounding = (long long)(fir->rounding_val);
+
+    if (fir->shift >= 0) {
+        rounding = (rounding >> fir->shift) & 0xFFFFFFFFFF;         // 40-bit mask
+    } else {
+        rounding = (rounding << (-fir->shift)) & 0xFFFFFFFFFF;      // 40-bit mask
+    }
+
+    // len is already a length of the *output array, calculated as (length of the input array / decimation)
+    for (int i = 0; i < len; i++) {
+        for (int j = 0; j < fir->decim - fir->d_pos; j++) {
+            if (pos >= N) {
+                pos = 0;
+            }
+            delay[pos++] = input[input_pos++];
+        }
+        fir->d_pos = 0;
+
+        long long acc = dsps_fird_s16_rv32_mac(rounding, &coeffs[N - 1], &delay[pos], N - pos);
+        if (pos > 0) {
+            acc = dsps_fird_s16_rv32_mac(acc, &coeffs[pos - 1], delay, pos);
+        }
+
+        if (final_shift > 0) {
+            output[i] = (int16_t)(acc << final_shift);
+        } else {
+            output[i] = (int16_t)(acc >> (-final_shift));
+        }
+    }
+    fir->pos = pos;
+    return len;
+}
@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// RISC-V (RV32IMAC) C implementation: the circular delay line is walked as two
+// linear segments, each unrolled by four with independent accumulators.
+
+#include "dsps_fir.h"
+
+static inline float dsps_fir_f32_rv32_mac(const float *restrict coeffs, const float *restrict delay, int len)
+{
+    float acc0 = 0;
+    float acc1 = 0;
+    float acc2 = 0;
+    float acc3 = 0;
+    int i = 0;
+    for (; i <= len - 4; i += 4) {
+        acc0 += coeffs[i + 0] * delay[i + 0];
+        acc1 += coeffs[i + 1] * delay[i + 1];
+        acc2 += coeffs[i + 2] * delay[i + 2];
+        acc3 += coeffs[i + 3] * delay[i + 3];
+    }
+    for (; i < len; i++) {
+        acc0 += coeffs[i] * delay[i];
+    }
+    return (acc0 + acc1) + (acc2 + acc3);
+}
+
+esp_err_t dsps_fir_f32_rv32(fir_f32_t *fir, const float *input, float *output, int len)
+{
+    const float *coeffs = fir->coeffs;
+    float *delay = fir->delay;
+    int N = fir->N;
+    int pos = fir->pos;
+    for (int i = 0 ; i < len ; i++) {
+        delay[pos] = input[i];
+        pos++;
+        if (pos >= N) {
+            pos = 0;
+        }
+        // Oldest sample is at pos: coeffs[0] multiplies delay[pos]
+        float acc = dsps_fir_f32_rv32_mac(coeffs, &delay[pos], N - pos);
+        acc += dsps_fir_f32_rv32_mac(&coeffs[N - pos], delay, pos);
+        output[i] = acc;
+    }
+    fir->pos = pos;
+    return ESP_OK;
+}
@@ -28,4 +28,10 @@
 #endif //
 #endif // __XTENSA__
 
+#if defined(__riscv) && !CONFIG_DSP_ANSI
+#define dsps_fir_f32_rv32_enabled 1
+#define dsps_fird_f32_rv32_enabled 1
+#define dsps_fird_s16_rv32_enabled 1
+#endif // __riscv
+
 #endif // _dsps_fir_platform_H_
@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// RISC-V (RV32IMAC) C implementation: coefficients and state are kept in
+// registers for the whole block. Same operation order as dsps_biquad_f32_ansi(),
+// so results are bit exact.
+
+#include "dsps_biquad.h"
+
+esp_err_t dsps_biquad_f32_rv32(const float *input, float *output, int len, float *coef, float *w)
+{
+    const float b0 = coef[0];
+    const float b1 = coef[1];
+    const float b2 = coef[2];
+    const float a1 = coef[3];
+    const float a2 = coef[4];
+    float w0 = w[0];
+    float w1 = w[1];
+    for (int i = 0 ; i < len ; i++) {
+        float d0 = input[i] - a1 * w0 - a2 * w1;
+        output[i] = b0 * d0 + b1 * w0 + b2 * w1;
+        w1 = w0;
+        w0 = d0;
+    }
+    w[0] = w0;
+    w[1] = w1;
+    return ESP_OK;
+}
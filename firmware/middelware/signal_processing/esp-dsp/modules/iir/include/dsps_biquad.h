@@ -32,6 +32,7 @@ extern "C"
  * IIR filter 2nd order direct form II (bi quad)
  * The extension (_ansi) use ANSI C and could be compiled and run on any platform.
  * The extension (_ae32) is optimized for ESP32 chip.
+ * The extension (_rv32) is optimized C for RISC-V (ESP32-C6) chips.
  *
  * @param[in] input: input array
  * @param output: output array
@@ -46,6 +47,7 @@ extern "C"
 esp_err_t dsps_biquad_f32_ansi(const float *input, float *output, int len, float *coef, float *w);
 esp_err_t dsps_biquad_f32_ae32(const float *input, float *output, int len, float *coef, float *w);
 esp_err_t dsps_biquad_f32_aes3(const float *input, float *output, int len, float *coef, float *w);
+esp_err_t dsps_biquad_f32_rv32(const float *input, float *output, int len, float *coef, float *w);
 /**@}*/
 
 
@@ -59,13 +61,19 @@ esp_err_t dsps_biquad_f32_aes3(const float *input, float *output, int len, float
 #define dsps_biquad_f32 dsps_biquad_f32_ae32
 #elif (dsps_biquad_f32_aes3_enabled == 1)
 #define dsps_biquad_f32 dsps_biquad_f32_aes3
+#elif (dsps_biquad_f32_rv32_enabled == 1)
+#define dsps_biquad_f32 dsps_biquad_f32_rv32
 #else
 #define dsps_biquad_f32 dsps_biquad_f32_ansi
 #endif
 
 #else // CONFIG_DSP_OPTIMIZED
 
+#if (dsps_biquad_f32_rv32_enabled == 1)
+#define dsps_biquad_f32 dsps_biquad_f32_rv32
+#else
 #define dsps_biquad_f32 dsps_biquad_f32_ansi
+#endif
 
 #endif // CONFIG_DSP_OPTIMIZED
 
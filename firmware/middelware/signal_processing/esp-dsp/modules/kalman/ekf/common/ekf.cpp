@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include "ekf.h"
+#include "mat_factor.h"
+#include "esp_log.h"
 #include <float.h>
 
 ekf::ekf(int x, int w) : NUMX(x),
@@ -45,8 +47,8 @@ ekf::~ekf()
     delete &P;
     delete &Q;
 
-    delete this->HP;
-    delete this->Km;
+    delete[] this->HP;
+    delete[] this->Km;
 }
 
 void ekf::Process(float *u, float dt)
@@ -141,8 +143,13 @@ void ekf::CovariancePrediction(float dt)
 
     f = f + dspm::Mat::eye(this->NUMX);
 
-    dspm::Mat f_t = f.t();
-    this->P = ((f * this->P) * f_t) + (dt * dt) * ((G * Q) * G.t());
+    // P = f*P*f' + dt^2*G*Q*G', without transposed copies
+    dspm::Mat fP(this->NUMX, this->NUMX);
+    dspm::Mat GQ(this->NUMX, this->NUMW);
+    dspm::Mat::gemm(1, f, false, this->P, false, 0, fP);
+    dspm::Mat::gemm(1, this->G, false, this->Q, false, 0, GQ);
+    dspm::Mat::gemm(1, fP, false, f, true, 0, this->P);
+    dspm::Mat::gemm(dt * dt, GQ, false, this->G, true, 1, this->P);
 }
 
 void ekf::Update(dspm::Mat &H, float *measured, float *expected, float *R)
@@ -193,9 +200,14 @@ void ekf::UpdateRef(dspm::Mat &H, float *measured, float *expected, float *R)
         S(i, i) += R[i];
     }
 
-    dspm::Mat S_ = S.pinv(); // 1 / S
+    dspm::MatLDLT S_(S); // S is symmetric
+    if (!S_.valid) {
+        // S is singular (e.g. a row of H is 0 and its R is 0): the measurement has no information
+        ESP_LOGW("ekf", "UpdateRef: S is singular, the measurement is not used");
+        return;
+    }
 
-    dspm::Mat K = (P * h_t) * S_;
+    dspm::Mat K = S_.solve(H * P).t(); // K = P*H'/S = (S\(H*P))'
     this->P = (dspm::Mat::eye(this->NUMX) - K * H) * P;
 
     dspm::Mat Y(measured, H.rows, 1);
@@ -143,6 +143,7 @@ public:
      * Update of current state by measured values.
      * This method just as a reference for research purpose.
      * Not used in real calculations.
+     * If H*P*H' + diag(R) is singular, the state and covariance are not changed.
      * @param[in] H: derivative matrix
      * @param[in] measured: array of measured values
      * @param[in] expected: array of expected values
@@ -0,0 +1,696 @@
+// Copyright 2020-2021 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef _ekf_fixed_h_
+#define _ekf_fixed_h_
+
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+#include <mat_fixed.h>
+#include <mat.h>
+
+/**
+ * The ekf_fixed is a base class for Extended Kalman Filter with the number of
+ * states and noise inputs known at compile time.
+ * It has the same processing flow as ekf, with three differences that make the
+ * steps cheaper:
+ * - All the matrices (and the workspace) are members, so Process() and Update()
+ *   never allocate memory.
+ * - The covariance P is symmetric, and only its upper triangle is stored and
+ *   updated.
+ * - The products by F and G only use the entries declared as non zero by the
+ *   derived filter (SparsityF() / SparsityG(), all of them by default).
+ *
+ * The measurement update is sequential, one scalar measurement at a time, as in
+ * ekf::Update(): measurement noises must be uncorrelated.
+ *
+ * @tparam NX: amount of states in EKF. x[n] = F*x[n-1] + G*u + W. Size of matrix F
+ * @tparam NW: amount of control measurements and noise inputs. Size of matrix G
+ */
+template <int NX, int NW>
+class ekf_fixed {
+public:
+    typedef dspm::MatFixed<NX, 1> state_t;    /*!< System state vector type*/
+
+    enum {
+        NUMX = NX,                  /*!< Number of states, X is the state vector (size of F matrix)*/
+        NUMW = NW,                  /*!< The size of G matrix*/
+        NUMP = NX * (NX + 1) / 2    /*!< Number of stored values of the covariance matrix*/
+    };
+
+    /**
+     * Constructor of EKF.
+     * All the matrices are set to 0, except the first state (direction to 0),
+     * and all the entries of F and G are used.
+     */
+    ekf_fixed()
+    {
+        this->X(0, 0) = 1; // direction to 0
+        for (int i = 0; i < NX; i++) {
+            this->HP[i] = 0;
+            this->Km[i] = 0;
+        }
+        for (int i = 0; i < NUMP; i++) {
+            this->P[i] = 0;
+        }
+        SparsityDense();
+    }
+
+    /**
+     * Distructor of EKF
+    */
+    virtual ~ekf_fixed() {}
+
+    /**
+     * Main processing method of the EKF.
+     *
+     * @param[in] u: - input measurements
+     * @param[in] dt: - time difference from the last call in seconds
+    */
+    virtual void Process(float *u, float dt)
+    {
+        this->LinearizeFG(this->X, u);
+        this->RungeKutta(this->X, u, dt);
+        this->CovariancePrediction(dt);
+    }
+
+    /**
+     * Initialization of EKF.
+     * The method should be called befare the first use of the filter.
+    */
+    virtual void Init() = 0;
+
+    /**
+     * System state vector
+    */
+    state_t X;
+
+    /**
+     * Linearized system matrices F, where x[n] = F*x[n-1] + G*u + W
+    */
+    dspm::MatFixed<NX, NX> F;
+    /**
+     * Linearized system matrices G, where x[n] = F*x[n-1] + G*u + W
+    */
+    dspm::MatFixed<NX, NW> G;
+
+    /**
+    * Covariance matrix, upper triangle stored row by row:
+    * P(0,0) ... P(0,NX-1), P(1,1) ... P(1,NX-1), ... P(NX-1,NX-1).
+    * Use Pij() to access an element.
+    */
+    float P[NUMP];
+
+    /**
+     * Input noise and measurement noise variances
+    */
+    dspm::MatFixed<NW, NW> Q;
+
+    /**
+     * Access to an element of the covariance matrix.
+     * @param[in] row: row position
+     * @param[in] col: column position
+     *
+     * @return
+     *      - element P(row, col), that is also P(col, row)
+     */
+    inline float &Pij(int row, int col)
+    {
+        return this->P[PIndex(row, col)];
+    }
+
+    /**
+     * Copy the covariance matrix into a full matrix.
+     * @param[out] result: covariance matrix NX x NX
+     */
+    void GetP(dspm::MatFixed<NX, NX> &result) const
+    {
+        for (int i = 0; i < NX; i++) {
+            for (int j = i; j < NX; j++) {
+                result(i, j) = result(j, i) = this->P[PIndex(i, j)];
+            }
+        }
+    }
+
+    /**
+     * Copy the covariance matrix into a full dspm::Mat, for code written for the
+     * P member of ekf.
+     * @param[out] result: covariance matrix NX x NX
+     */
+    void GetP(dspm::Mat &result) const
+    {
+        for (int i = 0; i < NX; i++) {
+            for (int j = i; j < NX; j++) {
+                result(i, j) = result(j, i) = this->P[PIndex(i, j)];
+            }
+        }
+    }
+
+    /**
+     * Use all the entries of F and G (dense products).
+     */
+    void SparsityDense()
+    {
+        SparsityClear();
+        SparsityF(0, 0, NX, NX);
+        SparsityG(0, 0, NX, NW);
+    }
+
+    /**
+     * Remove all the entries of F and G, before declaring the non zero ones.
+     */
+    void SparsityClear()
+    {
+        for (int i = 0; i < NX; i++) {
+            this->f_count[i] = 0;
+            this->g_count[i] = 0;
+        }
+    }
+
+    /**
+     * Declare a block of F that can have non zero values.
+     * The entries outside the declared blocks are not read.
+     * @param[in] row: start row of the block
+     * @param[in] col: start column of the block
+     * @param[in] rows: number of rows of the block
+     * @param[in] cols: number of columns of the block
+     */
+    void SparsityF(int row, int col, int rows, int cols)
+    {
+        for (int r = row; r < row + rows; r++) {
+            for (int c = col; c < col + cols; c++) {
+                AddEntry(this->f_cols[r], this->f_count[r], c);
+            }
+        }
+    }
+
+    /**
+     * Declare a block of G that can have non zero values.
+     * The entries outside the declared blocks are not read.
+     * @param[in] row: start row of the block
+     * @param[in] col: start column of the block
+     * @param[in] rows: number of rows of the block
+     * @param[in] cols: number of columns of the block
+     */
+    void SparsityG(int row, int col, int rows, int cols)
+    {
+        for (int r = row; r < row + rows; r++) {
+            for (int c = col; c < col + cols; c++) {
+                AddEntry(this->g_cols[r], this->g_count[r], c);
+            }
+        }
+    }
+
+    /**
+     * Check the declared entries against the current F and G.
+     * Method for development and tests only.
+     *
+     * @return
+     *      - true if F and G have no non zero value outside the declared entries
+     */
+    bool SparsityCovers() const
+    {
+        for (int i = 0; i < NX; i++) {
+            for (int j = 0; j < NX; j++) {
+                if ((this->F(i, j) != 0) && !HasEntry(this->f_cols[i], this->f_count[i], j)) {
+                    return false;
+                }
+            }
+            for (int j = 0; j < NW; j++) {
+                if ((this->G(i, j) != 0) && !HasEntry(this->g_cols[i], this->g_count[i], j)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Runge-Kutta state update method.
+     * The method calculates derivatives of input vector x and control measurements u
+     *
+     * @param[in] x: state vector
+     * @param[in] u: control measurement
+     * @param[in] dt: time interval from last update in seconds
+     */
+    void RungeKutta(state_t &x, float *u, float dt)
+    {
+        float dt2 = dt / 2.0f;
+
+        state_t Xlast = x; // make a working copy
+        state_t K1, K2, K3, K4;
+        StateXdot(x, u, K1); // k1 = f(x, u)
+        x = Xlast + K1 * dt2;
+
+        StateXdot(x, u, K2); // k2 = f(x + 0.5*dT*k1, u)
+        x = Xlast + K2 * dt2;
+
+        StateXdot(x, u, K3); // k3 = f(x + 0.5*dT*k2, u)
+        x = Xlast + K3 * dt;
+
+        StateXdot(x, u, K4); // k4 = f(x + dT * k3, u)
+
+        // Xnew = X + dT * (k1 + 2 * k2 + 2 * k3 + k4) / 6
+        float k = dt / 6.0f;
+        for (int i = 0; i < NX; i++) {
+            x[i] = Xlast[i] + (K1[i] + 2.0f * K2[i] + 2.0f * K3[i] + K4[i]) * k;
+        }
+    }
+
+    // System Dependent methods:
+
+    /**
+     * Derivative of state vector X
+     * @param[in] x: state vector
+     * @param[in] u: control measurement
+     * @param[out] xdot: derivative of input vector x and u, F*x + G*u
+     */
+    virtual void StateXdot(const state_t &x, float *u, state_t &xdot)
+    {
+        for (int i = 0; i < NX; i++) {
+            float acc = 0;
+            for (int n = 0; n < this->f_count[i]; n++) {
+                acc += this->F(i, this->f_cols[i][n]) * x[this->f_cols[i][n]];
+            }
+            for (int n = 0; n < this->g_count[i]; n++) {
+                acc += this->G(i, this->g_cols[i][n]) * u[this->g_cols[i][n]];
+            }
+            xdot[i] = acc;
+        }
+    }
+    /**
+     * Calculation of system state matrices F and G
+     * @param[in] x: state vector
+     * @param[in] u: control measurement
+     */
+    virtual void LinearizeFG(state_t &x, float *u) = 0;
+    //
+
+    // System independent methods
+
+    /**
+     * Calculates covariance prediction matrux P.
+     * Update matrix P: P = f*P*f' + dt^2*G*Q*G', where f = I + F*dt, as
+     * P = P + dt*(P*F' + (P*F')') + dt^2*(F*(P*F') + G*(Q*G'))
+     * Q has to be symmetric.
+     * @param[in] dt: time interval from last update
+     */
+    virtual void CovariancePrediction(float dt)
+    {
+        float dt2 = dt * dt;
+        float row[NX];
+        // PF = P*F' and QG = Q*G', only with the declared entries of F and G
+        for (int j = 0; j < NX; j++) {
+            PRow(j, row);
+            for (int i = 0; i < NX; i++) {
+                float acc = 0;
+                for (int n = 0; n < this->f_count[i]; n++) {
+                    int k = this->f_cols[i][n];
+                    acc += row[k] * this->F(i, k);
+                }
+                this->PF(j, i) = acc;
+            }
+        }
+        for (int a = 0; a < NW; a++) {
+            for (int i = 0; i < NX; i++) {
+                float acc = 0;
+                for (int n = 0; n < this->g_count[i]; n++) {
+                    int k = this->g_cols[i][n];
+                    acc += this->Q(a, k) * this->G(i, k);
+                }
+                this->QG(a, i) = acc;
+            }
+        }
+        // Upper triangle of the update, row by row
+        float *p = this->P;
+        for (int i = 0; i < NX; i++) {
+            for (int j = i; j < NX; j++) {
+                row[j] = 0;
+            }
+            for (int n = 0; n < this->f_count[i]; n++) {
+                int k = this->f_cols[i][n];
+                float f = this->F(i, k);
+                for (int j = i; j < NX; j++) {
+                    row[j] += f * this->PF(k, j);
+                }
+            }
+            for (int n = 0; n < this->g_count[i]; n++) {
+                int k = this->g_cols[i][n];
+                float g = this->G(i, k);
+                for (int j = i; j < NX; j++) {
+                    row[j] += g * this->QG(k, j);
+                }
+            }
+            for (int j = i; j < NX; j++) {
+                *p++ += dt * (this->PF(i, j) + this->PF(j, i)) + dt2 * row[j];
+            }
+        }
+    }
+
+    /**
+     * Update of current state by measured values.
+     * Optimized method for non correlated values: one scalar update per
+     * measurement, with the non zero values of each row of H.
+     * Calculate Kalman gain and update matrix P and vector X.
+     * @param[in] H: derivative matrix
+     * @param[in] measured: array of measured values
+     * @param[in] expected: array of expected values
+     * @param[in] R: measurement noise covariance values
+     */
+    template <int NZ>
+    void Update(const dspm::MatFixed<NZ, NX> &H, float *measured, float *expected, float *R)
+    {
+        float row[NX];
+        for (int m = 0; m < NZ; m++) {
+            // Find Hp = H*P, HPHR = H*P*H' + R
+            for (int j = 0; j < NX; j++) {
+                HP[j] = 0;
+            }
+            for (int k = 0; k < NX; k++) {
+                float h = H(m, k);
+                if (h == 0) {
+                    continue;
+                }
+                PRow(k, row);
+                for (int j = 0; j < NX; j++) {
+                    HP[j] += h * row[j];
+                }
+            }
+            float HPHR = R[m];
+            for (int k = 0; k < NX; k++) {
+                HPHR += HP[k] * H(m, k);
+            }
+            float invHPHR = 1.0f / HPHR;
+            for (int k = 0; k < NX; k++) {
+                Km[k] = HP[k] * invHPHR; // find K = HP/HPHR
+            }
+            // Find P(m)= P(m-1) + K*HP, upper triangle
+            float *p = this->P;
+            for (int i = 0; i < NX; i++) {
+                for (int j = i; j < NX; j++) {
+                    *p++ -= Km[i] * HP[j];
+                }
+            }
+
+            float Error = measured[m] - expected[m];
+            for (int i = 0; i < NX; i++) {
+                // Find X(m)= X(m-1) + K*Error
+                X[i] = X[i] + Km[i] * Error;
+            }
+        }
+    }
+
+    /**
+     * Matrix for intermidieve calculations
+    */
+    float HP[NX];
+    /**
+     * Matrix for intermidieve calculations
+    */
+    float Km[NX];
+
+protected:
+    dspm::MatFixed<NX, NX> PF;  /*!< P*F', for the covariance prediction*/
+    dspm::MatFixed<NW, NX> QG;  /*!< Q*G', for the covariance prediction*/
+    uint8_t f_cols[NX][NX];     /*!< Declared columns of each row of F*/
+    uint8_t f_count[NX];        /*!< Number of declared columns of each row of F*/
+    uint8_t g_cols[NX][NW];     /*!< Declared columns of each row of G*/
+    uint8_t g_count[NX];        /*!< Number of declared columns of each row of G*/
+
+    /**
+     * Position of an element of the covariance matrix in P.
+     * @param[in] row: row position
+     * @param[in] col: column position
+     */
+    static inline int PIndex(int row, int col)
+    {
+        if (row > col) {
+            int temp = row;
+            row = col;
+            col = temp;
+        }
+        return row * NX - (row * (row - 1)) / 2 + col - row;
+    }
+
+    /**
+     * Copy a row of the covariance matrix.
+     * @param[in] k: row position
+     * @param[out] row: P(k, 0) ... P(k, NX-1)
+     */
+    void PRow(int k, float *row) const
+    {
+        // Left of the diagonal, from the column k of the rows above
+        int index = k;
+        for (int j = 0; j < k; j++) {
+            row[j] = this->P[index];
+            index += NX - j - 1;
+        }
+        memcpy(&row[k], &this->P[index], (NX - k) * sizeof(float));
+    }
+
+    static bool HasEntry(const uint8_t *cols, int count, int col)
+    {
+        for (int n = 0; n < count; n++) {
+            if (cols[n] == col) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static void AddEntry(uint8_t *cols, uint8_t &count, int col)
+    {
+        // Sorted columns, so the products read each row in order
+        if (HasEntry(cols, count, col)) {
+            return;
+        }
+        int n = count++;
+        for (; (n > 0) && (cols[n - 1] > col); n--) {
+            cols[n] = cols[n - 1];
+        }
+        cols[n] = col;
+    }
+
+public:
+    // Additional universal helper methods, as in ekf but with fixed size results
+    /**
+     * Convert quaternion to rotation matrix.
+     * @param[in] q: quaternion
+     *
+     * @return
+     *      - rotation matrix 3x3
+     */
+    static dspm::MatFixed<3, 3> quat2rotm(const float q[4])
+    {
+        float q0 = q[0];
+        float q1 = q[1];
+        float q2 = q[2];
+        float q3 = q[3];
+        dspm::MatFixed<3, 3> Rm;
+
+        Rm(0, 0) = q0 * q0 + q1 * q1 - q2 * q2 - q3 * q3;
+        Rm(1, 0) = 2.0f * (q1 * q2 + q0 * q3);
+        Rm(2, 0) = 2.0f * (q1 * q3 - q0 * q2);
+        Rm(0, 1) = 2.0f * (q1 * q2 - q0 * q3);
+        Rm(1, 1) = (q0 * q0 - q1 * q1 + q2 * q2 - q3 * q3);
+        Rm(2, 1) = 2.0f * (q2 * q3 + q0 * q1);
+        Rm(0, 2) = 2.0f * (q1 * q3 + q0 * q2);
+        Rm(1, 2) = 2.0f * (q2 * q3 - q0 * q1);
+        Rm(2, 2) = (q0 * q0 - q1 * q1 - q2 * q2 + q3 * q3);
+
+        return Rm;
+    }
+
+    /**
+     * Convert rotation matrix to quaternion.
+     * @param[in] m: rotation matrix
+     *
+     * @return
+     *      - quaternion 4x1
+     */
+    static dspm::MatFixed<4, 1> rotm2quat(const dspm::MatFixed<3, 3> &m)
+    {
+        float r11 = m(0, 0);
+        float r12 = m(0, 1);
+        float r13 = m(0, 2);
+        float r21 = m(1, 0);
+        float r22 = m(1, 1);
+        float r23 = m(1, 2);
+        float r31 = m(2, 0);
+        float r32 = m(2, 1);
+        float r33 = m(2, 2);
+        float q0 = sqrtf(fmaxf((r11 + r22 + r33 + 1.0f) / 4.0f, 0.0f));
+        float q1 = sqrtf(fmaxf((r11 - r22 - r33 + 1.0f) / 4.0f, 0.0f));
+        float q2 = sqrtf(fmaxf((-r11 + r22 - r33 + 1.0f) / 4.0f, 0.0f));
+        float q3 = sqrtf(fmaxf((-r11 - r22 + r33 + 1.0f) / 4.0f, 0.0f));
+        if (q0 >= q1 && q0 >= q2 && q0 >= q3) {
+            q1 *= sign(r32 - r23);
+            q2 *= sign(r13 - r31);
+            q3 *= sign(r21 - r12);
+        } else if (q1 >= q0 && q1 >= q2 && q1 >= q3) {
+            q0 *= sign(r32 - r23);
+            q2 *= sign(r21 + r12);
+            q3 *= sign(r13 + r31);
+        } else if (q2 >= q0 && q2 >= q1 && q2 >= q3) {
+            q0 *= sign(r13 - r31);
+            q1 *= sign(r21 + r12);
+            q3 *= sign(r32 + r23);
+        } else {
+            q0 *= sign(r21 - r12);
+            q1 *= sign(r31 + r13);
+            q2 *= sign(r32 + r23);
+        }
+
+        dspm::MatFixed<4, 1> res;
+        res(0, 0) = q0;
+        res(1, 0) = q1;
+        res(2, 0) = q2;
+        res(3, 0) = q3;
+        res.normalize();
+        return res;
+    }
+
+    /**
+     * Convert quaternion to Euler angels.
+     * @param[in] q: quaternion
+     *
+     * @return
+     *      - Euler angels 3x1
+     */
+    static dspm::MatFixed<3, 1> quat2eul(const float q[4])
+    {
+        dspm::MatFixed<3, 1> result;
+        float q0s = q[0] * q[0];
+        float q1s = q[1] * q[1];
+        float q2s = q[2] * q[2];
+        float q3s = q[3] * q[3];
+
+        float R13 = 2.0f * (q[1] * q[3] + q[0] * q[2]);
+        float R11 = q0s + q1s - q2s - q3s;
+        float R12 = -2.0f * (q[1] * q[2] - q[0] * q[3]);
+        float R23 = -2.0f * (q[2] * q[3] - q[0] * q[1]);
+        float R33 = q0s - q1s - q2s + q3s;
+
+        result.data[1] = (asinf(R13));
+        result.data[2] = (atan2f(R12, R11));
+        result.data[0] = (atan2f(R23, R33));
+        return result;
+    }
+
+    /**
+     * Convert Euler angels to rotation matrix.
+     * @param[in] xyz: Euler angels
+     *
+     * @return
+     *      - rotation matrix 3x3
+     */
+    static dspm::MatFixed<3, 3> eul2rotm(const float xyz[3])
+    {
+        dspm::MatFixed<3, 3> result;
+        float Cx = cosf(xyz[0]);
+        float Sx = sinf(xyz[0]);
+        float Cy = cosf(xyz[1]);
+        float Sy = sinf(xyz[1]);
+        float Cz = cosf(xyz[2]);
+        float Sz = sinf(xyz[2]);
+
+        result(0, 0) = Cy * Cz;
+        result(0, 1) = -Cy * Sz;
+        result(0, 2) = Sy;
+
+        result(1, 0) = Cz * Sx * Sy + Cx * Sz;
+        result(1, 1) = Cx * Cz - Sx * Sy * Sz;
+        result(1, 2) = -Cy * Sx;
+
+        result(2, 0) = -Cx * Cz * Sy + Sx * Sz;
+        result(2, 1) = Cz * Sx + Cx * Sy * Sz;
+        result(2, 2) = Cx * Cy;
+        return result;
+    }
+
+    /**
+     * Df/dq: Derivative of vector by inverted quaternion.
+     * @param[in] vector: input vector, 3 values
+     * @param[in] q: quaternion, 4 values
+     *
+     * @return
+     *      - Derivative matrix 3x4
+     */
+    static dspm::MatFixed<3, 4> dFdq_inv(const float *vector, const float *q)
+    {
+        dspm::MatFixed<3, 4> result;
+        result(0, 0) = q[0] * vector[0] + q[3] * vector[1] - q[2] * vector[2];
+        result(0, 1) = q[1] * vector[0] + q[2] * vector[1] + q[3] * vector[2];
+        result(0, 2) = -q[2] * vector[0] + q[1] * vector[1] - q[0] * vector[2];
+        result(0, 3) = -q[3] * vector[0] + q[0] * vector[1] + q[1] * vector[2];
+
+        result(1, 0) = -q[3] * vector[0] + q[0] * vector[1] + q[1] * vector[2];
+        result(1, 1) = q[2] * vector[0] - q[1] * vector[1] + q[0] * vector[2];
+        result(1, 2) = q[1] * vector[0] + q[2] * vector[1] + q[3] * vector[2];
+        result(1, 3) = -q[0] * vector[0] - q[3] * vector[1] + q[2] * vector[2];
+
+        result(2, 0) = q[2] * vector[0] - q[1] * vector[1] + q[0] * vector[2];
+        result(2, 1) = q[3] * vector[0] - q[0] * vector[1] - q[1] * vector[2];
+        result(2, 2) = q[0] * vector[0] + q[3] * vector[1] - q[2] * vector[2];
+        result(2, 3) = q[1] * vector[0] + q[2] * vector[1] + q[3] * vector[2];
+
+        result *= 2;
+        return result;
+    }
+
+    /**
+     * Make skew-symmetric matrix of vector.
+     * @param[in] w: source vector
+     *
+     * @return
+     *      - skew-symmetric matrix 4x4
+     */
+    static dspm::MatFixed<4, 4> SkewSym4x4(const float w[3])
+    {
+        const float values[16] = {   0, -w[0], -w[1], -w[2],
+                                  w[0],     0,  w[2], -w[1],
+                                  w[1], -w[2],     0,  w[0],
+                                  w[2],  w[1], -w[0],     0
+                                 };
+        return dspm::MatFixed<4, 4>(values);
+    }
+
+    /**
+     * Make right quaternion-product matrices.
+     * @param[in] q: source quaternion
+     *
+     * @return
+     *      - right quaternion-product matrix 4x4
+     */
+    static dspm::MatFixed<4, 4> qProduct(const float q[4])
+    {
+        const float values[16] = {q[0], -q[1], -q[2], -q[3],
+                                  q[1],  q[0], -q[3],  q[2],
+                                  q[2],  q[3],  q[0], -q[1],
+                                  q[3], -q[2],  q[1],  q[0]
+                                 };
+        return dspm::MatFixed<4, 4>(values);
+    }
+
+private:
+    static inline float sign(float x)
+    {
+        return (x >= 0.0f) ? +1.0f : -1.0f;
+    }
+};
+
+#endif // _ekf_fixed_h_
@@ -14,9 +14,7 @@
 
 #include "ekf_imu13states.h"
 
-ekf_imu13states::ekf_imu13states() : ekf(13, 18),
-    mag0(3, 1),
-    accel0(3, 1)
+ekf_imu13states::ekf_imu13states()
 {
     this->NUMU = 3;
 }
@@ -39,80 +37,101 @@ void ekf_imu13states::Init()
 
     accel0 /= accel0.norm();
 
-    this->Q.Copy(0.1 * dspm::Mat::eye(3), 0, 0);
-    this->Q.Copy(0.0001 * dspm::Mat::eye(3), 3, 3);
-    this->Q.Copy(0.0001 * dspm::Mat::eye(3), 6, 6);
-    this->Q.Copy(0.0001 * dspm::Mat::eye(3), 9, 9);
-    this->Q.Copy(0.00001 * dspm::Mat::eye(3), 12, 12);
-    this->Q.Copy(0.00001 * dspm::Mat::eye(3), 15, 15);
+    dspm::MatFixed<3, 3> eye = dspm::MatFixed<3, 3>::eye();
+    this->Q.Copy(dspm::MatFixed<3, 3>(0.1f * eye), 0, 0);
+    this->Q.Copy(dspm::MatFixed<3, 3>(0.0001f * eye), 3, 3);
+    this->Q.Copy(dspm::MatFixed<3, 3>(0.0001f * eye), 6, 6);
+    this->Q.Copy(dspm::MatFixed<3, 3>(0.0001f * eye), 9, 9);
+    this->Q.Copy(dspm::MatFixed<3, 3>(0.00001f * eye), 12, 12);
+    this->Q.Copy(dspm::MatFixed<3, 3>(0.00001f * eye), 15, 15);
 
     this->X.data[0] = 1; // Init quaternion
     this->X.data[7] = 1; // Initial magnetometer vector
+
+    // Non zero entries of F and G, as filled by LinearizeFG()
+    this->SparsityClear();
+    this->SparsityF(0, 0, 4, 4); // dqdot / dq
+    this->SparsityF(0, 4, 4, 3); // dqdot / dwbias
+    this->SparsityG(0, 0, 4, 3); // dqdot / dnw
+    this->SparsityG(7, 6, 3, 3); // rotation matrix
+    for (int i = 0; i < 3; i++) {
+        this->SparsityG(4 + i, 3 + i, 1, 1);    // random noise wbias
+        this->SparsityG(7 + i, 12 + i, 1, 1);   // random noise magnetometer amplitude
+        this->SparsityG(10 + i, 9 + i, 1, 1);   // magnetometer offset constant
+        this->SparsityG(10 + i, 15 + i, 1, 1);  // random noise offset constant
+    }
 }
 
-dspm::Mat ekf_imu13states::StateXdot(dspm::Mat &x, float *u)
+void ekf_imu13states::StateXdot(const state_t &x, float *u, state_t &xdot)
 {
     float wx = u[0] - x(4, 0); // subtract the biases on gyros
     float wy = u[1] - x(5, 0);
     float wz = u[2] - x(6, 0);
 
     float w[] = {wx, wy, wz};
-    dspm::Mat q = dspm::Mat(x.data, 4, 1);
+    dspm::MatFixed<4, 1> q(x.data);
 
     // qdot = Q * w
-    dspm::Mat Omega = 0.5 * SkewSym4x4(w);
-    dspm::Mat qdot = Omega * q;
-    dspm::Mat Xdot(this->NUMX, 1);
-    Xdot *= 0;
-    Xdot.Copy(qdot, 0, 0);
+    dspm::MatFixed<4, 4> Omega = 0.5f * SkewSym4x4(w);
+    dspm::MatFixed<4, 1> qdot;
+    dspm::mult(Omega, q, qdot);
+    xdot.clear();
+    xdot.Copy(qdot, 0, 0);
     // dwbias = 0
     // dMang_Ampl = 0
     // dMang_offset = 0
-    return Xdot;
 }
 
-void ekf_imu13states::LinearizeFG(dspm::Mat &x, float *u)
+void ekf_imu13states::LinearizeFG(state_t &x, float *u)
 {
     float w[3] = {(u[0] - x(4, 0)), (u[1] - x(5, 0)), (u[2] - x(6, 0))}; // subtract the biases on gyros
     // float w[3] = {u[0], u[1], u[2]}; // subtract the biases on gyros
 
-    this->F *= 0; // Initialize F and G matrixes.
-    this->G *= 0;
+    this->F.clear(); // Initialize F and G matrixes.
+    this->G.clear();
 
     // dqdot / dq - skey matrix
-    F.Copy(0.5 * ekf::SkewSym4x4(w), 0, 0);
+    F.Copy(dspm::MatFixed<4, 4>(0.5f * SkewSym4x4(w)), 0, 0);
 
     // dqdot/dvector
-    dspm::Mat dq = -0.5 * qProduct(x.data);
-    dspm::Mat dq_q = dq.Get(0, 4, 1, 3);
+    dspm::MatFixed<4, 4> dq = -0.5f * qProduct(x.data);
+    dspm::MatFixed<4, 3> dq_q = dq.Get<4, 3>(0, 1);
 
     // dqdot / dnw
     G.Copy(dq_q, 0, 0);
     // dqdot / dwbias
     F.Copy(dq_q, 0, 4);
 
-    dspm::Mat rotm = -1 * this->quat2rotm(x.data); // Convert quat to rotation matrix
+    dspm::MatFixed<3, 3> rotm = -1 * this->quat2rotm(x.data); // Convert quat to rotation matrix
+    dspm::MatFixed<3, 3> eye = dspm::MatFixed<3, 3>::eye();
 
     G.Copy(rotm, 7, 6);
-    G.Copy(dspm::Mat::eye(3), 4, 3);   // random noise wbias
-    G.Copy(dspm::Mat::eye(3), 7, 12);  // random noise magnetometer amplitude
-    G.Copy(dspm::Mat::eye(3), 10, 9);  // magnetometer offset constant
-    G.Copy(dspm::Mat::eye(3), 10, 15); // random noise offset constant
+    G.Copy(eye, 4, 3);   // random noise wbias
+    G.Copy(eye, 7, 12);  // random noise magnetometer amplitude
+    G.Copy(eye, 10, 9);  // magnetometer offset constant
+    G.Copy(eye, 10, 15); // random noise offset constant
+}
+
+void ekf_imu13states::NormalizeQuaternion()
+{
+    float norm = sqrtf(X[0] * X[0] + X[1] * X[1] + X[2] * X[2] + X[3] * X[3]);
+    for (size_t i = 0; i < 4; i++) {
+        X[i] /= norm;
+    }
 }
 
 void ekf_imu13states::Test()
 {
-    dspm::Mat test_x(7, 1);
+    state_t test_x;
     for (size_t i = 0; i < 7; i++) {
         test_x(i, 0) = i;
     }
-    printf("Allocate data = %i\n", this->NUMU);
-    float *test_u = new float[this->NUMU];
-    for (size_t i = 0; i < this->NUMU; i++) {
+    float test_u[3];
+    for (size_t i = 0; i < 3; i++) {
         test_u[i] = i;
     }
-    dspm::Mat result_StateXdot = StateXdot(test_x, test_u);
-    delete[] test_u;
+    state_t result_StateXdot;
+    StateXdot(test_x, test_u, result_StateXdot);
 }
 
 void ekf_imu13states::TestFull(bool enable_att)
@@ -120,7 +139,7 @@ void ekf_imu13states::TestFull(bool enable_att)
     int total_N = 2048;
     float pi = std::atan(1) * 4;
     float gyro_err_data[] = {0.1, 0.2, 0.3}; // static constatnt error
-    dspm::Mat gyro_err(gyro_err_data, 3, 1);
+    dspm::MatFixed<3, 1> gyro_err(gyro_err_data);
     float R[10];
     for (size_t i = 0; i < 10; i++) {
         R[i] = 0.01;
@@ -129,17 +148,17 @@ void ekf_imu13states::TestFull(bool enable_att)
     float accel0_data[] = {0, 0, 1};
     float magn0_data[] = {1, 0, 0};
 
-    dspm::Mat accel0(accel0_data, 3, 1);
-    dspm::Mat magn0(magn0_data, 3, 1);
+    dspm::MatFixed<3, 1> accel0(accel0_data);
+    dspm::MatFixed<3, 1> magn0(magn0_data);
 
     float dt = 0.01;
 
-    dspm::Mat gyro_data(3, 1);
+    dspm::MatFixed<3, 1> gyro_data;
     int count = 0;
 
     // Initial rotation matrix
-    dspm::Mat Rm = dspm::Mat::eye(3);
-    dspm::Mat Re = dspm::Mat::eye(3);
+    dspm::MatFixed<3, 3> Rm = dspm::MatFixed<3, 3>::eye();
+    dspm::MatFixed<3, 3> Re = dspm::MatFixed<3, 3>::eye();
 
     gyro_err *= 1;
 
@@ -149,31 +168,30 @@ void ekf_imu13states::TestFull(bool enable_att)
             std::cout << "Loop " << n << " from " << total_N * 16;
             std::cout << ", State data : " << this->X.t();
         }
-        gyro_data *= 0; // reset gyro value
+        gyro_data.clear(); // reset gyro value
         if ((n >= (total_N / 2)) && (n < total_N * 12)) {
             gyro_data(0, 0) = 1 / pi * std::cos(-pi / 2 + pi / 2 * count * 2 / (total_N / 10));
             gyro_data(1, 0) = 2 / pi * std::cos(-pi / 2 + pi / 2 * count * 2 / (total_N / 10));
             gyro_data(2, 0) = 3 / pi * std::cos(-pi / 2 + pi / 2 * count * 2 / (total_N / 10));
             count++;
         }
-        dspm::Mat gyro_sample = gyro_data + gyro_err;
+        dspm::MatFixed<3, 1> gyro_sample = gyro_data + gyro_err;
 
         gyro_data *= dt;
         Re = this->eul2rotm(gyro_data.data); // Calculate rotation to gyro angel
         Rm = Rm * Re;                        // Rotate original matrix
-        dspm::Mat attitude = ekf::rotm2quat(Rm);
+        dspm::MatFixed<4, 1> attitude = this->rotm2quat(Rm);
         // We have to rotate accel and magn to the opposite direction
-        dspm::Mat accel_data = Rm.t() * accel0;
-        dspm::Mat magn_data = Rm.t() * magn0;
+        dspm::MatFixed<3, 1> accel_data = Rm.t() * accel0;
+        dspm::MatFixed<3, 1> magn_data = Rm.t() * magn0;
 
-        dspm::Mat accel_norm = accel_data / accel_data.norm();
-        dspm::Mat magn_norm = magn_data / magn_data.norm();
+        dspm::MatFixed<3, 1> accel_norm = accel_data / accel_data.norm();
+        dspm::MatFixed<3, 1> magn_norm = magn_data / magn_data.norm();
 
         float input_u[] = {gyro_sample(0, 0), gyro_sample(1, 0), gyro_sample(2, 0)};
         // Process input values to new state
         this->Process(input_u, dt);
-        dspm::Mat q_norm(this->X.data, 4, 1);
-        q_norm /= q_norm.norm();
+        NormalizeQuaternion();
 
         if (true == enable_att) {
             this->UpdateRefMeasurement(accel_norm.data, magn_norm.data, attitude.data, R);
@@ -186,22 +204,19 @@ void ekf_imu13states::TestFull(bool enable_att)
 
 void ekf_imu13states::UpdateRefMeasurement(float *accel_data, float *magn_data, float R[6])
 {
-    dspm::Mat quat(this->X.data, 4, 1);
-    dspm::Mat H = 0 * dspm::Mat(6, this->NUMX);
-    dspm::Mat Re = this->quat2rotm(quat.data).t();
+    dspm::MatFixed<6, 13> H;
+    dspm::MatFixed<3, 3> Re = this->quat2rotm(this->X.data).t();
 
     // dAccel/dq
-    dspm::Mat dAccel_dq = ekf::dFdq_inv(this->accel0, quat);
-    H.Copy(dAccel_dq, 3, 0);
+    H.Copy(this->dFdq_inv(this->accel0.data, this->X.data), 3, 0);
 
     // dMagn/dq
-    dspm::Mat magn(&this->X.data[7], 3, 1);
-    dspm::Mat magn_offset(&this->X.data[10], 3, 1);
-    dspm::Mat dMagn_dq = ekf::dFdq_inv(magn, quat);
-    H.Copy(dMagn_dq, 0, 0);
+    dspm::MatFixed<3, 1> magn = this->X.Get<3, 1>(7, 0);
+    dspm::MatFixed<3, 1> magn_offset = this->X.Get<3, 1>(10, 0);
+    H.Copy(this->dFdq_inv(magn.data, this->X.data), 0, 0);
 
-    dspm::Mat expected_magn = Re * magn + magn_offset;
-    dspm::Mat expected_accel = Re * this->accel0;
+    dspm::MatFixed<3, 1> expected_magn = Re * magn + magn_offset;
+    dspm::MatFixed<3, 1> expected_accel = Re * this->accel0;
 
     float measured_data[6];
     float expected_data[6];
@@ -213,31 +228,28 @@ void ekf_imu13states::UpdateRefMeasurement(float *accel_data, float *magn_data,
     }
 
     this->Update(H, measured_data, expected_data, R);
-    quat /= quat.norm();
+    NormalizeQuaternion();
 }
 
 void ekf_imu13states::UpdateRefMeasurementMagn(float *accel_data, float *magn_data, float R[6])
 {
-    dspm::Mat quat(this->X.data, 4, 1);
-    dspm::Mat H = 0 * dspm::Mat(6, this->NUMX);
-    dspm::Mat Re = this->quat2rotm(quat.data).t();
+    dspm::MatFixed<6, 13> H;
+    dspm::MatFixed<3, 3> Re = this->quat2rotm(this->X.data).t();
 
     // We include these two line to update magnetometer initial state
     H.Copy(Re, 0, 7);
-    H.Copy(dspm::Mat::eye(3), 0, 10);
+    H.Copy(dspm::MatFixed<3, 3>::eye(), 0, 10);
 
     // dAccel/dq
-    dspm::Mat dAccel_dq = ekf::dFdq_inv(this->accel0, quat);
-    H.Copy(dAccel_dq, 3, 0);
+    H.Copy(this->dFdq_inv(this->accel0.data, this->X.data), 3, 0);
 
     // dMagn/dq
-    dspm::Mat magn(&this->X.data[7], 3, 1);
-    dspm::Mat magn_offset(&this->X.data[10], 3, 1);
-    dspm::Mat dMagn_dq = ekf::dFdq_inv(magn, quat);
-    H.Copy(dMagn_dq, 0, 0);
+    dspm::MatFixed<3, 1> magn = this->X.Get<3, 1>(7, 0);
+    dspm::MatFixed<3, 1> magn_offset = this->X.Get<3, 1>(10, 0);
+    H.Copy(this->dFdq_inv(magn.data, this->X.data), 0, 0);
 
-    dspm::Mat expected_magn = Re * magn + magn_offset;
-    dspm::Mat expected_accel = Re * this->accel0;
+    dspm::MatFixed<3, 1> expected_magn = Re * magn + magn_offset;
+    dspm::MatFixed<3, 1> expected_accel = Re * this->accel0;
 
     float measured_data[6];
     float expected_data[6];
@@ -249,31 +261,28 @@ void ekf_imu13states::UpdateRefMeasurementMagn(float *accel_data, float *magn_da
     }
 
     this->Update(H, measured_data, expected_data, R);
-    quat /= quat.norm();
+    NormalizeQuaternion();
 }
 
 void ekf_imu13states::UpdateRefMeasurement(float *accel_data, float *magn_data, float *attitude, float R[10])
 {
-    dspm::Mat quat(this->X.data, 4, 1);
-    dspm::Mat H = 0 * dspm::Mat(10, this->NUMX);
-    dspm::Mat Re = this->quat2rotm(quat.data).t();
+    dspm::MatFixed<10, 13> H;
+    dspm::MatFixed<3, 3> Re = this->quat2rotm(this->X.data).t();
 
     H.Copy(Re, 0, 7);
-    H.Copy(dspm::Mat::eye(3), 0, 10);
+    H.Copy(dspm::MatFixed<3, 3>::eye(), 0, 10);
     // dAccel/dq
-    dspm::Mat dAccel_dq = ekf::dFdq_inv(this->accel0, quat);
-    H.Copy(dAccel_dq, 3, 0);
+    H.Copy(this->dFdq_inv(this->accel0.data, this->X.data), 3, 0);
     // dMagn/dq
-    dspm::Mat magn(&this->X.data[7], 3, 1);
-    dspm::Mat magn_offset(&this->X.data[10], 3, 1);
-    dspm::Mat dMagn_dq = ekf::dFdq_inv(magn, quat);
-    H.Copy(dMagn_dq, 0, 0);
+    dspm::MatFixed<3, 1> magn = this->X.Get<3, 1>(7, 0);
+    dspm::MatFixed<3, 1> magn_offset = this->X.Get<3, 1>(10, 0);
+    H.Copy(this->dFdq_inv(magn.data, this->X.data), 0, 0);
 
     // dq/dq
-    H.Copy(dspm::Mat::eye(4), 6, 1);
+    H.Copy(dspm::MatFixed<4, 4>::eye(), 6, 1);
 
-    dspm::Mat expected_magn = Re * magn + magn_offset;
-    dspm::Mat expected_accel = Re * this->accel0;
+    dspm::MatFixed<3, 1> expected_magn = Re * magn + magn_offset;
+    dspm::MatFixed<3, 1> expected_accel = Re * this->accel0;
 
     float measured_data[10];
     float expected_data[10];
@@ -289,5 +298,5 @@ void ekf_imu13states::UpdateRefMeasurement(float *accel_data, float *magn_data,
     }
 
     this->Update(H, measured_data, expected_data, R);
-    quat /= quat.norm();
+    NormalizeQuaternion();
 }
@@ -15,7 +15,7 @@
 #ifndef _ekf_imu13states_H_
 #define _ekf_imu13states_H_
 
-#include "ekf.h"
+#include "ekf_fixed.h"
 
 /**
 * @brief This class is used to process and calculate attitude from imu sensors.
@@ -27,8 +27,22 @@
 *   X[10..12] - magnetometer offset value - magn_offset
 *
 *   where, reference magnetometer value = magn_ampl*rotation_matrix' + magn_offset
+*
+*   All the matrices have a fixed size (ekf_fixed), so the processing and the
+*   updates do not allocate memory. Init() declares the non zero entries of F
+*   and G, so the covariance prediction only uses them.
+*
+*   @note API changes from the version derived from ekf (dspm::Mat members):
+*   - X, F, G and Q are dspm::MatFixed, and mag0 and accel0 are dspm::MatFixed<3, 1>.
+*     X(i, 0), X.data and the other element accesses keep working; to pass them
+*     to code that expects a dspm::Mat, wrap the data: dspm::Mat(X.data, 13, 1).
+*   - P stores only the upper triangle (float P[91]): use Pij(row, col) for an
+*     element, and GetP() for the full 13x13 matrix (dspm::Mat or dspm::MatFixed).
+*   - StateXdot() and LinearizeFG() take ekf_fixed::state_t instead of
+*     dspm::Mat, so classes that override them must change their signatures.
+*   - Update() takes a dspm::MatFixed<NZ, 13> H, and UpdateRef() is not available.
 */
-class ekf_imu13states: public ekf {
+class ekf_imu13states: public ekf_fixed<13, 18> {
 public:
     ekf_imu13states();
     virtual ~ekf_imu13states();
@@ -36,8 +50,8 @@ public:
 
     // Method calculates Xdot values depends on U
     // U - gyroscope values in radian per seconds (rad/sec)
-    virtual dspm::Mat StateXdot(dspm::Mat &x, float *u);
-    virtual void LinearizeFG(dspm::Mat &x, float *u);
+    virtual void StateXdot(const state_t &x, float *u, state_t &xdot);
+    virtual void LinearizeFG(state_t &x, float *u);
 
     /**
     *     Method for development and tests only.
@@ -53,11 +67,11 @@ public:
     /**
     *     Initial reference valie for magnetometer.
     */
-    dspm::Mat mag0;
+    dspm::MatFixed<3, 1> mag0;
     /**
     *     Initial reference valie for accelerometer.
     */
-    dspm::Mat accel0;
+    dspm::MatFixed<3, 1> accel0;
 
     /**
     * number of control measurements
@@ -93,6 +107,11 @@ public:
      */
     void UpdateRefMeasurement(float *accel_data, float *magn_data, float *attitude, float R[10]);
 
+private:
+    /**
+     * Normalize the attitude quaternion, X[0..3]
+     */
+    void NormalizeQuaternion();
 };
 
 #endif // _ekf_imu13states_H_
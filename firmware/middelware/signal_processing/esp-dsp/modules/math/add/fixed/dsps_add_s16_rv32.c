@@ -0,0 +1,44 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// RISC-V (RV32IMAC) C implementation: contiguous arrays (all steps equal to 1)
+// are processed four elements per iteration. Results are bit exact with
+// dsps_add_s16_ansi(), also in place (output equal to input1 or input2).
+
+#include "dsps_add.h"
+
+esp_err_t dsps_add_s16_rv32(const int16_t *input1, const int16_t *input2, int16_t *output, int len, int step1, int step2, int step_out, int shift)
+{
+    if (NULL == input1) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if (NULL == input2) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+    if (NULL == output) {
+        return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+    }
+
+    int i = 0;
+    if ((step1 == 1) && (step2 == 1) && (step_out == 1)) {
+        // No restrict: output can be one of the inputs (in place), as in the ANSI version.
+        // All four values are read before they are written, so that is safe.
+        const int16_t *x = input1;
+        const int16_t *y = input2;
+        int16_t *z = output;
+        for (; i <= len - 4; i += 4) {
+            int32_t s0 = (int32_t)x[i + 0] + y[i + 0];
+            int32_t s1 = (int32_t)x[i + 1] + y[i + 1];
+            int32_t s2 = (int32_t)x[i + 2] + y[i + 2];
+            int32_t s3 = (int32_t)x[i + 3] + y[i + 3];
+            z[i + 0] = s0 >> shift;
+            z[i + 1] = s1 >> shift;
+            z[i + 2] = s2 >> shift;
+            z[i + 3] = s3 >> shift;
+        }
+    }
+    for (; i < len ; i++) {
+        int32_t acc = (int32_t)input1[i * step1] + input2[i * step2];
+        output[i * step_out] = acc >> shift;
+    }
+    return ESP_OK;
+}
@@ -51,6 +51,7 @@ esp_err_t dsps_add_f32_ae32(const float *input1, const float *input2, float *out
 esp_err_t dsps_add_s16_ansi(const int16_t *input1, const int16_t *input2, int16_t *output, int len, int step1, int step2, int step_out, int shift);
 esp_err_t dsps_add_s16_ae32(const int16_t *input1, const int16_t *input2, int16_t *output, int len, int step1, int step2, int step_out, int shift);
 esp_err_t dsps_add_s16_aes3(const int16_t *input1, const int16_t *input2, int16_t *output, int len, int step1, int step2, int step_out, int shift);
+esp_err_t dsps_add_s16_rv32(const int16_t *input1, const int16_t *input2, int16_t *output, int len, int step1, int step2, int step_out, int shift);
 
 esp_err_t dsps_add_s8_ansi(const int8_t *input1, const int8_t *input2, int8_t *output, int len, int step1, int step2, int step_out, int shift);
 esp_err_t dsps_add_s8_aes3(const int8_t *input1, const int8_t *input2, int8_t *output, int len, int step1, int step2, int step_out, int shift);
@@ -75,6 +76,9 @@ esp_err_t dsps_add_s8_aes3(const int8_t *input1, const int8_t *input2, int8_t *o
 #elif (dsps_add_s16_ae32_enabled == 1)
 #define dsps_add_s16 dsps_add_s16_ae32
 #define dsps_add_s8 dsps_add_s8_ansi
+#elif (dsps_add_s16_rv32_enabled == 1)
+#define dsps_add_s16 dsps_add_s16_rv32
+#define dsps_add_s8 dsps_add_s8_ansi
 #else
 #define dsps_add_s16 dsps_add_s16_ansi
 #define dsps_add_s8 dsps_add_s8_ansi
@@ -82,7 +86,11 @@ esp_err_t dsps_add_s8_aes3(const int8_t *input1, const int8_t *input2, int8_t *o
 
 #else // CONFIG_DSP_OPTIMIZED
 #define dsps_add_f32 dsps_add_f32_ansi
+#if (dsps_add_s16_rv32_enabled == 1)
+#define dsps_add_s16 dsps_add_s16_rv32
+#else
 #define dsps_add_s16 dsps_add_s16_ansi
+#endif
 #define dsps_add_s8 dsps_add_s8_ansi
 #endif // CONFIG_DSP_OPTIMIZED
 
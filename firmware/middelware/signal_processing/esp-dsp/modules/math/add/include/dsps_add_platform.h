@@ -28,5 +28,9 @@
 
 #endif // __XTENSA__
 
+#if defined(__riscv) && !CONFIG_DSP_ANSI
+#define dsps_add_s16_rv32_enabled 1
+#endif // __riscv
+
 
 #endif // _dsps_add_platform_H_
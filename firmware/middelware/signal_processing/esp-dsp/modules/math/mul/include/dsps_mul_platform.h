@@ -27,4 +27,8 @@
 
 #endif // __XTENSA__
 
+#if defined(__riscv) && !CONFIG_DSP_ANSI
+#define dsps_mul_s16_rv32_enabled 1
+#endif // __riscv
+
 #endif // _dsps_mul_platform_H_
@@ -15,6 +15,7 @@
 #ifndef _dspm_mat_h_
 #define _dspm_mat_h_
 #include <iostream>
+#include "dsp_err.h"
 
 /**
  * @brief   DSP matrix namespace
@@ -459,6 +460,27 @@ public:
      */
     static float dotProduct(Mat A, Mat B);
 
+    /**
+     * @brief   General matrix multiplication
+     *
+     * C = alpha * op(A) * op(B) + beta * C, where op(X) is X or X'. The matrices
+     * can be sub-matrices (getROI), and are used in place: there are no copies,
+     * transposed matrices or memory allocations. C can not overlap A or B.
+     *
+     * @param[in] alpha: scale of the product
+     * @param[in] A: input matrix
+     * @param[in] A_trans: use A transposed
+     * @param[in] B: input matrix
+     * @param[in] B_trans: use B transposed
+     * @param[in] beta: scale of C, 0 to overwrite C
+     * @param[in,out] C: result matrix, with the rows of op(A) and the columns of op(B)
+     *
+     * @return
+     *      - ESP_OK on success
+     *      - ESP_ERR_DSP_INVALID_LENGTH if the matrices do not have correct dimensions
+     */
+    static esp_err_t gemm(float alpha, const Mat &A, bool A_trans, const Mat &B, bool B_trans, float beta, Mat &C);
+
     /**
      * @brief   Augmented matrices
      *
@@ -490,10 +512,10 @@ public:
     Mat rowReduceFromGaussian();
 
     /**
-     * Find the inverse matrix
+     * Find the inverse matrix, with the LU decomposition (MatLU)
      *
      * @return
-     *      - inverse matrix
+     *      - inverse matrix, 0 if the matrix is singular
      */
     Mat inverse();
 
@@ -506,16 +528,14 @@ public:
     Mat pinv();
 
     /**
-     * Find determinant
-     * @param[in] n: element number in first row
+     * Find determinant with the LU decomposition (MatLU)
+     * @param[in] n: size of the upper left sub-matrix (rows of a square matrix)
      *
      * @return
-     *      - determinant value
+     *      - determinant value, 0 if the matrix is singular or n is not valid
      */
     float det(int n);
 private:
-    Mat cofactor(int row, int col, int n);
-    Mat adjoint();
 
     void allocate(); // Allocate buffer
     Mat expHelper(const Mat &m, int num);
@@ -0,0 +1,192 @@
+// Copyright 2018-2023 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _dspm_mat_factor_h_
+#define _dspm_mat_factor_h_
+
+#include "dsp_err.h"
+#include "mat.h"
+
+namespace dspm {
+
+/**
+ * @brief   LU decomposition
+ *
+ * Decomposition P*A = L*U of a square matrix, with partial pivoting. The
+ * buffers are allocated by the constructor: factor() and solve() do not
+ * allocate memory, and one decomposition solves any number of right hand sides.
+ */
+class MatLU {
+public:
+    /**
+     * Constructor, allocates a decomposition of a size x size matrix.
+     * @param[in] size: matrix size
+     */
+    MatLU(int size);
+    /**
+     * Constructor, allocates and calculates the decomposition of A.
+     * @param[in] A: square matrix
+     */
+    MatLU(const Mat &A);
+    ~MatLU();
+
+    /**
+     * Calculate the decomposition of A, in the buffers of the object.
+     * @param[in] A: square matrix [size]x[size]
+     *
+     * @return
+     *      - ESP_OK on success
+     *      - ESP_ERR_DSP_INVALID_LENGTH if A is not [size]x[size]
+     *      - ESP_ERR_DSP_INVALID_PARAM if A is singular
+     */
+    esp_err_t factor(const Mat &A);
+
+    /**
+     * Solve A*x = b.
+     * @param[in] b: matrix [size]x[K] with result values
+     * @param[out] x: matrix [size]x[K] with roots, can be b
+     *
+     * @return
+     *      - ESP_OK on success
+     *      - ESP_ERR_DSP_INVALID_LENGTH if b or x do not have the correct dimensions
+     *      - ESP_ERR_DSP_UNINITIALIZED if there is no valid decomposition
+     */
+    esp_err_t solve(const Mat &b, Mat &x) const;
+    /**
+     * Solve A*x = b.
+     * @param[in] b: matrix [size]x[K] with result values
+     *
+     * @return
+     *      - matrix [size]x[K] with roots
+     */
+    Mat solve(const Mat &b) const;
+
+    /**
+     * Find the inverse matrix.
+     * @return
+     *      - inverse matrix, 0 if the decomposition is not valid
+     */
+    Mat inverse() const;
+
+    /**
+     * Find the determinant.
+     * @return
+     *      - determinant value, 0 if A is singular
+     */
+    float det() const;
+
+    int size;               /*!< Matrix size*/
+    bool valid;             /*!< Flag indicates that the decomposition is valid*/
+    Mat LU;                 /*!< L (below the diagonal, ones in the diagonal) and U*/
+    int *pivot;             /*!< Row swapped with row i in step i*/
+    int sign;               /*!< Sign of the permutation*/
+
+private:
+    MatLU(const MatLU &);
+    MatLU &operator=(const MatLU &);
+};
+
+/**
+ * @brief   LDL' decomposition
+ *
+ * Decomposition A = L*D*L' of a symmetric matrix (covariance matrices, normal
+ * equations of least squares), without square roots and with half of the
+ * operations of the LU decomposition. Only the lower triangle of A is used.
+ * The buffers are allocated by the constructor: factor(), solve() and update()
+ * do not allocate memory.
+ */
+class MatLDLT {
+public:
+    /**
+     * Constructor, allocates a decomposition of a size x size matrix.
+     * @param[in] size: matrix size
+     */
+    MatLDLT(int size);
+    /**
+     * Constructor, allocates and calculates the decomposition of A.
+     * @param[in] A: symmetric matrix
+     */
+    MatLDLT(const Mat &A);
+    ~MatLDLT();
+
+    /**
+     * Calculate the decomposition of A, in the buffers of the object.
+     * @param[in] A: symmetric matrix [size]x[size]
+     *
+     * @return
+     *      - ESP_OK on success
+     *      - ESP_ERR_DSP_INVALID_LENGTH if A is not [size]x[size]
+     *      - ESP_ERR_DSP_INVALID_PARAM if a pivot of D is 0
+     */
+    esp_err_t factor(const Mat &A);
+
+    /**
+     * Rank one update: decomposition of A + alpha*v*v', in O(size^2) operations.
+     * @param[in] v: vector of size values
+     * @param[in] alpha: scale, negative to remove a value from a least squares fit
+     *
+     * @return
+     *      - ESP_OK on success
+     *      - ESP_ERR_DSP_UNINITIALIZED if there is no valid decomposition
+     *      - ESP_ERR_DSP_INVALID_PARAM if a pivot of D becomes 0
+     */
+    esp_err_t update(const float *v, float alpha);
+
+    /**
+     * Solve A*x = b.
+     * @param[in] b: matrix [size]x[K] with result values
+     * @param[out] x: matrix [size]x[K] with roots, can be b
+     *
+     * @return
+     *      - ESP_OK on success
+     *      - ESP_ERR_DSP_INVALID_LENGTH if b or x do not have the correct dimensions
+     *      - ESP_ERR_DSP_UNINITIALIZED if there is no valid decomposition
+     */
+    esp_err_t solve(const Mat &b, Mat &x) const;
+    /**
+     * Solve A*x = b.
+     * @param[in] b: matrix [size]x[K] with result values
+     *
+     * @return
+     *      - matrix [size]x[K] with roots
+     */
+    Mat solve(const Mat &b) const;
+
+    /**
+     * Find the inverse matrix.
+     * @return
+     *      - inverse matrix, 0 if the decomposition is not valid
+     */
+    Mat inverse() const;
+
+    /**
+     * Find the determinant.
+     * @return
+     *      - determinant value
+     */
+    float det() const;
+
+    int size;               /*!< Matrix size*/
+    bool valid;             /*!< Flag indicates that the decomposition is valid*/
+    Mat LD;                 /*!< L (below the diagonal, ones in the diagonal) and D (in the diagonal)*/
+    float *work;            /*!< Buffer of size values*/
+
+private:
+    MatLDLT(const MatLDLT &);
+    MatLDLT &operator=(const MatLDLT &);
+};
+
+} // namespace dspm
+
+#endif // _dspm_mat_factor_h_
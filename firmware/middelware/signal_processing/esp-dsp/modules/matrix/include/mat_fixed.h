@@ -0,0 +1,511 @@
+// Copyright 2018-2023 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _dspm_mat_fixed_h_
+#define _dspm_mat_fixed_h_
+#include <iostream>
+#include <string.h>
+#include <math.h>
+#include "dspm_mult.h"
+
+namespace dspm {
+
+template <int R, int C> class MatFixed;
+
+/**
+ * @brief   Element-wise expression of fixed size matrices
+ *
+ * Base of the nodes built by +, - and the products by a scalar of MatFixed
+ * matrices. A node only holds references to its operands, and the whole
+ * expression is evaluated element by element, in a single loop and without
+ * temporaries, when it is assigned to a MatFixed. Expressions must be assigned
+ * in the same statement that builds them (do not keep them with auto).
+ */
+template <typename E, int R, int C>
+struct MatExpr {
+    enum {
+        rows = R,       /*!< Amount of rows*/
+        cols = C,       /*!< Amount of columns*/
+        length = R * C  /*!< Total amount of elements*/
+    };
+
+    /**
+     * @return
+     *      - the expression as its node type
+     */
+    const E &self() const
+    {
+        return static_cast<const E &>(*this);
+    }
+
+    /**
+     * @param[in] i: element index, in row-major order
+     *
+     * @return
+     *      - value of the element
+     */
+    float operator[](int i) const
+    {
+        return self()[i];
+    }
+};
+
+/**
+ * @brief   Element-wise sum (or difference) of two expressions
+ */
+template <typename A, typename B, int R, int C, bool SUB>
+struct MatSum : public MatExpr<MatSum<A, B, R, C, SUB>, R, C> {
+    const A &a;     /*!< First operand*/
+    const B &b;     /*!< Second operand*/
+
+    MatSum(const A &a, const B &b) : a(a), b(b) {}
+    float operator[](int i) const
+    {
+        return SUB ? a[i] - b[i] : a[i] + b[i];
+    }
+};
+
+/**
+ * @brief   Product of an expression by a scalar
+ */
+template <typename A, int R, int C>
+struct MatScale : public MatExpr<MatScale<A, R, C>, R, C> {
+    const A &a;     /*!< Matrix operand*/
+    float k;        /*!< Scalar operand*/
+
+    MatScale(const A &a, float k) : a(a), k(k) {}
+    float operator[](int i) const
+    {
+        return a[i] * k;
+    }
+};
+
+/**
+ * @brief   Matrix with compile-time size and inline storage
+ *
+ * The MatFixed class provides the Mat operations used by filters and estimators
+ * with the size as template parameters: the data is a member array, so the
+ * matrices never allocate memory, and the size of every operation is checked at
+ * compile time. Element-wise operations (+, - and products by a scalar) are
+ * expression templates, matrix products are calculated by dspm_mult_shape_f32() into
+ * the result.
+ *
+ * A MatFixed declared in a function lives on the stack: large matrices should be
+ * members of a class (or static), and mult() / mult_t() write a product into an
+ * existing matrix without any temporary.
+ *
+ * To use legacy code that expects a Mat, wrap the data: dspm::Mat(m.data, m.rows, m.cols)
+ * uses the external buffer and does not allocate.
+ */
+template <int R, int C>
+class MatFixed : public MatExpr<MatFixed<R, C>, R, C> {
+public:
+    enum {
+        rows = R,       /*!< Amount of rows*/
+        cols = C,       /*!< Amount of columns*/
+        stride = C,     /*!< Stride = (number of elements in a row) + padding*/
+        padding = 0,    /*!< Padding between 2 rows*/
+        length = R * C  /*!< Total amount of data in data array*/
+    };
+
+    float data[R * C];  /*!< Matrix data, row-major*/
+
+    /**
+     * Constructor, all the elements are set to 0.
+     */
+    MatFixed()
+    {
+        clear();
+    }
+
+    /**
+     * Constructor with a copy of external data.
+     * @param[in] src: row-major matrix data, R * C values
+     */
+    explicit MatFixed(const float *src)
+    {
+        memcpy(this->data, src, sizeof(this->data));
+    }
+
+    /**
+     * Constructor with the result of an element-wise expression.
+     * @param[in] expr: expression of the same size
+     */
+    template <typename E>
+    MatFixed(const MatExpr<E, R, C> &expr)
+    {
+        *this = expr;
+    }
+
+    /**
+     * Evaluate an element-wise expression into the matrix.
+     * The matrix can be an operand of the expression.
+     * @param[in] expr: expression of the same size
+     */
+    template <typename E>
+    MatFixed &operator=(const MatExpr<E, R, C> &expr)
+    {
+        const E &e = expr.self();
+        for (int i = 0; i < length; i++) {
+            this->data[i] = e[i];
+        }
+        return *this;
+    }
+
+    /**
+     * Access to the matrix elements.
+     * @param[in] row: row position
+     * @param[in] col: column position
+     *
+     * @return
+     *      - element of matrix M[row][col]
+     */
+    inline float &operator()(int row, int col)
+    {
+        return this->data[row * C + col];
+    }
+    /**
+     * Access to the matrix elements.
+     * @param[in] row: row position
+     * @param[in] col: column position
+     *
+     * @return
+     *      - element of matrix M[row][col]
+     */
+    inline const float &operator()(int row, int col) const
+    {
+        return this->data[row * C + col];
+    }
+    /**
+     * Access to the matrix elements in row-major order.
+     * @param[in] i: element index
+     */
+    inline float &operator[](int i)
+    {
+        return this->data[i];
+    }
+    /**
+     * Access to the matrix elements in row-major order.
+     * @param[in] i: element index
+     */
+    inline const float &operator[](int i) const
+    {
+        return this->data[i];
+    }
+
+    /**
+     * += operator
+     * @param[in] expr: expression of the same size
+     */
+    template <typename E>
+    MatFixed &operator+=(const MatExpr<E, R, C> &expr)
+    {
+        const E &e = expr.self();
+        for (int i = 0; i < length; i++) {
+            this->data[i] += e[i];
+        }
+        return *this;
+    }
+    /**
+     * -= operator
+     * @param[in] expr: expression of the same size
+     */
+    template <typename E>
+    MatFixed &operator-=(const MatExpr<E, R, C> &expr)
+    {
+        const E &e = expr.self();
+        for (int i = 0; i < length; i++) {
+            this->data[i] -= e[i];
+        }
+        return *this;
+    }
+    /**
+     * += operator, adds a constant to every element
+     * @param[in] c: constant
+     */
+    MatFixed &operator+=(float c)
+    {
+        for (int i = 0; i < length; i++) {
+            this->data[i] += c;
+        }
+        return *this;
+    }
+    /**
+     * -= operator, subtracts a constant from every element
+     * @param[in] c: constant
+     */
+    MatFixed &operator-=(float c)
+    {
+        return *this += -c;
+    }
+    /**
+     * *= operator, multiplies every element by a constant
+     * @param[in] c: constant
+     */
+    MatFixed &operator*=(float c)
+    {
+        for (int i = 0; i < length; i++) {
+            this->data[i] *= c;
+        }
+        return *this;
+    }
+    /**
+     * /= operator, divides every element by a constant
+     * @param[in] c: constant
+     */
+    MatFixed &operator/=(float c)
+    {
+        return *this *= 1 / c;
+    }
+    /**
+     * *= operator, matrix product by a square matrix
+     * @param[in] m: right operand
+     */
+    MatFixed &operator*=(const MatFixed<C, C> &m)
+    {
+        MatFixed temp = *this;
+        dspm_mult_shape_f32(temp.data, m.data, this->data, R, C, C);
+        return *this;
+    }
+
+    /**
+     * Matrix transpose.
+     * @return
+     *      - transposed matrix
+     */
+    MatFixed<C, R> t() const
+    {
+        MatFixed<C, R> result;
+        for (int i = 0; i < R; i++) {
+            for (int j = 0; j < C; j++) {
+                result(j, i) = (*this)(i, j);
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Create identity matrix.
+     * @return
+     *      - matrix with ones in the main diagonal
+     */
+    static MatFixed eye()
+    {
+        MatFixed result;
+        for (int i = 0; (i < R) && (i < C); i++) {
+            result(i, i) = 1;
+        }
+        return result;
+    }
+
+    /**
+     * Create matrix filled with ones.
+     * @return
+     *      - matrix with all the elements set to 1
+     */
+    static MatFixed ones()
+    {
+        MatFixed result;
+        result += 1;
+        return result;
+    }
+
+    /**
+     * Make copy of a matrix into a region of this matrix.
+     * @param[in] src: source matrix, that has to fit from the position
+     * @param[in] row_pos: start row position of destination matrix
+     * @param[in] col_pos: start col position of destination matrix
+     */
+    template <int SR, int SC>
+    void Copy(const MatFixed<SR, SC> &src, int row_pos, int col_pos)
+    {
+        for (int r = 0; r < SR; r++) {
+            memcpy(&this->data[(r + row_pos) * C + col_pos], &src.data[r * SC], SC * sizeof(float));
+        }
+    }
+
+    /**
+     * Copy a region of the matrix.
+     * @param[in] row_start: start row position
+     * @param[in] col_start: start col position
+     *
+     * @return
+     *      - matrix SR x SC with the region
+     */
+    template <int SR, int SC>
+    MatFixed<SR, SC> Get(int row_start, int col_start) const
+    {
+        MatFixed<SR, SC> result;
+        for (int r = 0; r < SR; r++) {
+            memcpy(&result.data[r * SC], &this->data[(r + row_start) * C + col_start], SC * sizeof(float));
+        }
+        return result;
+    }
+
+    /**
+     * @brief   Set all the elements to 0
+     */
+    void clear(void)
+    {
+        memset(this->data, 0, sizeof(this->data));
+    }
+
+    /**
+     * @brief   Calculate norm of matrix.
+     * @return
+     *      - the square root of the sum of the squares of all the elements
+     */
+    float norm(void) const
+    {
+        float sqr_norm = 0;
+        for (int i = 0; i < length; i++) {
+            sqr_norm += this->data[i] * this->data[i];
+        }
+        return sqrtf(sqr_norm);
+    }
+
+    /**
+     * @brief   Normalizes the matrix (divides it by its norm)
+     */
+    void normalize(void)
+    {
+        *this /= norm();
+    }
+};
+
+/**
+ * Product of two matrices into an existing one, without temporaries.
+ * The result can not be one of the operands.
+ * @param[in] A: first matrix R x K
+ * @param[in] B: second matrix K x C
+ * @param[out] result: A * B, R x C
+ */
+template <int R, int K, int C>
+inline void mult(const MatFixed<R, K> &A, const MatFixed<K, C> &B, MatFixed<R, C> &result)
+{
+    dspm_mult_shape_f32(A.data, B.data, result.data, R, K, C);
+}
+
+/**
+ * Product of a matrix by the transpose of another one, without calculating the transpose.
+ * The result can not be one of the operands.
+ * @param[in] A: first matrix R x K
+ * @param[in] B: second matrix C x K
+ * @param[out] result: A * B.t(), R x C
+ */
+template <int R, int K, int C>
+inline void mult_t(const MatFixed<R, K> &A, const MatFixed<C, K> &B, MatFixed<R, C> &result)
+{
+    for (int i = 0; i < R; i++) {
+        for (int j = 0; j < C; j++) {
+            float acc = 0;
+            for (int k = 0; k < K; k++) {
+                acc += A(i, k) * B(j, k);
+            }
+            result(i, j) = acc;
+        }
+    }
+}
+
+/**
+ * Matrix product.
+ * Expressions used as operands are evaluated first.
+ * @param[in] A: first expression R x K
+ * @param[in] B: second expression K x C
+ *
+ * @return
+ *      - result matrix A * B
+ */
+template <typename EA, typename EB, int R, int K, int C>
+inline MatFixed<R, C> operator*(const MatExpr<EA, R, K> &A, const MatExpr<EB, K, C> &B)
+{
+    const MatFixed<R, K> &a = A.self();
+    const MatFixed<K, C> &b = B.self();
+    MatFixed<R, C> result;
+    mult(a, b, result);
+    return result;
+}
+
+/**
+ * + operator, element-wise sum of two expressions
+ */
+template <typename EA, typename EB, int R, int C>
+inline MatSum<EA, EB, R, C, false> operator+(const MatExpr<EA, R, C> &A, const MatExpr<EB, R, C> &B)
+{
+    return MatSum<EA, EB, R, C, false>(A.self(), B.self());
+}
+
+/**
+ * - operator, element-wise difference of two expressions
+ */
+template <typename EA, typename EB, int R, int C>
+inline MatSum<EA, EB, R, C, true> operator-(const MatExpr<EA, R, C> &A, const MatExpr<EB, R, C> &B)
+{
+    return MatSum<EA, EB, R, C, true>(A.self(), B.self());
+}
+
+/**
+ * * operator, product of an expression by a constant
+ */
+template <typename E, int R, int C>
+inline MatScale<E, R, C> operator*(const MatExpr<E, R, C> &A, float k)
+{
+    return MatScale<E, R, C>(A.self(), k);
+}
+
+/**
+ * * operator, product of a constant by an expression
+ */
+template <typename E, int R, int C>
+inline MatScale<E, R, C> operator*(float k, const MatExpr<E, R, C> &A)
+{
+    return MatScale<E, R, C>(A.self(), k);
+}
+
+/**
+ * / operator, division of an expression by a constant
+ */
+template <typename E, int R, int C>
+inline MatScale<E, R, C> operator/(const MatExpr<E, R, C> &A, float k)
+{
+    return MatScale<E, R, C>(A.self(), 1 / k);
+}
+
+/**
+ * Unary - operator, negated expression
+ */
+template <typename E, int R, int C>
+inline MatScale<E, R, C> operator-(const MatExpr<E, R, C> &A)
+{
+    return MatScale<E, R, C>(A.self(), -1);
+}
+
+/**
+ * Print matrix to the standard iostream, as the Mat operator<<.
+ */
+template <int R, int C>
+std::ostream &operator<<(std::ostream &os, const MatFixed<R, C> &m)
+{
+    for (int i = 0; i < R; ++i) {
+        os << m(i, 0);
+        for (int j = 1; j < C; ++j) {
+            os << " " << m(i, j);
+        }
+        os << std::endl;
+    }
+    return os;
+}
+
+}
+#endif //_dspm_mat_fixed_h_
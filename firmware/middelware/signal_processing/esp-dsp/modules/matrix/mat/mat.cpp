@@ -15,6 +15,7 @@
 #include <stdexcept>
 #include <string.h>
 #include "mat.h"
+#include "mat_factor.h"
 #include "esp_log.h"
 
 #include "dsps_math.h"
@@ -319,7 +320,7 @@ Mat &Mat::operator*=(const Mat &m)
         dspm_mult_ex_f32(temp.data, m.data, this->data, temp.rows, temp.cols, m.cols, temp.padding, m.padding, this->padding);
     } else {
         Mat temp = *this;
-        dspm_mult_f32(temp.data, m.data, this->data, temp.rows, temp.cols, m.cols);
+        dspm_mult_shape_f32(temp.data, m.data, this->data, temp.rows, temp.cols, m.cols);
     }
     return (*this);
 }
@@ -580,6 +581,18 @@ float Mat::dotProduct(Mat a, Mat b)
     return sum;
 }
 
+esp_err_t Mat::gemm(float alpha, const Mat &A, bool A_trans, const Mat &B, bool B_trans, float beta, Mat &C)
+{
+    int m = A_trans ? A.cols : A.rows;
+    int n = A_trans ? A.rows : A.cols;
+    int k = B_trans ? B.rows : B.cols;
+    if (((B_trans ? B.cols : B.rows) != n) || (C.rows != m) || (C.cols != k)) {
+        ESP_LOGW("Mat", "gemm Error: matrices do not have correct dimensions");
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    return dspm_gemm_f32(A.data, B.data, C.data, m, n, k, alpha, beta, A.stride, B.stride, C.stride, A_trans, B_trans);
+}
+
 Mat Mat::augment(Mat A, Mat B)
 {
     Mat AB(A.rows, A.cols + B.cols);
@@ -717,104 +730,24 @@ Mat Mat::pinv()
     return AInverse;
 }
 
-Mat Mat::cofactor(int row, int col, int n)
-{
-    int i = 0, j = 0;
-    Mat result(n, n);
-    // Looping for each element of the matrix
-    for (int r = 0; r < n; r++) {
-        for (int c = 0; c < n; c++) {
-            //  Copying into temporary matrix only those element
-            //  which are not in given row and column
-            if (r != row && c != col) {
-                result(i, j++) = (*this)(r, c);
-
-                // Row is filled, so increase row index and
-                // reset col index
-                if (j == this->rows - 1) {
-                    j = 0;
-                    i++;
-                }
-            }
-        }
-    }
-    return result;
-}
-
 float Mat::det(int n)
 {
-    float D = 0; // Initialize result
-
-    //  Base case : if matrix contains single element
-    if (n == 1) {
-        return (*this)(0, 0);
+    // LU decomposition of the n x n upper left sub-matrix: O(N^3)
+    if ((n < 1) || (n > this->rows) || (n > this->cols)) {
+        ESP_LOGW("Mat", "det Error: %i is not a valid size", n);
+        return 0;
     }
-
-    Mat temp(this->rows, this->rows); // To store cofactors
-
-    int sign = 1;  // To store sign multiplier
-
-    // Iterate for each element of first row
-    for (int f = 0; f < n; f++) {
-        // Getting Cofactor of A[0][f]
-        Mat temp = this->cofactor(0, f, n);
-        D += (*this)(0, f) * temp.det(n - 1) * sign;
-
-        // terms are to be added with alternate sign
-        sign = -sign;
-    }
-
-    return D;
-}
-
-Mat Mat::adjoint()
-{
-    Mat adj(this->rows, this->cols);
-    if (this->rows == 1) {
-        adj(0, 0) = 1;
-        return adj;
-    }
-
-    // temp is used to store cofactors of A(,)
-    int sign = 1;
-    Mat temp(this->rows, this->cols);
-
-    for (int i = 0; i < this->rows; i++) {
-        for (int j = 0; j < this->cols; j++) {
-            // Get cofactor of A(i,j)
-            temp = this->cofactor( i, j, this->rows);
-
-            // sign of adj(j,i) positive if sum of row
-            // and column indexes is even.
-            sign = ((i + j) % 2 == 0) ? 1 : -1;
-
-            // Interchanging rows and columns to get the
-            // transpose of the cofactor matrix
-            adj(j, i) = (sign) * (temp.det(this->rows - 1));
-        }
-    }
-    return adj;
+    return MatLU(this->getROI(0, 0, n, n)).det();
 }
 
 Mat Mat::inverse()
 {
+    // LU decomposition: O(N^3)
+    MatLU lu(this->rows);
     Mat result(this->rows, this->cols);
-    // Find determinant of matrix
-    float det = this->det(this->rows);
-    if (det == 0) {
-        //std::cout << "Singular matrix, can't find its inverse";
-        return result;
+    if (lu.factor(*this) == ESP_OK) {
+        lu.solve(Mat::eye(this->rows), result);
     }
-
-    // Find adjoint
-    Mat adj = this->adjoint();
-
-    // Find Inverse using formula "inverse(A) = adj(A)/det(A)"
-    for (int i = 0; i < this->rows; i++)
-        for (int j = 0; j < this->cols; j++) {
-            result(i, j) = adj(i, j) / float(det);
-        }
-
     return result;
 }
 
@@ -929,7 +862,7 @@ Mat operator*(const Mat &m1, const Mat &m2)
     if (m1.sub_matrix || m2.sub_matrix) {
         dspm_mult_ex_f32(m1.data, m2.data, temp.data, m1.rows, m1.cols, m2.cols, m1.padding, m2.padding, temp.padding);
     } else {
-        dspm_mult_f32(m1.data, m2.data, temp.data, m1.rows, m1.cols, m2.cols);
+        dspm_mult_shape_f32(m1.data, m2.data, temp.data, m1.rows, m1.cols, m2.cols);
     }
 
     return temp;
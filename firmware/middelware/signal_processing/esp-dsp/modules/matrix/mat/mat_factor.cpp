@@ -0,0 +1,326 @@
+// Copyright 2018-2023 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+#include <math.h>
+#include "mat_factor.h"
+#include "esp_log.h"
+
+namespace dspm {
+
+// Copy b to x (if they are not the same matrix) and check the dimensions
+static esp_err_t copy_rhs(int size, const Mat &b, Mat &x)
+{
+    if ((b.rows != size) || (x.rows != size) || (x.cols != b.cols)) {
+        ESP_LOGW("Mat", "solve Error: matrices do not have correct dimensions");
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    if (x.data != b.data) {
+        for (int i = 0; i < size; i++) {
+            memcpy(&x(i, 0), &b(i, 0), b.cols * sizeof(float));
+        }
+    }
+    return ESP_OK;
+}
+
+// row_i -= value * row_k, for the K columns of x
+static inline void row_sub(Mat &x, int i, int k, float value)
+{
+    float *row_i = &x(i, 0);
+    const float *row_k = &x(k, 0);
+    for (int c = 0; c < x.cols; c++) {
+        row_i[c] -= value * row_k[c];
+    }
+}
+
+MatLU::MatLU(int size) : size(size), valid(false), LU(size, size), sign(1)
+{
+    this->pivot = new int[size];
+}
+
+MatLU::MatLU(const Mat &A) : size(A.rows), valid(false), LU(A.rows, A.rows), sign(1)
+{
+    this->pivot = new int[A.rows];
+    this->factor(A);
+}
+
+MatLU::~MatLU()
+{
+    delete[] this->pivot;
+}
+
+esp_err_t MatLU::factor(const Mat &A)
+{
+    int n = this->size;
+    this->valid = false;
+    if ((A.rows != n) || (A.cols != n)) {
+        ESP_LOGW("Mat", "LU Error: matrix is not %ix%i", n, n);
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    for (int i = 0; i < n; i++) {
+        memcpy(&LU(i, 0), &A(i, 0), n * sizeof(float));
+    }
+    this->sign = 1;
+    for (int k = 0; k < n; k++) {
+        // Partial pivoting: largest value of the column
+        int p = k;
+        for (int i = k + 1; i < n; i++) {
+            if (fabsf(LU(i, k)) > fabsf(LU(p, k))) {
+                p = i;
+            }
+        }
+        this->pivot[k] = p;
+        if (LU(p, k) == 0) {
+            ESP_LOGW("Mat", "LU Error: the matrix is singular");
+            return ESP_ERR_DSP_INVALID_PARAM;
+        }
+        if (p != k) {
+            for (int j = 0; j < n; j++) {
+                float temp = LU(k, j);
+                LU(k, j) = LU(p, j);
+                LU(p, j) = temp;
+            }
+            this->sign = -this->sign;
+        }
+        float inv_pivot = 1 / LU(k, k);
+        const float *row_k = &LU(k, 0);
+        for (int i = k + 1; i < n; i++) {
+            float *row_i = &LU(i, 0);
+            float l = row_i[k] * inv_pivot;
+            row_i[k] = l;
+            for (int j = k + 1; j < n; j++) {
+                row_i[j] -= l * row_k[j];
+            }
+        }
+    }
+    this->valid = true;
+    return ESP_OK;
+}
+
+esp_err_t MatLU::solve(const Mat &b, Mat &x) const
+{
+    int n = this->size;
+    if (!this->valid) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+    esp_err_t ret = copy_rhs(n, b, x);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    // Row swaps in the same order as in the decomposition
+    for (int k = 0; k < n; k++) {
+        int p = this->pivot[k];
+        if (p != k) {
+            for (int c = 0; c < x.cols; c++) {
+                float temp = x(k, c);
+                x(k, c) = x(p, c);
+                x(p, c) = temp;
+            }
+        }
+    }
+    // L*y = P*b
+    for (int i = 1; i < n; i++) {
+        for (int k = 0; k < i; k++) {
+            row_sub(x, i, k, LU(i, k));
+        }
+    }
+    // U*x = y
+    for (int i = n - 1; i >= 0; i--) {
+        for (int k = i + 1; k < n; k++) {
+            row_sub(x, i, k, LU(i, k));
+        }
+        float inv_pivot = 1 / LU(i, i);
+        for (int c = 0; c < x.cols; c++) {
+            x(i, c) *= inv_pivot;
+        }
+    }
+    return ESP_OK;
+}
+
+Mat MatLU::solve(const Mat &b) const
+{
+    Mat x(b.rows, b.cols);
+    this->solve(b, x);
+    return x;
+}
+
+Mat MatLU::inverse() const
+{
+    Mat result = Mat::eye(this->size);
+    if (this->solve(result, result) != ESP_OK) {
+        result.clear();
+    }
+    return result;
+}
+
+float MatLU::det() const
+{
+    if (!this->valid) {
+        return 0;
+    }
+    float result = this->sign;
+    for (int i = 0; i < this->size; i++) {
+        result *= LU(i, i);
+    }
+    return result;
+}
+
+MatLDLT::MatLDLT(int size) : size(size), valid(false), LD(size, size)
+{
+    this->work = new float[size];
+}
+
+MatLDLT::MatLDLT(const Mat &A) : size(A.rows), valid(false), LD(A.rows, A.rows)
+{
+    this->work = new float[A.rows];
+    this->factor(A);
+}
+
+MatLDLT::~MatLDLT()
+{
+    delete[] this->work;
+}
+
+esp_err_t MatLDLT::factor(const Mat &A)
+{
+    int n = this->size;
+    float *v = this->work;
+    this->valid = false;
+    if ((A.rows != n) || (A.cols != n)) {
+        ESP_LOGW("Mat", "LDLT Error: matrix is not %ix%i", n, n);
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    for (int j = 0; j < n; j++) {
+        // v(k) = L(j,k)*D(k), D(j) = A(j,j) - sum(L(j,k)*v(k))
+        const float *row_j = &LD(j, 0);
+        float d = A(j, j);
+        for (int k = 0; k < j; k++) {
+            v[k] = row_j[k] * LD(k, k);
+            d -= row_j[k] * v[k];
+        }
+        if (d == 0) {
+            ESP_LOGW("Mat", "LDLT Error: the matrix is singular");
+            return ESP_ERR_DSP_INVALID_PARAM;
+        }
+        LD(j, j) = d;
+        // L(i,j) = (A(i,j) - sum(L(i,k)*v(k))) / D(j)
+        float inv_d = 1 / d;
+        for (int i = j + 1; i < n; i++) {
+            float *row_i = &LD(i, 0);
+            float sum = A(i, j);
+            for (int k = 0; k < j; k++) {
+                sum -= row_i[k] * v[k];
+            }
+            row_i[j] = sum * inv_d;
+        }
+    }
+    // Upper triangle is not used
+    for (int i = 0; i < n; i++) {
+        for (int j = i + 1; j < n; j++) {
+            LD(i, j) = 0;
+        }
+    }
+    this->valid = true;
+    return ESP_OK;
+}
+
+esp_err_t MatLDLT::update(const float *v, float alpha)
+{
+    int n = this->size;
+    float *w = this->work;
+    if (!this->valid) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+    memcpy(w, v, n * sizeof(float));
+    for (int j = 0; j < n; j++) {
+        float p = w[j];
+        float d = LD(j, j);
+        float d_new = d + alpha * p * p;
+        if (d_new == 0) {
+            this->valid = false;
+            ESP_LOGW("Mat", "LDLT Error: the updated matrix is singular");
+            return ESP_ERR_DSP_INVALID_PARAM;
+        }
+        float beta = alpha * p / d_new;
+        alpha = alpha * d / d_new;
+        LD(j, j) = d_new;
+        for (int i = j + 1; i < n; i++) {
+            w[i] -= p * LD(i, j);
+            LD(i, j) += beta * w[i];
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t MatLDLT::solve(const Mat &b, Mat &x) const
+{
+    int n = this->size;
+    if (!this->valid) {
+        return ESP_ERR_DSP_UNINITIALIZED;
+    }
+    esp_err_t ret = copy_rhs(n, b, x);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    // L*y = b
+    for (int i = 1; i < n; i++) {
+        for (int k = 0; k < i; k++) {
+            row_sub(x, i, k, LD(i, k));
+        }
+    }
+    // D*z = y
+    for (int i = 0; i < n; i++) {
+        float inv_d = 1 / LD(i, i);
+        for (int c = 0; c < x.cols; c++) {
+            x(i, c) *= inv_d;
+        }
+    }
+    // L'*x = z
+    for (int i = n - 2; i >= 0; i--) {
+        for (int k = i + 1; k < n; k++) {
+            row_sub(x, i, k, LD(k, i));
+        }
+    }
+    return ESP_OK;
+}
+
+Mat MatLDLT::solve(const Mat &b) const
+{
+    Mat x(b.rows, b.cols);
+    this->solve(b, x);
+    return x;
+}
+
+Mat MatLDLT::inverse() const
+{
+    Mat result = Mat::eye(this->size);
+    if (this->solve(result, result) != ESP_OK) {
+        result.clear();
+    }
+    return result;
+}
+
+float MatLDLT::det() const
+{
+    if (!this->valid) {
+        return 0;
+    }
+    float result = 1;
+    for (int i = 0; i < this->size; i++) {
+        result *= LD(i, i);
+    }
+    return result;
+}
+
+} // namespace dspm
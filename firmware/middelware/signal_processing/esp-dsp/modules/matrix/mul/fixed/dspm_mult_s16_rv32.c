@@ -0,0 +1,48 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// RISC-V (RV32IMAC) C implementation: two output columns are computed together,
+// 16x16 products are formed with the 32 bit multiplier and added to 64 bit
+// accumulators. Results are bit exact with dspm_mult_s16_ansi().
+
+#include "dspm_mult.h"
+
+static inline int16_t dspm_mult_s16_rv32_round(long long acc, int final_shift)
+{
+    if (final_shift > 0) {
+        return (int16_t)(acc << final_shift);
+    }
+    return (int16_t)(acc >> (-final_shift));
+}
+
+esp_err_t dspm_mult_s16_rv32(const int16_t *A, const int16_t *B, int16_t *C, int m, int n, int k, int shift)
+{
+    const int16_t *restrict a = A;
+    const int16_t *restrict b = B;
+    int16_t *restrict c = C;
+    const int final_shift = shift - 15;
+    const long long rounding = 0x7fff >> shift;
+    for (int i = 0 ; i < m ; i++) {
+        const int16_t *a_row = &a[i * n];
+        int16_t *c_row = &c[i * k];
+        int j = 0;
+        for (; j <= k - 2; j += 2) {
+            long long acc0 = rounding;
+            long long acc1 = rounding;
+            for (int s = 0; s < n ; s++) {
+                const int32_t a_value = a_row[s];
+                acc0 += a_value * b[s * k + j + 0];
+                acc1 += a_value * b[s * k + j + 1];
+            }
+            c_row[j + 0] = dspm_mult_s16_rv32_round(acc0, final_shift);
+            c_row[j + 1] = dspm_mult_s16_rv32_round(acc1, final_shift);
+        }
+        for (; j < k ; j++) {
+            long long acc = rounding;
+            for (int s = 0; s < n ; s++) {
+                acc += (int32_t)a_row[s] * b[s * k + j];
+            }
+            c_row[j] = dspm_mult_s16_rv32_round(acc, final_shift);
+        }
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,145 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// C = alpha*op(A)*op(B) + beta*C, with strides and transposed operands.
+// Register blocking: blocks of 4x4 values of C are accumulated in local variables,
+// each value of A and B loaded is used in four products. Cache blocking: the inner
+// dimension is split in blocks of DSPM_GEMM_KC and the columns of C in blocks of
+// DSPM_GEMM_NC, so the rows of B used by a block stay in the cache. Operands are
+// read in place (no packing buffers), so ROI sub-matrices and transposes work
+// without copies or memory allocation.
+
+#include "dspm_mult.h"
+
+#define DSPM_GEMM_KC    128     // Inner dimension of a cache block
+#define DSPM_GEMM_NC    64      // Columns of C of a cache block
+
+// c[0..3][0..3] += alpha * sum(a(i,s)*b(s,j)), s=0..kc-1
+static inline void dspm_gemm_4x4(const float *a, int a_rs, int a_cs, const float *b, int b_rs, int b_cs,
+                                 float *c, int c_rs, int kc, float alpha)
+{
+    float c00 = 0, c01 = 0, c02 = 0, c03 = 0;
+    float c10 = 0, c11 = 0, c12 = 0, c13 = 0;
+    float c20 = 0, c21 = 0, c22 = 0, c23 = 0;
+    float c30 = 0, c31 = 0, c32 = 0, c33 = 0;
+    for (int s = 0; s < kc; s++) {
+        float a0 = a[0];
+        float a1 = a[a_rs];
+        float a2 = a[2 * a_rs];
+        float a3 = a[3 * a_rs];
+        float b0 = b[0];
+        float b1 = b[b_cs];
+        float b2 = b[2 * b_cs];
+        float b3 = b[3 * b_cs];
+        c00 += a0 * b0;
+        c01 += a0 * b1;
+        c02 += a0 * b2;
+        c03 += a0 * b3;
+        c10 += a1 * b0;
+        c11 += a1 * b1;
+        c12 += a1 * b2;
+        c13 += a1 * b3;
+        c20 += a2 * b0;
+        c21 += a2 * b1;
+        c22 += a2 * b2;
+        c23 += a2 * b3;
+        c30 += a3 * b0;
+        c31 += a3 * b1;
+        c32 += a3 * b2;
+        c33 += a3 * b3;
+        a += a_cs;
+        b += b_rs;
+    }
+    c[0] += alpha * c00;
+    c[1] += alpha * c01;
+    c[2] += alpha * c02;
+    c[3] += alpha * c03;
+    c += c_rs;
+    c[0] += alpha * c10;
+    c[1] += alpha * c11;
+    c[2] += alpha * c12;
+    c[3] += alpha * c13;
+    c += c_rs;
+    c[0] += alpha * c20;
+    c[1] += alpha * c21;
+    c[2] += alpha * c22;
+    c[3] += alpha * c23;
+    c += c_rs;
+    c[0] += alpha * c30;
+    c[1] += alpha * c31;
+    c[2] += alpha * c32;
+    c[3] += alpha * c33;
+}
+
+// c[0][0] += alpha * sum(a(0,s)*b(s,0)), s=0..kc-1, for the edges of C
+static inline void dspm_gemm_1x1(const float *a, int a_cs, const float *b, int b_rs, float *c, int kc, float alpha)
+{
+    float acc = 0;
+    for (int s = 0; s < kc; s++) {
+        acc += a[s * a_cs] * b[s * b_rs];
+    }
+    c[0] += alpha * acc;
+}
+
+esp_err_t dspm_gemm_f32_ansi(const float *A, const float *B, float *C, int m, int n, int k,
+                             float alpha, float beta, int A_stride, int B_stride, int C_stride,
+                             int A_trans, int B_trans)
+{
+    if ((m <= 0) || (n < 0) || (k <= 0)) {
+        return ESP_ERR_DSP_INVALID_LENGTH;
+    }
+    // Distance between rows (rs) and columns (cs) of op(A) and op(B)
+    int a_rs = A_trans ? 1 : A_stride;
+    int a_cs = A_trans ? A_stride : 1;
+    int b_rs = B_trans ? 1 : B_stride;
+    int b_cs = B_trans ? B_stride : 1;
+    if ((a_rs < 1) || (a_cs < 1) || (b_rs < 1) || (b_cs < 1) || (C_stride < k)) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+    // Rows of A and B, as stored, can not overlap
+    if ((A_stride < (A_trans ? m : n)) || (B_stride < (B_trans ? n : k))) {
+        return ESP_ERR_DSP_INVALID_PARAM;
+    }
+
+    // C = beta*C, when beta is 0 C is overwritten without being read (NaN/Inf in C are not propagated)
+    if (beta != 1) {
+        for (int i = 0; i < m; i++) {
+            float *c_row = &C[i * C_stride];
+            for (int j = 0; j < k; j++) {
+                c_row[j] = (beta == 0) ? 0 : c_row[j] * beta;
+            }
+        }
+    }
+    if (alpha == 0) {
+        return ESP_OK;
+    }
+
+    for (int s0 = 0; s0 < n; s0 += DSPM_GEMM_KC) {
+        int kc = (n - s0 < DSPM_GEMM_KC) ? n - s0 : DSPM_GEMM_KC;
+        for (int j0 = 0; j0 < k; j0 += DSPM_GEMM_NC) {
+            int nc = (k - j0 < DSPM_GEMM_NC) ? k - j0 : DSPM_GEMM_NC;
+            const float *b_block = &B[s0 * b_rs + j0 * b_cs];
+            int i = 0;
+            for (; i <= m - 4; i += 4) {
+                const float *a_block = &A[i * a_rs + s0 * a_cs];
+                float *c_block = &C[i * C_stride + j0];
+                int j = 0;
+                for (; j <= nc - 4; j += 4) {
+                    dspm_gemm_4x4(a_block, a_rs, a_cs, &b_block[j * b_cs], b_rs, b_cs, &c_block[j], C_stride, kc, alpha);
+                }
+                for (; j < nc; j++) {
+                    for (int r = 0; r < 4; r++) {
+                        dspm_gemm_1x1(&a_block[r * a_rs], a_cs, &b_block[j * b_cs], b_rs, &c_block[r * C_stride + j], kc, alpha);
+                    }
+                }
+            }
+            for (; i < m; i++) {
+                const float *a_row = &A[i * a_rs + s0 * a_cs];
+                float *c_row = &C[i * C_stride + j0];
+                for (int j = 0; j < nc; j++) {
+                    dspm_gemm_1x1(a_row, a_cs, &b_block[j * b_cs], b_rs, &c_row[j], kc, alpha);
+                }
+            }
+        }
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// RISC-V (RV32IMAC) C implementation: four output columns are computed together,
+// so each A[i][s] is loaded once for four products. The summation order of every
+// element is the same as in dspm_mult_f32_ansi(), so results are bit exact.
+
+#include "dspm_mult.h"
+
+esp_err_t dspm_mult_f32_rv32(const float *A, const float *B, float *C, int m, int n, int k)
+{
+    if (n <= 0) {
+        // Empty sums: A has no columns to read
+        for (int i = 0 ; i < m * k ; i++) {
+            C[i] = 0;
+        }
+        return ESP_OK;
+    }
+    const float *restrict a = A;
+    const float *restrict b = B;
+    float *restrict c = C;
+    for (int i = 0 ; i < m ; i++) {
+        const float *a_row = &a[i * n];
+        float *c_row = &c[i * k];
+        int j = 0;
+        for (; j <= k - 4; j += 4) {
+            float acc0 = a_row[0] * b[j + 0];
+            float acc1 = a_row[0] * b[j + 1];
+            float acc2 = a_row[0] * b[j + 2];
+            float acc3 = a_row[0] * b[j + 3];
+            for (int s = 1; s < n ; s++) {
+                const float a_value = a_row[s];
+                const float *b_row = &b[s * k + j];
+                acc0 += a_value * b_row[0];
+                acc1 += a_value * b_row[1];
+                acc2 += a_value * b_row[2];
+                acc3 += a_value * b_row[3];
+            }
+            c_row[j + 0] = acc0;
+            c_row[j + 1] = acc1;
+            c_row[j + 2] = acc2;
+            c_row[j + 3] = acc3;
+        }
+        for (; j < k ; j++) {
+            float acc = a_row[0] * b[j];
+            for (int s = 1; s < n ; s++) {
+                acc += a_row[s] * b[s * k + j];
+            }
+            c_row[j] = acc;
+        }
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Fully unrolled C kernels for the 3x3 and 4x4 shapes of quaternion and rotation
+// matrix code, for the targets without the Xtensa assembly versions. The summation
+// order of every element is the same as in dspm_mult_f32_ansi(), so results are
+// bit exact. The result is written after all products, so C can be A or B.
+
+#include "dspm_mult.h"
+
+// c(i,j) = sum(a(i,s)*b(s,j)), s=0..2, B with k columns
+#define DSPM_ROW3(i, j, k) (A[3 * i] * B[j] + A[3 * i + 1] * B[k + j] + A[3 * i + 2] * B[2 * k + j])
+// c(i,j) = sum(a(i,s)*b(s,j)), s=0..3, B with k columns
+#define DSPM_ROW4(i, j, k) (A[4 * i] * B[j] + A[4 * i + 1] * B[k + j] + A[4 * i + 2] * B[2 * k + j] + A[4 * i + 3] * B[3 * k + j])
+
+esp_err_t dspm_mult_3x3x1_f32_ansi(const float *A, const float *B, float *C)
+{
+    float c0 = DSPM_ROW3(0, 0, 1);
+    float c1 = DSPM_ROW3(1, 0, 1);
+    float c2 = DSPM_ROW3(2, 0, 1);
+    C[0] = c0;
+    C[1] = c1;
+    C[2] = c2;
+    return ESP_OK;
+}
+
+esp_err_t dspm_mult_3x3x3_f32_ansi(const float *A, const float *B, float *C)
+{
+    float c[9];
+    c[0] = DSPM_ROW3(0, 0, 3);
+    c[1] = DSPM_ROW3(0, 1, 3);
+    c[2] = DSPM_ROW3(0, 2, 3);
+    c[3] = DSPM_ROW3(1, 0, 3);
+    c[4] = DSPM_ROW3(1, 1, 3);
+    c[5] = DSPM_ROW3(1, 2, 3);
+    c[6] = DSPM_ROW3(2, 0, 3);
+    c[7] = DSPM_ROW3(2, 1, 3);
+    c[8] = DSPM_ROW3(2, 2, 3);
+    for (int i = 0; i < 9; i++) {
+        C[i] = c[i];
+    }
+    return ESP_OK;
+}
+
+esp_err_t dspm_mult_4x4x1_f32_ansi(const float *A, const float *B, float *C)
+{
+    float c0 = DSPM_ROW4(0, 0, 1);
+    float c1 = DSPM_ROW4(1, 0, 1);
+    float c2 = DSPM_ROW4(2, 0, 1);
+    float c3 = DSPM_ROW4(3, 0, 1);
+    C[0] = c0;
+    C[1] = c1;
+    C[2] = c2;
+    C[3] = c3;
+    return ESP_OK;
+}
+
+esp_err_t dspm_mult_4x4x4_f32_ansi(const float *A, const float *B, float *C)
+{
+    float c[16];
+    c[0] = DSPM_ROW4(0, 0, 4);
+    c[1] = DSPM_ROW4(0, 1, 4);
+    c[2] = DSPM_ROW4(0, 2, 4);
+    c[3] = DSPM_ROW4(0, 3, 4);
+    c[4] = DSPM_ROW4(1, 0, 4);
+    c[5] = DSPM_ROW4(1, 1, 4);
+    c[6] = DSPM_ROW4(1, 2, 4);
+    c[7] = DSPM_ROW4(1, 3, 4);
+    c[8] = DSPM_ROW4(2, 0, 4);
+    c[9] = DSPM_ROW4(2, 1, 4);
+    c[10] = DSPM_ROW4(2, 2, 4);
+    c[11] = DSPM_ROW4(2, 3, 4);
+    c[12] = DSPM_ROW4(3, 0, 4);
+    c[13] = DSPM_ROW4(3, 1, 4);
+    c[14] = DSPM_ROW4(3, 2, 4);
+    c[15] = DSPM_ROW4(3, 3, 4);
+    for (int i = 0; i < 16; i++) {
+        C[i] = c[i];
+    }
+    return ESP_OK;
+}
@@ -30,6 +30,7 @@ extern "C"
  * Matrix multiplication for two floating point matrices: C[m][k] = A[m][n] * B[n][k]
  * The extension (_ansi) use ANSI C and could be compiled and run on any platform.
  * The extension (_ae32) is optimized for ESP32 chip.
+ * The extension (_rv32) is optimized C for RISC-V (ESP32-C6) chips.
  *
  * @param[in] A  input matrix A[m][n]
  * @param[in] B  input matrix B[n][k]
@@ -44,6 +45,7 @@ extern "C"
 esp_err_t dspm_mult_f32_ansi(const float *A, const float *B, float *C, int m, int n, int k);
 esp_err_t dspm_mult_f32_ae32(const float *A, const float *B, float *C, int m, int n, int k);
 esp_err_t dspm_mult_f32_aes3(const float *A, const float *B, float *C, int m, int n, int k);
+esp_err_t dspm_mult_f32_rv32(const float *A, const float *B, float *C, int m, int n, int k);
 /**@}*/
 
 
@@ -108,6 +110,25 @@ esp_err_t dspm_mult_4x4x1_f32_ae32(const float *A, const float *B, float *C);
  */
 esp_err_t dspm_mult_4x4x4_f32_ae32(const float *A, const float *B, float *C);
 
+/**
+ * @brief   Unrolled 3x3 and 4x4 matrix multiplications
+ *
+ * C implementations of the dspm_mult_3x3x1_f32, dspm_mult_3x3x3_f32,
+ * dspm_mult_4x4x1_f32 and dspm_mult_4x4x4_f32 shapes, for the chips without the
+ * assembly versions. Results are the same as dspm_mult_f32_ansi(), and C can be
+ * the same as A or B.
+ *
+ * @param[in] A  input matrix A[3][3] or A[4][4]
+ * @param[in] B  input matrix/vector B
+ * @param C  result matrix/vector C
+ * @return
+ *      - ESP_OK on success
+ */
+esp_err_t dspm_mult_3x3x1_f32_ansi(const float *A, const float *B, float *C);
+esp_err_t dspm_mult_3x3x3_f32_ansi(const float *A, const float *B, float *C);
+esp_err_t dspm_mult_4x4x1_f32_ansi(const float *A, const float *B, float *C);
+esp_err_t dspm_mult_4x4x4_f32_ansi(const float *A, const float *B, float *C);
+
 /**@{*/
 /**
  * @brief   Matrix multiplication 16 bit signeg int
@@ -115,6 +136,7 @@ esp_err_t dspm_mult_4x4x4_f32_ae32(const float *A, const float *B, float *C);
  * Matrix multiplication for two signed 16 bit fixed point matrices: C[m][k] = (A[m][n] * B[n][k]) >> (15- shift)
  * The extension (_ansi) use ANSI C and could be compiled and run on any platform.
  * The extension (_ae32) is optimized for ESP32 chip.
+ * The extension (_rv32) is optimized C for RISC-V (ESP32-C6) chips.
  *
  * @param[in] A  input matrix A[m][n]
  * @param[in] B  input matrix B[n][k]
@@ -130,6 +152,7 @@ esp_err_t dspm_mult_4x4x4_f32_ae32(const float *A, const float *B, float *C);
 esp_err_t dspm_mult_s16_ansi(const int16_t *A, const int16_t *B, int16_t *C, int m, int n, int k, int shift);
 esp_err_t dspm_mult_s16_ae32(const int16_t *A, const int16_t *B, int16_t *C, int m, int n, int k, int shift);
 esp_err_t dspm_mult_s16_aes3(const int16_t *A, const int16_t *B, int16_t *C, int m, int n, int k, int shift);
+esp_err_t dspm_mult_s16_rv32(const int16_t *A, const int16_t *B, int16_t *C, int m, int n, int k, int shift);
 /**@}*/
 
 /**@{*/
@@ -158,6 +181,36 @@ esp_err_t dspm_mult_ex_f32_ansi(const float *A, const float *B, float *C, int m,
 esp_err_t dspm_mult_ex_f32_ae32(const float *A, const float *B, float *C, int m, int n, int k, int A_padd, int B_padd, int C_padd);
 esp_err_t dspm_mult_ex_f32_aes3(const float *A, const float *B, float *C, int m, int n, int k, int A_padd, int B_padd, int C_padd);
 
+/**
+ * @brief   General matrix multiplication
+ *
+ * C[m][k] = alpha * op(A)[m][n] * op(B)[n][k] + beta * C[m][k], where op(X) is X
+ * or X' (X_trans not 0). Matrices are described with pointers and strides, so
+ * sub-matrices are used in place. The kernel is register and cache blocked, and
+ * does not allocate memory. C can not overlap A or B. When beta is 0 the
+ * values of C are not read.
+ *
+ * @param[in]  A  input matrix, A[m][n] or A[n][m] if A_trans
+ * @param[in]  B  input matrix, B[n][k] or B[k][n] if B_trans
+ * @param[in,out] C  result matrix C[m][k]
+ * @param[in]  m  matrix dimension
+ * @param[in]  n  matrix dimension
+ * @param[in]  k  matrix dimension
+ * @param[in]  alpha  scale of the product
+ * @param[in]  beta  scale of C
+ * @param[in]  A_stride  distance between the rows of A, as stored (at least n, or m if A_trans)
+ * @param[in]  B_stride  distance between the rows of B, as stored (at least k, or n if B_trans)
+ * @param[in]  C_stride  distance between the rows of C (at least k)
+ * @param[in]  A_trans  use A transposed
+ * @param[in]  B_trans  use B transposed
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dspm_gemm_f32_ansi(const float *A, const float *B, float *C, int m, int n, int k,
+                             float alpha, float beta, int A_stride, int B_stride, int C_stride,
+                             int A_trans, int B_trans);
+
 #ifdef __cplusplus
 }
 #endif
@@ -169,6 +222,8 @@ esp_err_t dspm_mult_ex_f32_aes3(const float *A, const float *B, float *C, int m,
 #define dspm_mult_s16 dspm_mult_s16_aes3
 #elif (dspm_mult_s16_ae32_enabled == 1)
 #define dspm_mult_s16 dspm_mult_s16_ae32
+#elif (dspm_mult_s16_rv32_enabled == 1)
+#define dspm_mult_s16 dspm_mult_s16_rv32
 #else
 #define dspm_mult_s16 dspm_mult_s16_ansi
 #endif
@@ -179,25 +234,30 @@ esp_err_t dspm_mult_ex_f32_aes3(const float *A, const float *B, float *C, int m,
 #elif (dspm_mult_f32_ae32_enabled == 1)
 #define dspm_mult_f32 dspm_mult_f32_ae32
 #define dspm_mult_ex_f32 dspm_mult_ex_f32_ae32
+#elif (dspm_mult_f32_rv32_enabled == 1)
+#define dspm_mult_f32 dspm_mult_f32_rv32
+#define dspm_mult_ex_f32 dspm_mult_ex_f32_ansi
 #else
 #define dspm_mult_f32 dspm_mult_f32_ansi
 #define dspm_mult_ex_f32 dspm_mult_ex_f32_ansi
 #endif
 
+#define dspm_gemm_f32 dspm_gemm_f32_ansi
+
 #if (dspm_mult_3x3x1_f32_ae32_enabled == 1)
 #define dspm_mult_3x3x1_f32 dspm_mult_3x3x1_f32_ae32
 #else
-#define dspm_mult_3x3x1_f32(A,B,C) dspm_mult_f32_ansi(A,B,C, 3, 3, 1)
+#define dspm_mult_3x3x1_f32 dspm_mult_3x3x1_f32_ansi
 #endif
 #if (dspm_mult_3x3x3_f32_ae32_enabled == 1)
 #define dspm_mult_3x3x3_f32(A,B,C) dspm_mult_3x3x3_f32_ae32(A,B,C)
 #else
-#define dspm_mult_3x3x3_f32(A,B,C) dspm_mult_f32_ansi(A,B,B,3,3,3);
+#define dspm_mult_3x3x3_f32 dspm_mult_3x3x3_f32_ansi
 #endif
 #if (dspm_mult_4x4x1_f32_ae32_enabled == 1)
 #define dspm_mult_4x4x1_f32(A,B,C) dspm_mult_4x4x1_f32_ae32(A,B,C)
 #else
-#define dspm_mult_4x4x1_f32(A,B,C) dspm_mult_f32_ansi(A,B,C, 4, 4, 1)
+#define dspm_mult_4x4x1_f32 dspm_mult_4x4x1_f32_ansi
 #endif
 
 #if (dspm_mult_f32_aes3_enabled == 1)
@@ -205,18 +265,66 @@ esp_err_t dspm_mult_ex_f32_aes3(const float *A, const float *B, float *C, int m,
 #elif (dspm_mult_4x4x4_f32_ae32_enabled == 1)
 #define dspm_mult_4x4x4_f32 dspm_mult_4x4x4_f32_ae32
 #else
-#define dspm_mult_4x4x4_f32(A,B,C) dspm_mult_f32_ansi(A,B,C, 4, 4, 4)
+#define dspm_mult_4x4x4_f32 dspm_mult_4x4x4_f32_ansi
 #endif
 
+#else
+#if (dspm_mult_s16_rv32_enabled == 1)
+#define dspm_mult_s16 dspm_mult_s16_rv32
 #else
 #define dspm_mult_s16 dspm_mult_s16_ansi
+#endif
+#if (dspm_mult_f32_rv32_enabled == 1)
+#define dspm_mult_f32 dspm_mult_f32_rv32
+#else
 #define dspm_mult_f32 dspm_mult_f32_ansi
-#define dspm_mult_3x3x1_f32(A,B,C) dspm_mult_f32_ansi(A,B,C, 3, 3, 1)
+#endif
+#define dspm_mult_3x3x1_f32 dspm_mult_3x3x1_f32_ansi
+#define dspm_mult_3x3x3_f32 dspm_mult_3x3x3_f32_ansi
+#define dspm_mult_4x4x1_f32 dspm_mult_4x4x1_f32_ansi
 #define dsps_sub_f32 dsps_sub_f32_ansi
 #define dsps_add_f32 dsps_add_f32_ansi
-#define dspm_mult_4x4x4_f32(A,B,C) dspm_mult_f32_ansi(A,B,C, 4, 4, 4)
+#define dspm_mult_4x4x4_f32 dspm_mult_4x4x4_f32_ansi
 #define dspm_mult_ex_f32 dspm_mult_ex_f32_ansi
+#define dspm_gemm_f32 dspm_gemm_f32_ansi
 #endif // CONFIG_DSP_OPTIMIZED
 
 
+/**
+ * @brief   Matrix multiplication with the kernel of the shape
+ *
+ * Same as dspm_mult_f32(), but the 3x3x1, 3x3x3, 4x4x1 and 4x4x4 shapes go
+ * to their own kernels. With constant dimensions the choice is made by the
+ * compiler.
+ *
+ * @param[in] A  input matrix A[m][n]
+ * @param[in] B  input matrix B[n][k]
+ * @param C  result matrix C[m][k]
+ * @param[in] m  matrix dimension
+ * @param[in] n  matrix dimension
+ * @param[in] k  matrix dimension
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+static inline esp_err_t dspm_mult_shape_f32(const float *A, const float *B, float *C, int m, int n, int k)
+{
+    if ((m == 3) && (n == 3)) {
+        if (k == 1) {
+            return dspm_mult_3x3x1_f32(A, B, C);
+        }
+        if (k == 3) {
+            return dspm_mult_3x3x3_f32(A, B, C);
+        }
+    } else if ((m == 4) && (n == 4)) {
+        if (k == 1) {
+            return dspm_mult_4x4x1_f32(A, B, C);
+        }
+        if (k == 4) {
+            return dspm_mult_4x4x4_f32(A, B, C);
+        }
+    }
+    return dspm_mult_f32(A, B, C, m, n, k);
+}
+
 #endif // _dspm_mult_H_
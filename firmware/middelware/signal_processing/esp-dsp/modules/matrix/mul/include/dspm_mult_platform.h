@@ -30,4 +30,9 @@
 #define dspm_mult_s16_aes3_enabled 1
 #endif
 
+#if defined(__riscv) && !CONFIG_DSP_ANSI
+#define dspm_mult_f32_rv32_enabled 1
+#define dspm_mult_s16_rv32_enabled 1
+#endif // __riscv
+
 #endif // _dspm_mult_platform_H_
@@ -0,0 +1,182 @@
+#ifndef DECIMATOR_H_
+#define DECIMATOR_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup Decimator Decimator
+ */
+
+/** \brief Multi-stage decimation (sample rate reduction) of continuous signals
+ * 
+ * Two stages are used: a cheap first stage (half band filters for float signals,
+ * CIC filter for 16 bits signals) followed by a FIR filter that sets the final
+ * pass band (and compensates the CIC droop). The half band filters only multiply
+ * their non zero taps, the final FIR stages use dsps_fird_f32() and dsps_fird_s16().
+ * 
+ * @author Peñalva Albano
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 16/10/2026 | Document creation		                         						|
+ * | 17/10/2026 | Half band filters skip their zero taps, init checks dsps_fird_init_f32()	|
+ * | 17/10/2026 | 16 bits decimator saturates instead of wrapping at full scale			|
+ * 
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "dsps_fir.h"
+/*==================[macros]=================================================*/
+#define DECIMATOR_HALF_BAND_TAPS    19      /*!< Taps of each half band filter (decimation by 2), 4 * k + 3 */
+#define DECIMATOR_MAX_HALF_BANDS    3       /*!< Maximum number of cascaded half band filters (decimation by 8) */
+#define DECIMATOR_CIC_ORDER         3       /*!< Number of integrator/comb pairs of the CIC filter */
+#define DECIMATOR_MAX_CIC_DECIM     32      /*!< Maximum decimation of the CIC filter */
+#define DECIMATOR_MAX_FIR_DECIM     16      /*!< Maximum decimation of the FIR filter */
+#define DECIMATOR_WORK_LENGHT       64      /*!< Input samples processed by each internal pass */
+/*==================[typedef]================================================*/
+/**
+ * @brief Float decimator: half band filters followed by a FIR filter
+ * 
+ * @note  All the fields are managed by the Decimator functions, the struct is
+ *        declared here only so the application can own its storage.
+ */
+typedef struct {
+    fir_f32_t half_band[DECIMATOR_MAX_HALF_BANDS];          /*!< Half band filters (decimation by 2 each) */
+    float half_band_delay[DECIMATOR_MAX_HALF_BANDS][2 * DECIMATOR_HALF_BAND_TAPS];  /*!< Delay lines of the half band filters (written twice) */
+    float half_band_pending[DECIMATOR_MAX_HALF_BANDS][2];   /*!< Samples of an incomplete decimation period of each half band filter */
+    uint8_t half_band_n_pending[DECIMATOR_MAX_HALF_BANDS];  /*!< Number of pending samples of each half band filter */
+    uint8_t n_half_bands;                                   /*!< Number of half band filters in use */
+    fir_f32_t fir;                                          /*!< Final FIR filter */
+    float fir_pending[DECIMATOR_MAX_FIR_DECIM];             /*!< Samples of an incomplete decimation period of the FIR filter */
+    uint8_t fir_n_pending;                                  /*!< Number of pending samples of the FIR filter */
+    float work[DECIMATOR_WORK_LENGHT];                      /*!< Intermediate samples */
+} decimator_t;
+
+/**
+ * @brief 16 bits decimator: CIC filter followed by a compensating FIR filter
+ * 
+ * @note  All the fields are managed by the Decimator functions, the struct is
+ *        declared here only so the application can own its storage.
+ */
+typedef struct {
+    uint32_t integrator[DECIMATOR_CIC_ORDER];   /*!< CIC integrators (modulo 2^32 arithmetic) */
+    uint32_t comb[DECIMATOR_CIC_ORDER];         /*!< CIC combs delay */
+    uint8_t cic_decim;                          /*!< CIC decimation */
+    uint8_t cic_count;                          /*!< Input samples since the last CIC output */
+    uint8_t cic_shift;                          /*!< Right shift that removes the CIC gain */
+    int16_t cic_limit;                          /*!< Saturation of the CIC output, so the FIR output can't overflow */
+    fir_s16_t fir;                              /*!< Compensating FIR filter (Q14 coefficients) */
+    int16_t fir_pending[DECIMATOR_MAX_FIR_DECIM];   /*!< Samples of an incomplete decimation period of the FIR filter */
+    uint8_t fir_n_pending;                      /*!< Number of pending samples of the FIR filter */
+    int16_t work[DECIMATOR_WORK_LENGHT];        /*!< Intermediate samples */
+} decimator_q15_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Initialize a float decimator
+ * 
+ * Total decimation is first_decim * fir_decim. The FIR filter is a Blackman windowed
+ * low pass with its -6 dB point at the output Nyquist frequency: with enough taps
+ * (~24 * fir_decim) the pass band is flat up to 0.35 times the output sample frequency.
+ * 
+ * @param dec           Pointer to the decimator
+ * @param first_decim   Decimation of the half band filters (1, 2, 4 or 8)
+ * @param fir_decim     Decimation of the FIR filter (1 to DECIMATOR_MAX_FIR_DECIM)
+ * @param coeffs        Array for the FIR coefficients (of lenght = n_taps)
+ * @param delay         Array for the FIR delay line (of lenght = n_taps)
+ * @param n_taps        Number of taps of the FIR filter
+ * @return true         Decimator initialized
+ * @return false        Invalid parameters, or dsps_fird_init_f32() failed (e.g. n_taps
+ *                      not a multiple of 4 on ESP32-S3)
+ */
+bool DecimatorInit(decimator_t * dec, uint8_t first_decim, uint8_t fir_decim, float * coeffs, float * delay, uint16_t n_taps);
+
+/**
+ * @brief Decimate a block of samples
+ * 
+ * Blocks can be of any lenght: samples that do not complete a decimation period
+ * are kept for the next call.
+ * 
+ * @param dec           Pointer to the decimator
+ * @param input_signal  Input samples
+ * @param signal_lenght Number of input samples
+ * @param output_signal Decimated samples (of lenght = signal_lenght / total decimation + 1)
+ * @return uint16_t     Number of decimated samples
+ */
+uint16_t DecimatorProcess(decimator_t * dec, const float * input_signal, uint16_t signal_lenght, float * output_signal);
+
+/**
+ * @brief Group delay of a float decimator
+ * 
+ * @param dec           Pointer to the decimator
+ * @return float        Delay, in input samples
+ */
+float DecimatorGroupDelay(const decimator_t * dec);
+
+/**
+ * @brief Clear the state of a float decimator
+ * 
+ * @param dec           Pointer to the decimator
+ */
+void DecimatorReset(decimator_t * dec);
+
+/**
+ * @brief Initialize a 16 bits decimator
+ * 
+ * Total decimation is cic_decim * fir_decim. The FIR filter is designed as in
+ * DecimatorInit(), and also compensates the CIC attenuation in the pass band.
+ * Coefficients are Q14, and their gain can be above 1: as dsps_fird_s16() does not
+ * saturate, the CIC output is limited to the level that keeps the FIR output in
+ * range. Signals near full scale are clipped (never wrapped) at the output.
+ * 
+ * @param dec           Pointer to the decimator
+ * @param cic_decim     Decimation of the CIC filter (1 to DECIMATOR_MAX_CIC_DECIM)
+ * @param fir_decim     Decimation of the FIR filter (1 to DECIMATOR_MAX_FIR_DECIM)
+ * @param coeffs        Array for the FIR coefficients (of lenght = n_taps)
+ * @param delay         Array for the FIR delay line (of lenght = n_taps)
+ * @param n_taps        Number of taps of the FIR filter
+ * @return true         Decimator initialized
+ * @return false        Invalid parameters
+ */
+bool DecimatorInitQ15(decimator_q15_t * dec, uint8_t cic_decim, uint8_t fir_decim, int16_t * coeffs, int16_t * delay, uint16_t n_taps);
+
+/**
+ * @brief Decimate a block of 16 bits samples
+ * 
+ * Blocks can be of any lenght: samples that do not complete a decimation period
+ * are kept for the next call.
+ * 
+ * @param dec           Pointer to the decimator
+ * @param input_signal  Input samples
+ * @param signal_lenght Number of input samples
+ * @param output_signal Decimated samples (of lenght = signal_lenght / total decimation + 1)
+ * @return uint16_t     Number of decimated samples
+ */
+uint16_t DecimatorProcessQ15(decimator_q15_t * dec, const int16_t * input_signal, uint16_t signal_lenght, int16_t * output_signal);
+
+/**
+ * @brief Group delay of a 16 bits decimator
+ * 
+ * @param dec           Pointer to the decimator
+ * @return float        Delay, in input samples
+ */
+float DecimatorGroupDelayQ15(const decimator_q15_t * dec);
+
+/**
+ * @brief Clear the state of a 16 bits decimator
+ * 
+ * @param dec           Pointer to the decimator
+ */
+void DecimatorResetQ15(decimator_q15_t * dec);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* DECIMATOR_H_ */
+
+/*==================[end of file]============================================*/
\ No newline at end of file
@@ -0,0 +1,154 @@
+#ifndef FAST_CONV_H_
+#define FAST_CONV_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup Fast_Conv Fast Convolution
+ */
+
+/** \brief Convolution and correlation with long kernels, by blocks
+ * 
+ * dsps_conv_f32(), dsps_corr_f32() and dsps_ccorr_f32() take kernel_lenght
+ * multiply-adds per output sample, which is too slow for long kernels (matched
+ * filters, template matching, long FIR responses) on targets without FPU. This
+ * module filters a stream by blocks with one of two methods, chosen when the
+ * filter is initialized:
+ * - Direct: one dsps_dotprod_f32() per output sample.
+ * - FFT (overlap-save): each block is split in two halves that are transformed
+ *   together as the real and imaginary parts of a single complex FFT, multiplied
+ *   by the spectrum of the kernel and transformed back. The cost per block does
+ *   not depend on kernel_lenght, only on the FFT lenght.
+ * 
+ * In the automatic mode the method with less floating point operations per block
+ * is used (test_sim prints the measured crossover).
+ * 
+ * @author Peñalva Albano
+ * 
+ * @section changelog
+ * 
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 16/10/2026 | Document creation		                         						|
+ * 
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+/** @brief Lenght of the workspace needed by a filter (enough for both methods) */
+#define FAST_CONV_WORK_LENGHT(kernel_lenght, block_lenght)  (5 * (block_lenght) + 9 * (kernel_lenght) + 4)
+/*==================[typedef]================================================*/
+/**
+ * @brief Operation done by a filter
+ */
+typedef enum {
+    FAST_CONV_CONVOLUTION,      /*!< y[n] = sum(kernel[k] * x[n - k]), as dsps_conv_f32() */
+    FAST_CONV_CORRELATION,      /*!< y[n] = sum(kernel[k] * x[n - kernel_lenght + 1 + k]), as dsps_corr_f32() */
+} fast_conv_mode_t;
+
+/**
+ * @brief Method used by a filter
+ */
+typedef enum {
+    FAST_CONV_AUTO,             /*!< Method with less operations for the kernel and block lenghts */
+    FAST_CONV_DIRECT,           /*!< Dot product per output sample */
+    FAST_CONV_FFT,              /*!< Overlap-save with FFT */
+} fast_conv_method_t;
+
+/**
+ * @brief Convolution / correlation filter
+ * 
+ * @note  All the fields are managed by the FastConv functions, the struct is
+ *        declared here only so the application can own its storage.
+ */
+typedef struct {
+    float * taps;               /*!< Kernel in dot product order (direct) or its scaled spectrum (FFT) */
+    float * segment;            /*!< Two segments packed as complex values (FFT only) */
+    float * line;               /*!< Last kernel_lenght - 1 input samples followed by the current block */
+    uint16_t kernel_lenght;     /*!< Number of kernel values */
+    uint16_t block_lenght;      /*!< Maximum number of samples of each block */
+    uint16_t fft_lenght;        /*!< Complex points of the FFT (0 for the direct method) */
+} fast_conv_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Initialize a convolution / correlation filter
+ * 
+ * The kernel is copied (or transformed) into the workspace, so it is not needed
+ * after this call.
+ * 
+ * @note  The FFT method uses the tables initialized by FFTInit(), which must have
+ *        been called before.
+ * 
+ * @param conv              Pointer to the filter
+ * @param work              Array for the workspace (of lenght = FAST_CONV_WORK_LENGHT(kernel_lenght, block_lenght))
+ * @param kernel            Kernel (or pattern) values
+ * @param kernel_lenght     Number of kernel values
+ * @param block_lenght      Maximum number of samples filtered by each FastConvBlock() call
+ * @param mode              FAST_CONV_CONVOLUTION or FAST_CONV_CORRELATION
+ * @param method            FAST_CONV_AUTO, FAST_CONV_DIRECT or FAST_CONV_FFT
+ * @return true             Filter initialized
+ * @return false            Invalid parameters (or FFT lenght above the initialized tables)
+ */
+bool FastConvInit(fast_conv_t * conv, float * work, const float * kernel, uint16_t kernel_lenght,
+                  uint16_t block_lenght, fast_conv_mode_t mode, fast_conv_method_t method);
+
+/**
+ * @brief Filter a block of samples
+ * 
+ * Output sample i corresponds to input sample i, with the previous blocks as
+ * history, so consecutive blocks give the same result as a single long one.
+ * 
+ * @param conv              Pointer to the filter
+ * @param input             Input samples
+ * @param output            Filtered samples (can be the input array)
+ * @param n_samples         Number of samples (up to block_lenght)
+ * @return true             Block filtered
+ * @return false            Too many samples
+ */
+bool FastConvBlock(fast_conv_t * conv, const float * input, float * output, uint16_t n_samples);
+
+/**
+ * @brief Filter a whole signal, including the tail of the kernel
+ * 
+ * Same result as dsps_conv_f32() (convolution mode) or dsps_ccorr_f32()
+ * (correlation mode). The filter is reset before and after the signal.
+ * 
+ * @param conv              Pointer to the filter
+ * @param signal            Input signal
+ * @param signal_lenght     Number of samples of the signal
+ * @param output            Result (of lenght = signal_lenght + kernel_lenght - 1)
+ */
+void FastConvFull(fast_conv_t * conv, const float * signal, uint16_t signal_lenght, float * output);
+
+/**
+ * @brief Filter a whole signal, only where the kernel fully overlaps it
+ * 
+ * Same result as dsps_corr_f32() (correlation mode). The filter is reset before
+ * and after the signal.
+ * 
+ * @param conv              Pointer to the filter
+ * @param signal            Input signal
+ * @param signal_lenght     Number of samples of the signal (at least kernel_lenght)
+ * @param output            Result (of lenght = signal_lenght - kernel_lenght + 1)
+ * @return true             Signal filtered
+ * @return false            Signal shorter than the kernel
+ */
+bool FastConvValid(fast_conv_t * conv, const float * signal, uint16_t signal_lenght, float * output);
+
+/**
+ * @brief Clear the history of a filter
+ * 
+ * @param conv              Pointer to the filter
+ */
+void FastConvReset(fast_conv_t * conv);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* FAST_CONV_H_ */
+
+/*==================[end of file]============================================*/
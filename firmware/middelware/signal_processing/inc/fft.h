@@ -16,6 +16,15 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 15/03/2024 | Document creation		                         						|
+ * | 16/10/2026 | Streaming spectrum analyzer with Welch averaging	    				|
+ * | 16/10/2026 | Real-input FFT (N/2 complex points, radix-4)	        				|
+ * | 16/10/2026 | Fixed-point (Q15) FFT magnitude for ADC values	        				|
+ * | 16/10/2026 | Goertzel bank for a few selected frequencies	        				|
+ * | 16/10/2026 | Sliding DFT updated on every sample		        				|
+ * | 16/10/2026 | Reentrant FFT contexts with caller-owned workspace	    			|
+ * | 16/10/2026 | Spectral features computed with the power spectrum	    			|
+ * | 17/10/2026 | FFTMagnitude() bins other than DC are half of the values before the	|
+ * |            | real-input FFT: they are now the amplitude of each sine		        |
  * 
  **/
 
@@ -24,7 +33,148 @@
 #include <stdbool.h>
 /*==================[macros]=================================================*/
 #define MAX_SIGNAL_LENGHT   2048
+#define MAX_Q15_INPUT       4095    /*!< Maximum input value accepted by FFTMagnitudeQ15() */
+/** @brief Lenght of the buffer needed by a Goertzel bank of n_bins frequencies */
+#define FFT_GOERTZEL_LENGHT(n_bins)     (5 * (n_bins))
+/** @brief Lenght of the state array needed by a sliding DFT of n_bins bins */
+#define FFT_SLIDING_LENGHT(n_bins)      (24 * (n_bins))
+/** @brief Lenght of the workspace needed by an FFT context of signal_lenght samples */
+#define FFT_CONTEXT_LENGHT(signal_lenght)   (signal_lenght)
+#define FFT_MAX_BANDS       8       /*!< Maximum number of bands of the spectral features */
 /*==================[typedef]================================================*/
+/**
+ * @brief FFT context: workspace and window of an FFT of a given lenght
+ * 
+ * Each context only uses its own workspace, so contexts can be used at the same 
+ * time from different tasks (e.g. an acquisition task and an analysis task).
+ * 
+ * @note  All the fields are managed by the FFTContext functions, the struct is 
+ *        declared here only so the application can own its storage.
+ */
+typedef struct {
+    float * work;               /*!< Windowed signal packed as complex values, then power spectrum */
+    const float * window;       /*!< Cached Hann window of signal_lenght samples */
+    uint16_t signal_lenght;     /*!< Number of samples of each FFT */
+} fft_context_t;
+
+/**
+ * @brief Fixed-point (Q15) FFT context
+ * 
+ * @note  All the fields are managed by the FFTContext functions, the struct is 
+ *        declared here only so the application can own its storage.
+ */
+typedef struct {
+    int16_t * work;             /*!< Windowed signal packed as complex Q15 values, then spectrum */
+    const int16_t * window;     /*!< Cached Q15 Hann window of signal_lenght samples */
+    uint16_t signal_lenght;     /*!< Number of samples of each FFT */
+} fft_context_q15_t;
+
+/**
+ * @brief Streaming spectrum analyzer state
+ * 
+ * @note  All the fields are managed by the FFTStream functions, the struct is 
+ *        declared here only so the application can own its storage.
+ */
+typedef struct {
+    float * buffer;             /*!< Circular buffer with the last frame_lenght samples */
+    float * power;              /*!< Accumulated power spectrum followed by the last averaged one */
+    const float * window;       /*!< Cached Hann window of frame_lenght samples */
+    uint16_t frame_lenght;      /*!< Number of samples of each FFT frame */
+    uint16_t hop_size;          /*!< Number of new samples between consecutive frames */
+    uint16_t write_index;       /*!< Position of the next sample in the circular buffer */
+    uint16_t fill;              /*!< Number of valid samples in the circular buffer */
+    uint16_t hop_count;         /*!< Number of samples pushed since the last frame */
+    uint8_t averages;           /*!< Number of frames averaged in each output spectrum */
+    uint8_t frames;             /*!< Number of frames accumulated in the current average */
+    bool ready;                 /*!< A new averaged spectrum is waiting to be read */
+} fft_stream_t;
+
+/**
+ * @brief Goertzel bank state: magnitudes of a few frequencies, updated sample by sample
+ * 
+ * @note  All the fields are managed by the FFTGoertzel functions, the struct is 
+ *        declared here only so the application can own its storage.
+ */
+typedef struct {
+    float * coeffs;             /*!< 2 cos(w) and sin(w) of each frequency */
+    float * state;              /*!< s[n-1] and s[n-2] of each frequency */
+    float * magnitude;          /*!< Magnitudes of the last complete block */
+    const float * window;       /*!< Cached Hann window of block_lenght samples */
+    uint16_t block_lenght;      /*!< Number of samples of each block */
+    uint16_t count;             /*!< Samples of the current block already processed */
+    uint8_t n_bins;             /*!< Number of frequencies */
+    bool ready;                 /*!< New magnitudes are waiting to be read */
+} fft_goertzel_t;
+
+/**
+ * @brief Fixed-point (Q15) Goertzel bank state
+ * 
+ * @note  All the fields are managed by the FFTGoertzel functions, the struct is 
+ *        declared here only so the application can own its storage.
+ */
+typedef struct {
+    int32_t * coeffs;           /*!< 2 cos(w) and sin(w) of each frequency (Q30) */
+    int32_t * state;            /*!< s[n-1] and s[n-2] of each frequency */
+    int32_t * magnitude;        /*!< Magnitudes of the last complete block */
+    const int16_t * window;     /*!< Cached Q15 Hann window of block_lenght samples */
+    uint8_t input_shift;        /*!< Right shift of windowed samples that keeps the state below 2^29 */
+    uint8_t output_shift;       /*!< Right shift that converts |X| into magnitude values */
+    uint16_t block_lenght;      /*!< Number of samples of each block */
+    uint16_t count;             /*!< Samples of the current block already processed */
+    uint8_t n_bins;             /*!< Number of frequencies */
+    bool ready;                 /*!< New magnitudes are waiting to be read */
+} fft_goertzel_q15_t;
+
+/**
+ * @brief Sliding DFT state: magnitudes of a few bins, updated on every sample
+ * 
+ * @note  All the fields are managed by the FFTSliding functions, the struct is 
+ *        declared here only so the application can own its storage.
+ */
+typedef struct {
+    float * buffer;             /*!< Circular buffer with the last window_lenght samples */
+    float * state;              /*!< Recursive DFT of bins k-1, k and k+1 of each selected bin */
+    float * anchor;             /*!< DFT of the current block, computed by direct summation */
+    float * phasor;             /*!< exp(-j w m) of each resonator for the current block sample */
+    float * twiddle;            /*!< exp(j w) of each resonator */
+    const uint16_t * bins;      /*!< Selected bins */
+    uint16_t window_lenght;     /*!< Number of samples of the sliding window */
+    uint16_t write_index;       /*!< Position of the oldest sample in buffer */
+    uint16_t fill;              /*!< Number of valid samples in buffer */
+    uint8_t n_bins;             /*!< Number of selected bins */
+} fft_sliding_t;
+
+/**
+ * @brief Spectral features configuration: bins of each band and of the analyzed range
+ * 
+ * @note  All the fields are managed by the FFTFeatures functions, the struct is 
+ *        declared here only so the application can own its storage.
+ */
+typedef struct {
+    float bin_width;                            /*!< Frequency step between bins (sample_freq / signal_lenght) */
+    uint16_t signal_lenght;                     /*!< Number of samples of each FFT */
+    uint16_t first_bin;                         /*!< First bin used by peak, centroid, total power and SNR */
+    uint16_t band_start[FFT_MAX_BANDS];         /*!< First bin of each band */
+    uint16_t band_end[FFT_MAX_BANDS];           /*!< Bin after the last one of each band */
+    uint16_t edges[2 * FFT_MAX_BANDS + 3];      /*!< Sorted bins where a band (or the analyzed range) starts or ends */
+    uint8_t n_edges;                            /*!< Number of edges */
+    uint8_t n_bands;                            /*!< Number of bands */
+} fft_features_config_t;
+
+/**
+ * @brief Spectral features of a signal
+ * 
+ * Magnitudes have the same scale as FFTMagnitude() values, and powers are sums of 
+ * squared magnitudes.
+ */
+typedef struct {
+    float peak_frequency;                       /*!< Frequency of the highest bin, with parabolic interpolation */
+    float peak_magnitude;                       /*!< Magnitude of the peak, corrected for the window at peak_frequency */
+    float centroid;                             /*!< Spectral centroid (magnitude weighted mean frequency) */
+    float total_power;                          /*!< Power of all the bins from min_freq */
+    float snr;                                  /*!< Power of the peak against the rest of the bins from min_freq, in dB */
+    float band_power[FFT_MAX_BANDS];            /*!< Power of each band */
+} fft_features_t;
 
 /*==================[external data declaration]==============================*/
 
@@ -40,7 +190,16 @@ bool FFTInit(void);
 /**
  * @brief Calculates the Fast Fourier Transform of a given signal
  * 
+ * The N real samples are transformed as N/2 complex values, so FFTInit() 
+ * must have been called before.
+ * 
+ * Magnitudes are in signal units (Hann window compensated): a sine of amplitude A
+ * centered on bin k gives fft[k] = A * (N - 1) / N, and a constant value c gives
+ * fft[0] = c * (N - 1) / N (the window sum is (N - 1) / 2).
+ * 
  * @note  Lenght of signal array must be a power of two (with maximun value = MAX_SIGNAL_LENGHT)
+ * @note  The complex-input implementation used before the real-input FFT returned
+ *        twice these values in every bin but DC (fft[0] has the same scale).
  * 
  * @param signal            Array with signal values (of lenght = signal_lenght)
  * @param fft               Array to store FFT magnitude values (of lenght = signal_lenght / 2)
@@ -57,6 +216,340 @@ void FFTMagnitude(float * signal, float * fft, uint16_t signal_lenght);
  */
 void FFTFrequency(float sample_freq, uint16_t signal_lenght, float * f);
 
+/**
+ * @brief Calculates the Fast Fourier Transform of a given signal using fixed-point (Q15) arithmetic
+ * 
+ * Integer version of FFTMagnitude() for targets without FPU: values read with 
+ * AnalogInputReadSingle() can be used directly, and magnitudes are returned in 
+ * the same units as the input (with a resolution of one unit).
+ * 
+ * @note  Lenght of signal array must be a power of two (with maximun value = MAX_SIGNAL_LENGHT)
+ *        and input values must not exceed MAX_Q15_INPUT.
+ * 
+ * @param signal            Array with signal values (of lenght = signal_lenght)
+ * @param fft               Array to store FFT magnitude values (of lenght = signal_lenght / 2)
+ * @param signal_lenght     Lenght of signal arrays
+ */
+void FFTMagnitudeQ15(const uint16_t * signal, uint16_t * fft, uint16_t signal_lenght);
+
+/**
+ * @brief Initialize an FFT context
+ * 
+ * FFTMagnitude() and FFTMagnitudeQ15() share a static buffer of MAX_SIGNAL_LENGHT 
+ * samples, so they can only be used from one task. A context uses a workspace 
+ * given by the application instead, sized for the actual signal lenght.
+ * 
+ * @note  signal_lenght must be a power of two (with maximun value = MAX_SIGNAL_LENGHT)
+ *        and FFTInit() must have been called before. Contexts must be initialized 
+ *        before the tasks that use them are started (the window cache is shared).
+ * 
+ * @param ctx               Pointer to the context
+ * @param work              Array for the workspace (of lenght = FFT_CONTEXT_LENGHT(signal_lenght))
+ * @param signal_lenght     Number of samples of each FFT
+ * @return true             Context initialized
+ * @return false            Invalid parameters or not enough memory for the window
+ */
+bool FFTContextInit(fft_context_t * ctx, float * work, uint16_t signal_lenght);
+
+/**
+ * @brief Calculates the FFT magnitude of a signal using a context
+ * 
+ * Same result as FFTMagnitude(). The FFT is computed in place in the workspace and 
+ * magnitudes are written directly into fft. The workspace can be the signal array 
+ * itself (the signal is then overwritten), and fft can be the workspace: a single 
+ * array of signal_lenght samples is enough.
+ * 
+ * @param ctx               Pointer to the context
+ * @param signal            Array with signal values (of lenght = signal_lenght)
+ * @param fft               Array to store FFT magnitude values (of lenght = signal_lenght / 2)
+ */
+void FFTContextMagnitude(fft_context_t * ctx, const float * signal, float * fft);
+
+/**
+ * @brief Initialize a fixed-point (Q15) FFT context
+ * 
+ * @note  signal_lenght must be a power of two (with maximun value = MAX_SIGNAL_LENGHT)
+ *        and FFTInit() must have been called before. Contexts must be initialized 
+ *        before the tasks that use them are started (the window cache is shared).
+ * 
+ * @param ctx               Pointer to the context
+ * @param work              Array for the workspace (of lenght = FFT_CONTEXT_LENGHT(signal_lenght))
+ * @param signal_lenght     Number of samples of each FFT
+ * @return true             Context initialized
+ * @return false            Invalid parameters or not enough memory for the window
+ */
+bool FFTContextInitQ15(fft_context_q15_t * ctx, int16_t * work, uint16_t signal_lenght);
+
+/**
+ * @brief Calculates the FFT magnitude of a signal using a fixed-point (Q15) context
+ * 
+ * Same result as FFTMagnitudeQ15(). As in FFTContextMagnitude(), the workspace can 
+ * be the signal array and fft can be the workspace.
+ * 
+ * @note  Input values must not exceed MAX_Q15_INPUT.
+ * 
+ * @param ctx               Pointer to the context
+ * @param signal            Array with signal values (of lenght = signal_lenght)
+ * @param fft               Array to store FFT magnitude values (of lenght = signal_lenght / 2)
+ */
+void FFTContextMagnitudeQ15(fft_context_q15_t * ctx, const uint16_t * signal, uint16_t * fft);
+
+/**
+ * @brief Initialize the configuration of the spectral features
+ * 
+ * Bands are given as pairs of frequencies: band i includes the bins with frequencies 
+ * from bands[2*i] (included) to bands[2*i+1] (not included). Bands can overlap. Bins 
+ * below min_freq are left out of the peak, centroid, total power and SNR (e.g. to 
+ * skip the DC offset of ADC signals).
+ * 
+ * @note  signal_lenght must be a power of two (with maximun value = MAX_SIGNAL_LENGHT)
+ * 
+ * @param config            Pointer to the configuration
+ * @param sample_freq       Sample frequency
+ * @param signal_lenght     Number of samples of each FFT
+ * @param min_freq          Lowest frequency of the peak, centroid, total power and SNR
+ * @param bands             Array with the limits of each band (of lenght = 2 * n_bands)
+ * @param n_bands           Number of bands (0 to FFT_MAX_BANDS)
+ * @return true             Configuration initialized
+ * @return false            Invalid parameters
+ */
+bool FFTFeaturesInit(fft_features_config_t * config, float sample_freq, uint16_t signal_lenght, float min_freq, const float * bands, uint8_t n_bands);
+
+/**
+ * @brief Calculates the spectral features of a signal
+ * 
+ * Features are computed in the same pass over the spectrum that computes the 
+ * magnitudes, without magnitude or frequency arrays. The peak is interpolated with 
+ * a parabola over the log magnitudes of three bins: frequency and magnitude of a 
+ * tone are accurate to a few hundredths of a bin and ~0.1 %. The SNR takes the peak 
+ * bin and its two neighbours on each side (Hann main lobe) as signal, and is limited 
+ * to about 70 dB by the float resolution.
+ * 
+ * @note  Uses the same static buffer as FFTMagnitude(), see FFTContextFeatures()
+ * 
+ * @param config            Pointer to the configuration
+ * @param signal            Array with signal values (of lenght = signal_lenght)
+ * @param features          Pointer to store the features
+ * @return true             Features computed
+ * @return false            Not enough memory for the window
+ */
+bool FFTFeatures(const fft_features_config_t * config, const float * signal, fft_features_t * features);
+
+/**
+ * @brief Calculates the spectral features of a signal using a context
+ * 
+ * Same result as FFTFeatures(). The workspace can be the signal array itself.
+ * 
+ * @param ctx               Pointer to the context
+ * @param config            Pointer to the configuration (of the same signal_lenght as ctx)
+ * @param signal            Array with signal values (of lenght = signal_lenght)
+ * @param features          Pointer to store the features
+ * @return true             Features computed
+ * @return false            Context and configuration lenghts differ
+ */
+bool FFTContextFeatures(fft_context_t * ctx, const fft_features_config_t * config, const float * signal, fft_features_t * features);
+
+/**
+ * @brief Initialize a streaming spectrum analyzer
+ * 
+ * Frames of frame_lenght samples are taken every hop_size samples (overlap = 
+ * frame_lenght - hop_size) and their power spectra are averaged over 
+ * "averages" frames (Welch method) before a new spectrum is delivered.
+ * 
+ * @note  frame_lenght must be a power of two (with maximun value = MAX_SIGNAL_LENGHT)
+ *        and FFTInit() must have been called before.
+ * 
+ * @param stream            Pointer to the analyzer state
+ * @param buffer            Array to store the input samples (of lenght = frame_lenght)
+ * @param power             Array to store the power spectra (of lenght = frame_lenght)
+ * @param frame_lenght      Number of samples of each FFT frame
+ * @param hop_size          Number of new samples between frames (1 to frame_lenght)
+ * @param averages          Number of frames averaged in each spectrum (at least 1)
+ * @return true             Analyzer initialized
+ * @return false            Invalid parameters or not enough memory for the window
+ */
+bool FFTStreamInit(fft_stream_t * stream, float * buffer, float * power, uint16_t frame_lenght, uint16_t hop_size, uint8_t averages);
+
+/**
+ * @brief Push new samples into a streaming spectrum analyzer
+ * 
+ * An FFT is computed each time hop_size new samples are available.
+ * 
+ * @param stream            Pointer to the analyzer state
+ * @param samples           Array with the new signal values
+ * @param n_samples         Number of new samples
+ * @return true             A new averaged spectrum is available
+ * @return false            No new spectrum yet
+ */
+bool FFTStreamPush(fft_stream_t * stream, const float * samples, uint16_t n_samples);
+
+/**
+ * @brief Read the last averaged spectrum of a streaming spectrum analyzer
+ * 
+ * Magnitude values have the same scale as the ones returned by FFTMagnitude().
+ * 
+ * @param stream            Pointer to the analyzer state
+ * @param fft               Array to store FFT magnitude values (of lenght = frame_lenght / 2)
+ * @return true             A new spectrum was copied into fft
+ * @return false            No new spectrum since the last call
+ */
+bool FFTStreamGetSpectrum(fft_stream_t * stream, float * fft);
+
+/**
+ * @brief Discard the samples and partial averages of a streaming spectrum analyzer
+ * 
+ * @param stream            Pointer to the analyzer state
+ */
+void FFTStreamReset(fft_stream_t * stream);
+
+/**
+ * @brief Initialize a Goertzel bank
+ * 
+ * Each block of block_lenght samples is windowed (Hann) as in FFTMagnitude(), so 
+ * the magnitude of a frequency equal to i * sample_freq / block_lenght is the same 
+ * as FFTMagnitude() bin i. Any other frequency (below sample_freq / 2) can also be used.
+ * 
+ * @note  block_lenght must be a power of two (with maximun value = MAX_SIGNAL_LENGHT)
+ * 
+ * @param goertzel          Pointer to the Goertzel bank state
+ * @param buffer            Array for coefficients, state and results (of lenght = FFT_GOERTZEL_LENGHT(n_bins))
+ * @param frequencies       Array with the frequencies to analyze (of lenght = n_bins)
+ * @param n_bins            Number of frequencies
+ * @param sample_freq       Sample frequency
+ * @param block_lenght      Number of samples of each block
+ * @return true             Goertzel bank initialized
+ * @return false            Invalid parameters or not enough memory for the window
+ */
+bool FFTGoertzelInit(fft_goertzel_t * goertzel, float * buffer, const float * frequencies, uint8_t n_bins, float sample_freq, uint16_t block_lenght);
+
+/**
+ * @brief Process a new sample with a Goertzel bank
+ * 
+ * Cost is a multiplication and two additions per frequency, so it can be called 
+ * from the acquisition loop for each new sample.
+ * 
+ * @param goertzel          Pointer to the Goertzel bank state
+ * @param sample            New signal value
+ * @return true             The sample completed a block: new magnitudes are available
+ * @return false            Block not completed yet
+ */
+bool FFTGoertzelUpdate(fft_goertzel_t * goertzel, float sample);
+
+/**
+ * @brief Read the magnitudes of the last complete block of a Goertzel bank
+ * 
+ * Magnitude values have the same scale as the ones returned by FFTMagnitude().
+ * 
+ * @param goertzel          Pointer to the Goertzel bank state
+ * @param magnitude         Array to store magnitude values (of lenght = n_bins)
+ * @return true             New magnitudes were copied into magnitude
+ * @return false            No new block since the last call
+ */
+bool FFTGoertzelGetMagnitude(fft_goertzel_t * goertzel, float * magnitude);
+
+/**
+ * @brief Discard the current block of a Goertzel bank
+ * 
+ * @param goertzel          Pointer to the Goertzel bank state
+ */
+void FFTGoertzelReset(fft_goertzel_t * goertzel);
+
+/**
+ * @brief Initialize a fixed-point (Q15) Goertzel bank
+ * 
+ * Integer version of FFTGoertzelInit(): values read with AnalogInputReadSingle() 
+ * can be used directly, and magnitudes have the same scale as FFTMagnitudeQ15().
+ * 
+ * @note  block_lenght must be a power of two (with maximun value = MAX_SIGNAL_LENGHT),
+ *        frequencies must be at least sample_freq / block_lenght and input values 
+ *        must not exceed MAX_Q15_INPUT.
+ * 
+ * @param goertzel          Pointer to the Goertzel bank state
+ * @param buffer            Array for coefficients, state and results (of lenght = FFT_GOERTZEL_LENGHT(n_bins))
+ * @param frequencies       Array with the frequencies to analyze (of lenght = n_bins)
+ * @param n_bins            Number of frequencies
+ * @param sample_freq       Sample frequency
+ * @param block_lenght      Number of samples of each block
+ * @return true             Goertzel bank initialized
+ * @return false            Invalid parameters or not enough memory for the window
+ */
+bool FFTGoertzelInitQ15(fft_goertzel_q15_t * goertzel, int32_t * buffer, const float * frequencies, uint8_t n_bins, float sample_freq, uint16_t block_lenght);
+
+/**
+ * @brief Process a new sample with a fixed-point (Q15) Goertzel bank
+ * 
+ * @param goertzel          Pointer to the Goertzel bank state
+ * @param sample            New signal value
+ * @return true             The sample completed a block: new magnitudes are available
+ * @return false            Block not completed yet
+ */
+bool FFTGoertzelUpdateQ15(fft_goertzel_q15_t * goertzel, uint16_t sample);
+
+/**
+ * @brief Read the magnitudes of the last complete block of a fixed-point (Q15) Goertzel bank
+ * 
+ * @param goertzel          Pointer to the Goertzel bank state
+ * @param magnitude         Array to store magnitude values (of lenght = n_bins)
+ * @return true             New magnitudes were copied into magnitude
+ * @return false            No new block since the last call
+ */
+bool FFTGoertzelGetMagnitudeQ15(fft_goertzel_q15_t * goertzel, uint16_t * magnitude);
+
+/**
+ * @brief Discard the current block of a fixed-point (Q15) Goertzel bank
+ * 
+ * @param goertzel          Pointer to the Goertzel bank state
+ */
+void FFTGoertzelResetQ15(fft_goertzel_q15_t * goertzel);
+
+/**
+ * @brief Initialize a sliding DFT
+ * 
+ * The magnitudes of the selected bins are updated with each new sample, for the 
+ * last window_lenght samples. The Hann window is applied in the frequency domain, 
+ * so bin i has (almost) the same value as FFTMagnitude() bin i of those samples 
+ * (frequencies of the bins are given by FFTFrequency()). Once every window_lenght 
+ * samples the recursive values are replaced by a direct summation, so rounding 
+ * errors do not accumulate.
+ * 
+ * @param sliding           Pointer to the sliding DFT state
+ * @param buffer            Array for the last samples (of lenght = window_lenght)
+ * @param state             Array for the bins state (of lenght = FFT_SLIDING_LENGHT(n_bins))
+ * @param bins              Array with the selected bins, lower than window_lenght / 2 (of lenght = n_bins)
+ * @param n_bins            Number of selected bins
+ * @param window_lenght     Number of samples of the sliding window (with maximun value = MAX_SIGNAL_LENGHT)
+ * @return true             Sliding DFT initialized
+ * @return false            Invalid parameters
+ */
+bool FFTSlidingInit(fft_sliding_t * sliding, float * buffer, float * state, const uint16_t * bins, uint8_t n_bins, uint16_t window_lenght);
+
+/**
+ * @brief Process a new sample with a sliding DFT
+ * 
+ * Cost does not depend on window_lenght: three complex rotations per selected bin.
+ * 
+ * @param sliding           Pointer to the sliding DFT state
+ * @param sample            New signal value
+ */
+void FFTSlidingUpdate(fft_sliding_t * sliding, float sample);
+
+/**
+ * @brief Read the magnitudes of the selected bins for the last window_lenght samples
+ * 
+ * @param sliding           Pointer to the sliding DFT state
+ * @param magnitude         Array to store magnitude values (of lenght = n_bins)
+ * @return true             Magnitudes copied into magnitude
+ * @return false            Less than window_lenght samples processed since the last reset
+ */
+bool FFTSlidingGetMagnitude(const fft_sliding_t * sliding, float * magnitude);
+
+/**
+ * @brief Clear the samples and state of a sliding DFT
+ * 
+ * @param sliding           Pointer to the sliding DFT state
+ */
+void FFTSlidingReset(fft_sliding_t * sliding);
+
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
@@ -16,13 +16,33 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 15/03/2024 | Document creation		                         						|
+ * | 16/10/2026 | Multi-instance, multi-channel filter objects	        				|
+ * | 16/10/2026 | Fixed point (Q15) filter objects	        							|
+ * | 16/10/2026 | Sample by sample (ISR safe) filtering		        					|
+ * | 16/10/2026 | Band pass with mains notch in a single cascade	        				|
+ * | 17/10/2026 | LowPass/HiPass ignore unsupported orders and lengths				|
  * 
  **/
 
 /*==================[inclusions]=============================================*/
 #include <stdint.h>
+#include <stdbool.h>
 /*==================[macros]=================================================*/
+#define IIR_SOS_COEFFS      5       /*!< Coefficients of each second order section: b0, b1, b2, a1, a2 */
+#define IIR_SOS_DELAY       2       /*!< Delay values of each second order section (per channel) */
+#define IIR_SOS_DELAY_Q15   6       /*!< Delay values of each fixed point section (per channel): x[n-1], x[n-2], y[n-1], y[n-2] and two rounding errors */
+#define IIR_COEFFS_Q_SHIFT  30      /*!< Fixed point coefficients are Q30 (range -2 to 2) */
 
+/** @brief Number of coefficients needed by a filter of n_sections second order sections */
+#define IIR_COEFFS_LENGHT(n_sections)               ((n_sections) * IIR_SOS_COEFFS)
+/** @brief Number of delay values needed by a filter of n_sections second order sections and n_channels channels */
+#define IIR_DELAY_LENGHT(n_sections, n_channels)    ((n_sections) * (n_channels) * IIR_SOS_DELAY)
+/** @brief Number of delay values needed by a fixed point filter of n_sections second order sections and n_channels channels */
+#define IIR_DELAY_Q15_LENGHT(n_sections, n_channels)    ((n_sections) * (n_channels) * IIR_SOS_DELAY_Q15)
+/** @brief Number of sections of a band pass filter (hp_order + lp_order), plus a notch section if with_notch is true */
+#define IIR_BAND_PASS_SECTIONS(hp_order, lp_order, with_notch)  ((hp_order) / 2 + (lp_order) / 2 + ((with_notch) ? 1 : 0))
+#define MAINS_50HZ          50.0f   /*!< Mains frequency (notch_frec) in Argentina and Europe */
+#define MAINS_60HZ          60.0f   /*!< Mains frequency (notch_frec) in America */
 /*==================[typedef]================================================*/
 typedef enum filter_order {
     ORDER_2 = 2,        /*!< 2nd order filter */
@@ -30,6 +50,27 @@ typedef enum filter_order {
     ORDER_6 = 6,        /*!< 6th order filter */
     ORDER_8 = 8         /*!< 8th order filter */
 } filter_order_t;
+
+typedef enum iir_format {
+    IIR_FLOAT = 0,      /*!< Floating point samples and coefficients (transposed direct form II) */
+    IIR_Q15             /*!< Q15 samples, Q30 coefficients and 64 bits accumulators (direct form I) */
+} iir_format_t;
+
+/**
+ * @brief IIR filter object: a cascade of second order sections (biquads)
+ * 
+ * @note  Storage for coefficients and delay lines is owned by the application,
+ *        so any number of independent filters can run at the same time.
+ */
+typedef struct {
+    float * coeffs;             /*!< Coefficients of every section (IIR_COEFFS_LENGHT(n_sections) values) */
+    float * delay;              /*!< Delay lines of every channel (IIR_DELAY_LENGHT(n_sections, n_channels) values) */
+    uint8_t n_sections;         /*!< Number of cascaded second order sections */
+    uint8_t n_channels;         /*!< Number of interleaved channels processed by the filter */
+    iir_format_t format;        /*!< Arithmetic used by the filter */
+    int32_t * coeffs_q;         /*!< Quantized coefficients (IIR_Q15 only, IIR_COEFFS_LENGHT(n_sections) values) */
+    int16_t * delay_q15;        /*!< Delay lines of every channel (IIR_Q15 only, IIR_DELAY_Q15_LENGHT(n_sections, n_channels) values) */
+} iir_filter_t;
 /*==================[external data declaration]==============================*/
 
 /*==================[external functions declaration]=========================*/
@@ -38,7 +79,7 @@ typedef enum filter_order {
  * 
  * @param sample_frec   Signal's sample frequency
  * @param cut_frec      Filter's cut-off frequency
- * @param order         Filter's order (2, 4, 6 or 8)
+ * @param order         Filter's order (2, 4, 6 or 8), other orders are ignored
  */
 void LowPassInit(float sample_frec, float cut_frec, filter_order_t order);
 
@@ -47,7 +88,7 @@ void LowPassInit(float sample_frec, float cut_frec, filter_order_t order);
  * 
  * @param sample_frec   Signal's sample frequency
  * @param cut_frec      Filter's cut-off frequency
- * @param order         Filter's order (2, 4, 6 or 8)
+ * @param order         Filter's order (2, 4, 6 or 8), other orders are ignored
  */
 void HiPassInit(float sample_frec, float cut_frec, filter_order_t order);
 
@@ -56,7 +97,7 @@ void HiPassInit(float sample_frec, float cut_frec, filter_order_t order);
  * 
  * @param input_signal      Input signal array
  * @param output_signal     Filtered signal array
- * @param signal_lenght     Number of samples of both signals
+ * @param signal_lenght     Number of samples of both signals (nothing is done if it is not positive)
  */
 void LowPassFilter(float * input_signal, float * output_signal, int16_t signal_lenght);
 
@@ -65,10 +106,146 @@ void LowPassFilter(float * input_signal, float * output_signal, int16_t signal_l
  * 
  * @param input_signal      Input signal array
  * @param output_signal     Filtered signal array
- * @param signal_lenght     Number of samples of both signals
+ * @param signal_lenght     Number of samples of both signals (nothing is done if it is not positive)
  */
 void HiPassFilter(float * input_signal, float * output_signal, int16_t signal_lenght);
 
+/**
+ * @brief Initialize an IIR filter object
+ * 
+ * Every section is set as a pass-through (b0 = 1) and delay lines are cleared.
+ * 
+ * @param filter        Pointer to the filter object
+ * @param coeffs        Array for the coefficients (of lenght = IIR_COEFFS_LENGHT(n_sections))
+ * @param delay         Array for the delay lines (of lenght = IIR_DELAY_LENGHT(n_sections, n_channels))
+ * @param n_sections    Number of cascaded second order sections
+ * @param n_channels    Number of interleaved channels
+ * @return true         Filter initialized
+ * @return false        Invalid parameters
+ */
+bool IIRFilterInit(iir_filter_t * filter, float * coeffs, float * delay, uint8_t n_sections, uint8_t n_channels);
+
+/**
+ * @brief Initialize a fixed point (Q15) IIR filter object
+ * 
+ * Filters are designed in floating point (coeffs) and the design functions quantize
+ * the coefficients to Q30 (coeffs_q). Every section is set as a pass-through and
+ * delay lines are cleared.
+ * 
+ * @param filter        Pointer to the filter object
+ * @param coeffs        Array for the floating point design (of lenght = IIR_COEFFS_LENGHT(n_sections))
+ * @param coeffs_q      Array for the quantized coefficients (of lenght = IIR_COEFFS_LENGHT(n_sections))
+ * @param delay_q15     Array for the delay lines (of lenght = IIR_DELAY_Q15_LENGHT(n_sections, n_channels))
+ * @param n_sections    Number of cascaded second order sections
+ * @param n_channels    Number of interleaved channels
+ * @return true         Filter initialized
+ * @return false        Invalid parameters
+ */
+bool IIRFilterInitQ15(iir_filter_t * filter, float * coeffs, int32_t * coeffs_q, int16_t * delay_q15, uint8_t n_sections, uint8_t n_channels);
+
+/**
+ * @brief Design a Butterworth low pass filter using all the sections of a filter object
+ * 
+ * @note  Filter's order is 2 * n_sections
+ * 
+ * @param filter        Pointer to the filter object
+ * @param sample_frec   Signal's sample frequency
+ * @param cut_frec      Filter's cut-off frequency
+ */
+void IIRFilterDesignLowPass(iir_filter_t * filter, float sample_frec, float cut_frec);
+
+/**
+ * @brief Design a Butterworth hi pass filter using all the sections of a filter object
+ * 
+ * @note  Filter's order is 2 * n_sections
+ * 
+ * @param filter        Pointer to the filter object
+ * @param sample_frec   Signal's sample frequency
+ * @param cut_frec      Filter's cut-off frequency
+ */
+void IIRFilterDesignHiPass(iir_filter_t * filter, float sample_frec, float cut_frec);
+
+/**
+ * @brief Design a Butterworth band pass filter, with an optional mains notch, as a single cascade
+ * 
+ * Sections are: hi pass (hp_order / 2), low pass (lp_order / 2) and notch (if notch_frec > 0),
+ * so the whole chain is applied in a single pass by IIRFilterProcess(). The filter object
+ * must have IIR_BAND_PASS_SECTIONS(hp_order, lp_order, notch_frec > 0) sections.
+ * 
+ * @param filter        Pointer to the filter object
+ * @param sample_frec   Signal's sample frequency
+ * @param low_cut_frec  Lower cut-off frequency (hi pass)
+ * @param hp_order      Order of the hi pass part (2, 4, 6 or 8)
+ * @param high_cut_frec Upper cut-off frequency (low pass)
+ * @param lp_order      Order of the low pass part (2, 4, 6 or 8)
+ * @param notch_frec    Frequency to reject (MAINS_50HZ, MAINS_60HZ), 0 for no notch
+ * @return true         Filter designed
+ * @return false        Number of sections of the filter object does not match
+ */
+bool IIRFilterDesignBandPass(iir_filter_t * filter, float sample_frec, float low_cut_frec, filter_order_t hp_order, float high_cut_frec, filter_order_t lp_order, float notch_frec);
+
+/**
+ * @brief Apply a filter object to a block of interleaved samples
+ * 
+ * All the sections and channels are processed in a single pass over the data.
+ * Input and output arrays can be the same array. Only for IIR_FLOAT filters.
+ * 
+ * @param filter        Pointer to the filter object
+ * @param input_signal  Input samples: ch0[0], ch1[0], ... chN[0], ch0[1], ...
+ * @param output_signal Filtered samples (same layout as input_signal)
+ * @param n_frames      Number of samples of each channel
+ */
+void IIRFilterProcess(iir_filter_t * filter, const float * input_signal, float * output_signal, uint16_t n_frames);
+
+/**
+ * @brief Apply a fixed point filter object (IIR_Q15) to a block of interleaved Q15 samples
+ * 
+ * Each section output is rounded and saturated to 16 bits.
+ * Input and output arrays can be the same array.
+ * 
+ * @param filter        Pointer to the filter object
+ * @param input_signal  Input samples: ch0[0], ch1[0], ... chN[0], ch0[1], ...
+ * @param output_signal Filtered samples (same layout as input_signal)
+ * @param n_frames      Number of samples of each channel
+ */
+void IIRFilterProcessQ15(iir_filter_t * filter, const int16_t * input_signal, int16_t * output_signal, uint16_t n_frames);
+
+/**
+ * @brief Filter one sample of one channel of a floating point filter object (IIR_FLOAT)
+ * 
+ * Runs the whole cascade (transposed direct form II) with a fixed number of operations.
+ * It is placed in IRAM and only uses the filter object, so it can be called from
+ * timer callbacks (ISRs). Different filter objects can be used from different tasks
+ * or ISRs at the same time, but one filter object must be used from only one of them.
+ * 
+ * @param filter        Pointer to the filter object
+ * @param channel       Channel of the sample (0 to n_channels - 1)
+ * @param input         Input sample
+ * @return float        Filtered sample (input is returned if the filter or the channel are not valid)
+ */
+float IIRFilterSample(iir_filter_t * filter, uint8_t channel, float input);
+
+/**
+ * @brief Filter one 16 bits sample of one channel of a filter object
+ * 
+ * IIR_Q15 filters use only integer arithmetic (direct form I). IIR_FLOAT filters run
+ * the floating point cascade, and the output is rounded and saturated to 16 bits.
+ * Same ISR and reentrancy conditions of IIRFilterSample apply.
+ * 
+ * @param filter        Pointer to the filter object
+ * @param channel       Channel of the sample (0 to n_channels - 1)
+ * @param input         Input sample
+ * @return int16_t      Filtered sample (input is returned if the channel is not valid)
+ */
+int16_t IIRFilterSampleInt16(iir_filter_t * filter, uint8_t channel, int16_t input);
+
+/**
+ * @brief Clear the delay lines of a filter object
+ * 
+ * @param filter        Pointer to the filter object
+ */
+void IIRFilterReset(iir_filter_t * filter);
+
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
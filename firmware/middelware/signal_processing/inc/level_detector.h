@@ -0,0 +1,439 @@
+#ifndef LEVEL_DETECTOR_H_
+#define LEVEL_DETECTOR_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup Level_Detector Level Detector
+ */
+
+/** \brief Streaming level detectors: RMS, envelope (peak hold) and crest factor
+ * 
+ * Every detector keeps a few values of state and does a fixed amount of work per
+ * sample, so any analog channel can be monitored continuously instead of buffered.
+ * Samples are processed one at a time (LevelXSample()) or by blocks (LevelXBlock()),
+ * with the same result. Square roots and divisions are only done when the level is
+ * read (LevelXGet()): block RMS detectors keep the sum of the last block and divide
+ * it by the block lenght there. The per sample cost is a few multiplications and, in
+ * the Q15 versions (16 bits samples), integer arithmetic only.
+ * 
+ * @author Peñalva Albano
+ * 
+ * @section changelog
+ * 
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 16/10/2026 | Document creation		                         						|
+ * | 17/10/2026 | Block RMS divides by the block lenght when the level is read			|
+ * 
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+
+/*==================[typedef]================================================*/
+/**
+ * @brief RMS detector (exponential or block average of the squared signal)
+ * 
+ * @note  All the fields are managed by the LevelRMS functions, the struct is
+ *        declared here only so the application can own its storage.
+ */
+typedef struct {
+    float alpha;                /*!< Exponential averaging coefficient (0 for block average) */
+    float mean_square;          /*!< Mean square value (sum of the squared samples of the last complete block in block mode) */
+    float sum;                  /*!< Sum of the squared samples of the current block */
+    uint16_t block_lenght;      /*!< Samples of each block (0 for exponential average) */
+    uint16_t count;             /*!< Samples of the current block */
+} level_rms_t;
+
+/**
+ * @brief 16 bits RMS detector (exponential or block average of the squared signal)
+ * 
+ * @note  All the fields are managed by the LevelRMS functions, the struct is
+ *        declared here only so the application can own its storage.
+ */
+typedef struct {
+    int32_t alpha;              /*!< Exponential averaging coefficient, Q15 (0 for block average) */
+    int64_t mean_square;        /*!< Mean square value, with 16 fractional bits (sum of the squared samples of the last complete block in block mode) */
+    uint64_t sum;               /*!< Sum of the squared samples of the current block */
+    uint16_t block_lenght;      /*!< Samples of each block (0 for exponential average) */
+    uint16_t count;             /*!< Samples of the current block */
+} level_rms_q15_t;
+
+/**
+ * @brief Envelope detector with attack, hold and release times
+ * 
+ * @note  All the fields are managed by the LevelEnvelope functions, the struct is
+ *        declared here only so the application can own its storage.
+ */
+typedef struct {
+    float attack;               /*!< Averaging coefficient while the signal is above the envelope */
+    float release;              /*!< Averaging coefficient while the signal is below the envelope */
+    float envelope;             /*!< Current envelope */
+    uint32_t hold;              /*!< Samples the envelope is held after each new peak */
+    uint32_t hold_count;        /*!< Samples left of the current hold */
+} level_envelope_t;
+
+/**
+ * @brief 16 bits envelope detector with attack, hold and release times
+ * 
+ * @note  All the fields are managed by the LevelEnvelope functions, the struct is
+ *        declared here only so the application can own its storage.
+ */
+typedef struct {
+    int32_t attack;             /*!< Averaging coefficient while the signal is above the envelope, Q15 */
+    int32_t release;            /*!< Averaging coefficient while the signal is below the envelope, Q15 */
+    int32_t envelope;           /*!< Current envelope, with 16 fractional bits */
+    uint32_t hold;              /*!< Samples the envelope is held after each new peak */
+    uint32_t hold_count;        /*!< Samples left of the current hold */
+} level_envelope_q15_t;
+
+/**
+ * @brief Crest factor (peak / RMS) detector over blocks of samples
+ * 
+ * @note  All the fields are managed by the LevelCrest functions, the struct is
+ *        declared here only so the application can own its storage.
+ */
+typedef struct {
+    level_rms_t rms;            /*!< Block RMS detector */
+    float peak;                 /*!< Peak magnitude of the current block */
+    float block_peak;           /*!< Peak magnitude of the last complete block */
+} level_crest_t;
+
+/**
+ * @brief 16 bits crest factor (peak / RMS) detector over blocks of samples
+ * 
+ * @note  All the fields are managed by the LevelCrest functions, the struct is
+ *        declared here only so the application can own its storage.
+ */
+typedef struct {
+    level_rms_q15_t rms;        /*!< Block RMS detector */
+    uint16_t peak;              /*!< Peak magnitude of the current block */
+    uint16_t block_peak;        /*!< Peak magnitude of the last complete block */
+} level_crest_q15_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Initialize a RMS detector averaged over blocks of samples
+ * 
+ * The RMS value is updated each time a block is complete.
+ * 
+ * @param rms           Pointer to the detector
+ * @param block_lenght  Samples of each block
+ * @return true         Detector initialized
+ * @return false        Invalid parameters
+ */
+bool LevelRMSInit(level_rms_t * rms, uint16_t block_lenght);
+
+/**
+ * @brief Initialize a RMS detector with exponential averaging
+ * 
+ * The mean square value follows the squared signal with a first order low pass
+ * of time constant time_ms (a step settles to 1% in 4.6 time constants).
+ * 
+ * @param rms           Pointer to the detector
+ * @param sample_freq   Sample frequency, in Hz
+ * @param time_ms       Time constant, in ms (greater than 0)
+ * @return true         Detector initialized
+ * @return false        Invalid parameters
+ */
+bool LevelRMSInitExp(level_rms_t * rms, float sample_freq, float time_ms);
+
+/**
+ * @brief Process a sample with a RMS detector
+ * 
+ * @param rms           Pointer to the detector
+ * @param sample        New sample
+ * @return true         New RMS value (always with exponential averaging, when a block completes otherwise)
+ * @return false        No new RMS value
+ */
+bool LevelRMSSample(level_rms_t * rms, float sample);
+
+/**
+ * @brief Process a block of samples with a RMS detector
+ * 
+ * Blocks can be of any lenght, independent of the averaging block lenght.
+ * 
+ * @param rms           Pointer to the detector
+ * @param signal        Samples
+ * @param signal_lenght Number of samples
+ * @return true         New RMS value
+ * @return false        No new RMS value
+ */
+bool LevelRMSBlock(level_rms_t * rms, const float * signal, uint16_t signal_lenght);
+
+/**
+ * @brief Read the RMS value
+ * 
+ * @param rms           Pointer to the detector
+ * @return float        RMS value (of the last complete block in block mode)
+ */
+float LevelRMSGet(const level_rms_t * rms);
+
+/**
+ * @brief Clear the state of a RMS detector
+ * 
+ * @param rms           Pointer to the detector
+ */
+void LevelRMSReset(level_rms_t * rms);
+
+/**
+ * @brief Initialize a 16 bits RMS detector averaged over blocks of samples
+ * 
+ * @param rms           Pointer to the detector
+ * @param block_lenght  Samples of each block
+ * @return true         Detector initialized
+ * @return false        Invalid parameters
+ */
+bool LevelRMSInitQ15(level_rms_q15_t * rms, uint16_t block_lenght);
+
+/**
+ * @brief Initialize a 16 bits RMS detector with exponential averaging
+ * 
+ * Same as LevelRMSInitExp(), the coefficient is rounded to Q15 (time constants up
+ * to ~30000 samples).
+ * 
+ * @param rms           Pointer to the detector
+ * @param sample_freq   Sample frequency, in Hz
+ * @param time_ms       Time constant, in ms
+ * @return true         Detector initialized
+ * @return false        Invalid parameters
+ */
+bool LevelRMSInitExpQ15(level_rms_q15_t * rms, float sample_freq, float time_ms);
+
+/**
+ * @brief Process a sample with a 16 bits RMS detector
+ * 
+ * @param rms           Pointer to the detector
+ * @param sample        New sample
+ * @return true         New RMS value
+ * @return false        No new RMS value
+ */
+bool LevelRMSSampleQ15(level_rms_q15_t * rms, int16_t sample);
+
+/**
+ * @brief Process a block of samples with a 16 bits RMS detector
+ * 
+ * @param rms           Pointer to the detector
+ * @param signal        Samples
+ * @param signal_lenght Number of samples
+ * @return true         New RMS value
+ * @return false        No new RMS value
+ */
+bool LevelRMSBlockQ15(level_rms_q15_t * rms, const int16_t * signal, uint16_t signal_lenght);
+
+/**
+ * @brief Read the RMS value of a 16 bits RMS detector
+ * 
+ * @param rms           Pointer to the detector
+ * @return uint16_t     RMS value (rounded integer square root)
+ */
+uint16_t LevelRMSGetQ15(const level_rms_q15_t * rms);
+
+/**
+ * @brief Clear the state of a 16 bits RMS detector
+ * 
+ * @param rms           Pointer to the detector
+ */
+void LevelRMSResetQ15(level_rms_q15_t * rms);
+
+/**
+ * @brief Initialize an envelope detector
+ * 
+ * The envelope rises towards the signal magnitude with time constant attack_ms,
+ * stays for hold_ms after the last peak, and then falls with time constant release_ms.
+ * A peak hold with decay is attack_ms = 0 (the envelope is the highest magnitude).
+ * 
+ * @param env           Pointer to the detector
+ * @param sample_freq   Sample frequency, in Hz
+ * @param attack_ms     Attack time constant, in ms (0 for instantaneous)
+ * @param hold_ms       Hold time, in ms
+ * @param release_ms    Release time constant, in ms (0 for instantaneous)
+ * @return true         Detector initialized
+ * @return false        Invalid parameters
+ */
+bool LevelEnvelopeInit(level_envelope_t * env, float sample_freq, float attack_ms, float hold_ms, float release_ms);
+
+/**
+ * @brief Process a sample with an envelope detector
+ * 
+ * @param env           Pointer to the detector
+ * @param sample        New sample
+ */
+void LevelEnvelopeSample(level_envelope_t * env, float sample);
+
+/**
+ * @brief Process a block of samples with an envelope detector
+ * 
+ * @param env           Pointer to the detector
+ * @param signal        Samples
+ * @param signal_lenght Number of samples
+ */
+void LevelEnvelopeBlock(level_envelope_t * env, const float * signal, uint16_t signal_lenght);
+
+/**
+ * @brief Read the envelope
+ * 
+ * @param env           Pointer to the detector
+ * @return float        Current envelope
+ */
+float LevelEnvelopeGet(const level_envelope_t * env);
+
+/**
+ * @brief Clear the state of an envelope detector
+ * 
+ * @param env           Pointer to the detector
+ */
+void LevelEnvelopeReset(level_envelope_t * env);
+
+/**
+ * @brief Initialize a 16 bits envelope detector
+ * 
+ * Same as LevelEnvelopeInit(), the coefficients are rounded to Q15.
+ * 
+ * @param env           Pointer to the detector
+ * @param sample_freq   Sample frequency, in Hz
+ * @param attack_ms     Attack time constant, in ms (0 for instantaneous)
+ * @param hold_ms       Hold time, in ms
+ * @param release_ms    Release time constant, in ms (0 for instantaneous)
+ * @return true         Detector initialized
+ * @return false        Invalid parameters
+ */
+bool LevelEnvelopeInitQ15(level_envelope_q15_t * env, float sample_freq, float attack_ms, float hold_ms, float release_ms);
+
+/**
+ * @brief Process a sample with a 16 bits envelope detector
+ * 
+ * @param env           Pointer to the detector
+ * @param sample        New sample
+ */
+void LevelEnvelopeSampleQ15(level_envelope_q15_t * env, int16_t sample);
+
+/**
+ * @brief Process a block of samples with a 16 bits envelope detector
+ * 
+ * @param env           Pointer to the detector
+ * @param signal        Samples
+ * @param signal_lenght Number of samples
+ */
+void LevelEnvelopeBlockQ15(level_envelope_q15_t * env, const int16_t * signal, uint16_t signal_lenght);
+
+/**
+ * @brief Read the envelope of a 16 bits envelope detector
+ * 
+ * @param env           Pointer to the detector
+ * @return uint16_t     Current envelope (rounded)
+ */
+uint16_t LevelEnvelopeGetQ15(const level_envelope_q15_t * env);
+
+/**
+ * @brief Clear the state of a 16 bits envelope detector
+ * 
+ * @param env           Pointer to the detector
+ */
+void LevelEnvelopeResetQ15(level_envelope_q15_t * env);
+
+/**
+ * @brief Initialize a crest factor detector
+ * 
+ * The crest factor (peak magnitude / RMS value) is measured over each block of
+ * block_lenght samples, including any DC level of the signal.
+ * 
+ * @param crest         Pointer to the detector
+ * @param block_lenght  Samples of each block
+ * @return true         Detector initialized
+ * @return false        Invalid parameters
+ */
+bool LevelCrestInit(level_crest_t * crest, uint16_t block_lenght);
+
+/**
+ * @brief Process a sample with a crest factor detector
+ * 
+ * @param crest         Pointer to the detector
+ * @param sample        New sample
+ * @return true         A block is complete (new crest factor)
+ * @return false        No new crest factor
+ */
+bool LevelCrestSample(level_crest_t * crest, float sample);
+
+/**
+ * @brief Process a block of samples with a crest factor detector
+ * 
+ * @param crest         Pointer to the detector
+ * @param signal        Samples
+ * @param signal_lenght Number of samples
+ * @return true         At least one block is complete (new crest factor)
+ * @return false        No new crest factor
+ */
+bool LevelCrestBlock(level_crest_t * crest, const float * signal, uint16_t signal_lenght);
+
+/**
+ * @brief Read the crest factor
+ * 
+ * @param crest         Pointer to the detector
+ * @return float        Crest factor of the last complete block (0 if its RMS value is 0)
+ */
+float LevelCrestGet(const level_crest_t * crest);
+
+/**
+ * @brief Clear the state of a crest factor detector
+ * 
+ * @param crest         Pointer to the detector
+ */
+void LevelCrestReset(level_crest_t * crest);
+
+/**
+ * @brief Initialize a 16 bits crest factor detector
+ * 
+ * @param crest         Pointer to the detector
+ * @param block_lenght  Samples of each block
+ * @return true         Detector initialized
+ * @return false        Invalid parameters
+ */
+bool LevelCrestInitQ15(level_crest_q15_t * crest, uint16_t block_lenght);
+
+/**
+ * @brief Process a sample with a 16 bits crest factor detector
+ * 
+ * @param crest         Pointer to the detector
+ * @param sample        New sample
+ * @return true         A block is complete (new crest factor)
+ * @return false        No new crest factor
+ */
+bool LevelCrestSampleQ15(level_crest_q15_t * crest, int16_t sample);
+
+/**
+ * @brief Process a block of samples with a 16 bits crest factor detector
+ * 
+ * @param crest         Pointer to the detector
+ * @param signal        Samples
+ * @param signal_lenght Number of samples
+ * @return true         At least one block is complete (new crest factor)
+ * @return false        No new crest factor
+ */
+bool LevelCrestBlockQ15(level_crest_q15_t * crest, const int16_t * signal, uint16_t signal_lenght);
+
+/**
+ * @brief Read the crest factor of a 16 bits crest factor detector
+ * 
+ * @param crest         Pointer to the detector
+ * @return float        Crest factor of the last complete block (0 if its RMS value is 0)
+ */
+float LevelCrestGetQ15(const level_crest_q15_t * crest);
+
+/**
+ * @brief Clear the state of a 16 bits crest factor detector
+ * 
+ * @param crest         Pointer to the detector
+ */
+void LevelCrestResetQ15(level_crest_q15_t * crest);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* LEVEL_DETECTOR_H_ */
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,221 @@
+#ifndef NLMS_FILTER_H_
+#define NLMS_FILTER_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup NLMS_Filter NLMS Filter
+ */
+
+/** \brief Adaptive noise canceller (normalized LMS filter)
+ * 
+ * The filter estimates the interference in the input signal from a reference that
+ * is correlated with it (e.g. the mains voltage, or a synthesized mains sine), and
+ * returns the input minus that estimate. Weights follow the NLMS rule, so the
+ * canceller tracks changes of the interference amplitude, phase and frequency
+ * instead of rejecting a fixed band like a notch filter.
+ * 
+ * The reference samples are kept in a circular buffer written twice (at pos and
+ * pos + lenght), so the last lenght samples are always contiguous and the filter
+ * output is a single dsps_dotprod_f32() / dsps_dotprod_s16() call, without moving
+ * samples. As in dsps_fir.h, the first weight multiplies the oldest sample. Each
+ * sample takes a fixed amount of work: the dot product, one division and the
+ * update of the weights. The float energy of the reference is a running sum,
+ * recalculated from the delay line once every lenght samples so rounding errors
+ * don't build up.
+ * 
+ * @author Peñalva Albano
+ * 
+ * @section changelog
+ * 
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 16/10/2026 | Document creation		                         						|
+ * 
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+#define NLMS_MAX_HARMONICS          8       /*!< Maximum harmonics of the synthesized mains reference */
+#define NLMS_DELAY_LENGHT(lenght)   (2 * (lenght))      /*!< Delay line values for a filter of lenght weights */
+#define NLMS_MAINS_LENGHT(harmonics) (2 * (harmonics))  /*!< Weights (and delay line values) of a mains canceller */
+/*==================[typedef]================================================*/
+/**
+ * @brief NLMS filter
+ * 
+ * @note  All the fields are managed by the NLMSFilter functions, the struct is
+ *        declared here only so the application can own its storage.
+ */
+typedef struct {
+    float * weights;            /*!< Filter weights (lenght values) */
+    float * delay;              /*!< Reference samples (NLMS_DELAY_LENGHT(lenght) values) or synthesized reference */
+    float mu;                   /*!< Step size */
+    float power;                /*!< Energy of the reference samples in the filter */
+    float epsilon;              /*!< Regularization of the step normalization */
+    uint32_t phase;             /*!< Phase of the synthesized reference (2^32 = one period) */
+    uint32_t phase_step;        /*!< Phase increment per sample */
+    uint16_t lenght;            /*!< Number of weights */
+    uint16_t pos;               /*!< Position of the oldest reference sample */
+    uint8_t harmonics;          /*!< Harmonics of the synthesized reference (0 for an external reference) */
+} nlms_filter_t;
+
+/**
+ * @brief 16 bits NLMS filter
+ * 
+ * @note  All the fields are managed by the NLMSFilter functions, the struct is
+ *        declared here only so the application can own its storage.
+ */
+typedef struct {
+    int16_t * weights;          /*!< Filter weights, Q15 (used by dsps_dotprod_s16()) */
+    int32_t * weights_acc;      /*!< Filter weights, Q31 (updated every sample) */
+    int16_t * delay;            /*!< Reference samples (NLMS_DELAY_LENGHT(lenght) values) or synthesized reference */
+    int32_t mu;                 /*!< Step size, Q15 */
+    int64_t power;              /*!< Energy of the reference samples in the filter */
+    int64_t epsilon;            /*!< Regularization of the step normalization */
+    uint32_t phase;             /*!< Phase of the synthesized reference (2^32 = one period) */
+    uint32_t phase_step;        /*!< Phase increment per sample */
+    uint16_t lenght;            /*!< Number of weights */
+    uint16_t pos;               /*!< Position of the oldest reference sample */
+    uint8_t harmonics;          /*!< Harmonics of the synthesized reference (0 for an external reference) */
+} nlms_filter_q15_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Initialize a NLMS filter with an external reference
+ * 
+ * The step size sets the speed of adaptation against the excess noise: the filter
+ * is stable for 0 < mu < 2, and mu ~0.01 to 0.1 is a usual choice.
+ * 
+ * @param filter        Pointer to the filter
+ * @param weights       Array for the weights (of lenght = lenght)
+ * @param delay         Array for the delay line (of lenght = NLMS_DELAY_LENGHT(lenght))
+ * @param lenght        Number of weights
+ * @param mu            Step size (0 to 2)
+ * @return true         Filter initialized
+ * @return false        Invalid parameters
+ */
+bool NLMSFilterInit(nlms_filter_t * filter, float * weights, float * delay, uint16_t lenght, float mu);
+
+/**
+ * @brief Initialize a NLMS mains canceller with a synthesized reference
+ * 
+ * The reference is a sine and a cosine of unit amplitude at the mains frequency
+ * and at each of its harmonics, so two weights per harmonic are enough to cancel
+ * any amplitude and phase. Deviations of the actual mains frequency are tracked
+ * by the adaptation: a larger mu tracks larger deviations, at the cost of more
+ * distortion of the signal (at 1 kHz, mu = 0.04 keeps about 20 dB of rejection
+ * with a 0.05 Hz deviation).
+ * 
+ * @param filter        Pointer to the filter
+ * @param weights       Array for the weights (of lenght = NLMS_MAINS_LENGHT(harmonics))
+ * @param delay         Array for the reference (of lenght = NLMS_MAINS_LENGHT(harmonics))
+ * @param sample_freq   Sample frequency, in Hz
+ * @param mains_frec    Mains frequency (MAINS_50HZ, MAINS_60HZ), in Hz
+ * @param harmonics     Number of harmonics to cancel (1 to NLMS_MAX_HARMONICS, all below sample_freq / 2)
+ * @param mu            Step size (0 to 2)
+ * @return true         Filter initialized
+ * @return false        Invalid parameters
+ */
+bool NLMSFilterInitMains(nlms_filter_t * filter, float * weights, float * delay, float sample_freq, float mains_frec, uint8_t harmonics, float mu);
+
+/**
+ * @brief Filter a sample
+ * 
+ * @param filter        Pointer to the filter
+ * @param input         Input sample (signal plus interference)
+ * @param reference     Reference sample (ignored by mains cancellers)
+ * @return float        Input without the estimated interference
+ */
+float NLMSFilterSample(nlms_filter_t * filter, float input, float reference);
+
+/**
+ * @brief Filter a block of samples
+ * 
+ * @param filter        Pointer to the filter
+ * @param input         Input samples (signal plus interference)
+ * @param reference     Reference samples (NULL for mains cancellers)
+ * @param output        Input without the estimated interference (can be the input array)
+ * @param signal_lenght Number of samples
+ */
+void NLMSFilterBlock(nlms_filter_t * filter, const float * input, const float * reference, float * output, uint16_t signal_lenght);
+
+/**
+ * @brief Clear the weights and the delay line of a NLMS filter
+ * 
+ * @param filter        Pointer to the filter
+ */
+void NLMSFilterReset(nlms_filter_t * filter);
+
+/**
+ * @brief Initialize a 16 bits NLMS filter with an external reference
+ * 
+ * Weights are used in Q15 (-1 to 1), so the reference must be at least as large
+ * as the interference it cancels, and the interference estimate must fit in 16 bits.
+ * 
+ * @param filter        Pointer to the filter
+ * @param weights       Array for the Q15 weights (of lenght = lenght)
+ * @param weights_acc   Array for the Q31 weights (of lenght = lenght)
+ * @param delay         Array for the delay line (of lenght = NLMS_DELAY_LENGHT(lenght))
+ * @param lenght        Number of weights
+ * @param mu            Step size (0 to 2)
+ * @return true         Filter initialized
+ * @return false        Invalid parameters
+ */
+bool NLMSFilterInitQ15(nlms_filter_q15_t * filter, int16_t * weights, int32_t * weights_acc, int16_t * delay, uint16_t lenght, float mu);
+
+/**
+ * @brief Initialize a 16 bits NLMS mains canceller with a synthesized reference
+ * 
+ * Same as NLMSFilterInitMains(), the reference sines are of full scale amplitude.
+ * 
+ * @param filter        Pointer to the filter
+ * @param weights       Array for the Q15 weights (of lenght = NLMS_MAINS_LENGHT(harmonics))
+ * @param weights_acc   Array for the Q31 weights (of lenght = NLMS_MAINS_LENGHT(harmonics))
+ * @param delay         Array for the reference (of lenght = NLMS_MAINS_LENGHT(harmonics))
+ * @param sample_freq   Sample frequency, in Hz
+ * @param mains_frec    Mains frequency (MAINS_50HZ, MAINS_60HZ), in Hz
+ * @param harmonics     Number of harmonics to cancel (1 to NLMS_MAX_HARMONICS, all below sample_freq / 2)
+ * @param mu            Step size (0 to 2)
+ * @return true         Filter initialized
+ * @return false        Invalid parameters
+ */
+bool NLMSFilterInitMainsQ15(nlms_filter_q15_t * filter, int16_t * weights, int32_t * weights_acc, int16_t * delay,
+                            float sample_freq, float mains_frec, uint8_t harmonics, float mu);
+
+/**
+ * @brief Filter a 16 bits sample
+ * 
+ * @param filter        Pointer to the filter
+ * @param input         Input sample (signal plus interference)
+ * @param reference     Reference sample (ignored by mains cancellers)
+ * @return int16_t      Input without the estimated interference (saturated)
+ */
+int16_t NLMSFilterSampleQ15(nlms_filter_q15_t * filter, int16_t input, int16_t reference);
+
+/**
+ * @brief Filter a block of 16 bits samples
+ * 
+ * @param filter        Pointer to the filter
+ * @param input         Input samples (signal plus interference)
+ * @param reference     Reference samples (NULL for mains cancellers)
+ * @param output        Input without the estimated interference (can be the input array)
+ * @param signal_lenght Number of samples
+ */
+void NLMSFilterBlockQ15(nlms_filter_q15_t * filter, const int16_t * input, const int16_t * reference, int16_t * output, uint16_t signal_lenght);
+
+/**
+ * @brief Clear the weights and the delay line of a 16 bits NLMS filter
+ * 
+ * @param filter        Pointer to the filter
+ */
+void NLMSFilterResetQ15(nlms_filter_q15_t * filter);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* NLMS_FILTER_H_ */
+
+/*==================[end of file]============================================*/
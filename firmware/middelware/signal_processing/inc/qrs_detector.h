@@ -0,0 +1,137 @@
+#ifndef QRS_DETECTOR_H_
+#define QRS_DETECTOR_H_
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Middelware Middelware
+ ** @{ */
+/** \addtogroup QRS_Detector QRS Detector
+ */
+
+/** \brief Streaming QRS (heart beat) detector for ECG signals
+ * 
+ * Pan-Tompkins detector: band pass filter (5 to 15 Hz, Q15 IIR filter object),
+ * derivative, squaring, moving window integration (150 ms) and adaptive thresholds
+ * with search back for missed beats and T wave discrimination. Samples are processed
+ * one by one with integer arithmetic only and a fixed number of operations.
+ * 
+ * @author Peñalva Albano
+ * 
+ * @section changelog
+ * 
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 16/10/2026 | Document creation		                         						|
+ * 
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "iir_filter.h"
+/*==================[macros]=================================================*/
+#define QRS_MIN_SAMPLE_FREQ 250     /*!< Lowest sample frequency accepted by QRSDetectorInit() */
+#define QRS_MAX_SAMPLE_FREQ 1000    /*!< Highest sample frequency accepted by QRSDetectorInit() */
+#define QRS_SECTIONS        IIR_BAND_PASS_SECTIONS(ORDER_2, ORDER_2, true)  /*!< Band pass (and notch) sections */
+#define QRS_DERIV_LENGHT    (4 * (QRS_MAX_SAMPLE_FREQ / 200) + 1)   /*!< Band pass samples used by the derivative */
+#define QRS_WINDOW_LENGHT   (QRS_MAX_SAMPLE_FREQ * 150 / 1000)      /*!< Moving window integration (150 ms) */
+#define QRS_RR_AVERAGE      8       /*!< Number of RR intervals averaged for the search back */
+/*==================[typedef]================================================*/
+/**
+ * @brief Detected heart beat
+ */
+typedef struct {
+    uint32_t r_peak;            /*!< Sample of the R peak (counted from QRSDetectorInit() or QRSDetectorReset()), delayed up to ~35 ms by the band pass */
+    uint32_t rr;                /*!< Samples from the previous R peak (0 for the first beat) */
+    uint16_t heart_rate;        /*!< Instantaneous heart rate (60 / RR), in beats per minute (0 for the first beat) */
+} qrs_beat_t;
+
+/**
+ * @brief QRS detector state
+ * 
+ * @note  All the fields are managed by the QRSDetector functions, the struct is
+ *        declared here only so the application can own its storage.
+ */
+typedef struct {
+    iir_filter_t band_pass;                             /*!< Band pass filter (and mains notch) */
+    float coeffs[IIR_COEFFS_LENGHT(QRS_SECTIONS)];      /*!< Floating point design of the filter */
+    int32_t coeffs_q[IIR_COEFFS_LENGHT(QRS_SECTIONS)];  /*!< Q30 coefficients of the filter */
+    int16_t delay_q15[IIR_DELAY_Q15_LENGHT(QRS_SECTIONS, 1)];   /*!< Delay lines of the filter */
+    int16_t filtered[QRS_DERIV_LENGHT];                 /*!< Last band pass samples (circular) */
+    uint32_t squared[QRS_WINDOW_LENGHT];                /*!< Last squared derivative samples (circular) */
+    uint32_t integral;                                  /*!< Sum of the squared samples of the window */
+    uint32_t rr[QRS_RR_AVERAGE];                        /*!< Last RR intervals (circular) */
+    uint32_t rr_sum;                                    /*!< Sum of the last RR intervals */
+    uint64_t learn_sum;                                 /*!< Sum of the integrated signal during the learning phase */
+    uint32_t learn_max;                                 /*!< Maximum of the integrated signal during the learning phase */
+    uint32_t n;                                         /*!< Number of processed samples */
+    uint32_t learn_end;                                 /*!< Sample where the learning phase ends */
+    int32_t spki;                                       /*!< Running estimate of the QRS peaks */
+    int32_t npki;                                       /*!< Running estimate of the noise peaks */
+    int32_t threshold;                                  /*!< Detection threshold (the search back uses half of it) */
+    uint32_t candidate;                                 /*!< Highest integrated value of the current peak */
+    uint32_t candidate_r;                               /*!< Sample of the highest band pass value of the current peak */
+    uint16_t candidate_r_value;                         /*!< Highest band pass magnitude of the current peak */
+    uint16_t candidate_slope;                           /*!< Highest derivative magnitude of the current peak */
+    uint32_t noise;                                     /*!< Highest noise peak above half the threshold since the last beat */
+    uint32_t noise_r;                                   /*!< Sample of the R peak of that noise peak */
+    uint16_t noise_slope;                               /*!< Highest derivative magnitude of that noise peak */
+    uint16_t last_slope;                                /*!< Highest derivative magnitude of the last QRS */
+    uint32_t last_r;                                    /*!< Sample of the last R peak */
+    int16_t offset;                                     /*!< First sample, removed so the filter does not start with a step */
+    uint16_t sample_freq;                               /*!< Sample frequency, in Hz */
+    uint16_t deriv_step;                                /*!< Samples between the derivative taps (5 ms at 200 Hz) */
+    uint16_t window;                                    /*!< Samples of the moving window integration */
+    uint16_t refractory;                                /*!< Minimum samples between R peaks (200 ms) */
+    uint16_t t_wave;                                    /*!< Samples after an R peak where a T wave is checked for (360 ms) */
+    uint8_t filtered_index;                             /*!< Position of the next band pass sample */
+    uint8_t squared_index;                              /*!< Position of the next squared sample */
+    uint8_t rr_index;                                   /*!< Position of the next RR interval */
+    uint8_t rr_count;                                   /*!< Number of RR intervals stored */
+    bool beat_found;                                    /*!< At least one beat was detected */
+} qrs_detector_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Initialize a QRS detector
+ * 
+ * The first 2 s of signal are used to learn the thresholds (beats in them are
+ * not reported). If no beat is found for 3 s, thresholds are learned again.
+ * 
+ * @param det           Pointer to the detector
+ * @param sample_freq   Sample frequency, in Hz (QRS_MIN_SAMPLE_FREQ to QRS_MAX_SAMPLE_FREQ)
+ * @param notch_frec    Mains frequency to reject (MAINS_50HZ, MAINS_60HZ), 0 for no notch
+ * @return true         Detector initialized
+ * @return false        Invalid parameters
+ */
+bool QRSDetectorInit(qrs_detector_t * det, uint16_t sample_freq, float notch_frec);
+
+/**
+ * @brief Process a new ECG sample
+ * 
+ * Beats are confirmed once the integrated signal has fallen after the QRS (about
+ * 150 to 300 ms after the R peak), or later by the search back when the next beat
+ * takes too long. Any DC level is accepted (e.g. AnalogInputReadSingle() values, in
+ * mV); the QRS amplitude should be at least ~100 units.
+ * 
+ * @param det           Pointer to the detector
+ * @param sample        New ECG sample
+ * @param beat          Pointer to store the detected beat (can be NULL)
+ * @return true         A beat was detected
+ * @return false        No new beat
+ */
+bool QRSDetectorProcess(qrs_detector_t * det, int16_t sample, qrs_beat_t * beat);
+
+/**
+ * @brief Clear the state of a QRS detector and start learning the thresholds again
+ * 
+ * @param det           Pointer to the detector
+ */
+void QRSDetectorReset(qrs_detector_t * det);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* QRS_DETECTOR_H_ */
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,360 @@
+/**
+ * @file decimator.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2023
+ * 
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "decimator.h"
+#include "esp_dsp.h"
+/*==================[macros and definitions]=================================*/
+#define FIR_CUT_FREC        0.5f    /*!< FIR cut-off frequency (-6 dB), relative to the output sample frequency */
+#define HALF_BAND_CUT_FREC  0.25f   /*!< Half band filters cut-off frequency, relative to their input sample frequency */
+#define DESIGN_STEPS        64      /*!< Integration steps of the compensated FIR design */
+#define COEFFS_Q14_ONE      (1 << 14)
+#define FIR_Q14_SHIFT       1       /*!< dsps_fird_s16() shift for Q14 coefficients */
+#define HALF_BAND_CENTER    ((DECIMATOR_HALF_BAND_TAPS - 1) / 2)    /*!< Center tap of the half band filters */
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+/**
+ * @brief Calculate one tap of a Blackman windowed low pass FIR filter
+ * 
+ * The ideal response is 1 up to cut_frec, divided by the CIC response if cic_decim > 1.
+ * 
+ * @param tap           Tap number (0 to n_taps - 1)
+ * @param n_taps        Number of taps of the filter
+ * @param cut_frec      Cut-off frequency, relative to the filter input sample frequency
+ * @param cic_decim     Decimation of the CIC filter to compensate (1 for no compensation)
+ * @return float        Tap value (not normalized)
+ */
+static float DecimatorTap(uint16_t tap, uint16_t n_taps, float cut_frec, uint8_t cic_decim);
+
+/**
+ * @brief Design a low pass FIR filter with unity DC gain
+ * 
+ * @param coeffs        Array for the coefficients
+ * @param n_taps        Number of taps of the filter
+ * @param cut_frec      Cut-off frequency, relative to the filter input sample frequency
+ */
+static void DecimatorDesign(float * coeffs, uint16_t n_taps, float cut_frec);
+
+/**
+ * @brief Half band filter decimating by 2 (same interface as dsps_fird_f32())
+ * 
+ * Every other tap of a half band filter is 0, except the center one: only the
+ * non zero taps are used, and as the filter is symmetric the two samples that
+ * share a tap are added before the product. Each output takes HALF_BAND_CENTER / 2 + 1
+ * products instead of DECIMATOR_HALF_BAND_TAPS. The delay line is written twice
+ * (at pos and pos + N), so the last N samples are always contiguous.
+ * 
+ * Input and output arrays can be the same array.
+ * 
+ * @param fir           Half band filter (coefficients, delay line of 2 * N values and position)
+ * @param input         Input samples (2 * len values)
+ * @param output        Decimated samples
+ * @param len           Number of decimated samples
+ * @return int          Number of decimated samples
+ */
+static int DecimatorHalfBand(fir_f32_t * fir, const float * input, float * output, int len);
+
+/**
+ * @brief Run one decimating FIR stage over a block of any lenght
+ * 
+ * Input and output arrays can be the same array.
+ * 
+ * @param fir           FIR filter (initialized with dsps_fird_init_f32())
+ * @param kernel        dsps_fird_f32() or DecimatorHalfBand()
+ * @param pending       Samples of an incomplete decimation period (fir->decim values)
+ * @param n_pending     Number of pending samples
+ * @param input         Input samples
+ * @param lenght        Number of input samples
+ * @param output        Decimated samples
+ * @return uint16_t     Number of decimated samples
+ */
+static uint16_t DecimatorStage(fir_f32_t * fir, int (*kernel)(fir_f32_t *, const float *, float *, int),
+                               float * pending, uint8_t * n_pending, const float * input, uint16_t lenght, float * output);
+
+/**
+ * @brief Run one decimating 16 bits FIR stage over a block of any lenght
+ * 
+ * Input and output arrays can be the same array.
+ * 
+ * @param fir           FIR filter (initialized with dsps_fird_init_s16())
+ * @param pending       Samples of an incomplete decimation period (fir->decim values)
+ * @param n_pending     Number of pending samples
+ * @param input         Input samples
+ * @param lenght        Number of input samples
+ * @param output        Decimated samples
+ * @return uint16_t     Number of decimated samples
+ */
+static uint16_t DecimatorStageQ15(fir_s16_t * fir, int16_t * pending, uint8_t * n_pending, const int16_t * input, uint16_t lenght, int16_t * output);
+/*==================[internal data definition]===============================*/
+static float half_band_coeffs[DECIMATOR_HALF_BAND_TAPS];
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+static float DecimatorTap(uint16_t tap, uint16_t n_taps, float cut_frec, uint8_t cic_decim){
+    float m = tap - (n_taps - 1) / 2.0f;
+    float window = 0.42f - 0.5f * cosf(2 * M_PI * tap / (n_taps - 1)) + 0.08f * cosf(4 * M_PI * tap / (n_taps - 1));
+    float ideal = 0;
+    if (cic_decim <= 1){
+        // Ideal low pass: sin(2 pi fc m) / (pi m)
+        ideal = (m == 0) ? 2 * cut_frec : sinf(2 * M_PI * cut_frec * m) / (M_PI * m);
+    }
+    else{
+        // Inverse transform of the CIC compensation response: 2 * integral(H(f) cos(2 pi f m)) from 0 to fc
+        float df = cut_frec / DESIGN_STEPS;
+        for (uint16_t i = 0; i < DESIGN_STEPS; i++){
+            float f = (i + 0.5f) * df;
+            float cic = sinf(M_PI * f) / (cic_decim * sinf(M_PI * f / cic_decim));
+            ideal += 2 * df * cosf(2 * M_PI * f * m) / powf(cic, DECIMATOR_CIC_ORDER);
+        }
+    }
+    return window * ideal;
+}
+
+static void DecimatorDesign(float * coeffs, uint16_t n_taps, float cut_frec){
+    float sum = 0;
+    for (uint16_t i = 0; i < n_taps; i++){
+        coeffs[i] = DecimatorTap(i, n_taps, cut_frec, 1);
+        sum += coeffs[i];
+    }
+    for (uint16_t i = 0; i < n_taps; i++){
+        coeffs[i] /= sum;
+    }
+}
+
+static int DecimatorHalfBand(fir_f32_t * fir, const float * input, float * output, int len){
+    const float * c = fir->coeffs;
+    for (int i = 0; i < len; i++){
+        for (uint8_t k = 0; k < 2; k++){
+            fir->delay[fir->pos] = *input;
+            fir->delay[fir->pos + fir->N] = *input++;
+            if (++fir->pos == fir->N){
+                fir->pos = 0;
+            }
+        }
+        const float * x = &fir->delay[fir->pos];
+        float acc = c[HALF_BAND_CENTER] * x[HALF_BAND_CENTER];
+        for (uint8_t t = 0; t < HALF_BAND_CENTER; t += 2){
+            acc += c[t] * (x[t] + x[fir->N - 1 - t]);
+        }
+        output[i] = acc;
+    }
+    return len;
+}
+
+static uint16_t DecimatorStage(fir_f32_t * fir, int (*kernel)(fir_f32_t *, const float *, float *, int),
+                               float * pending, uint8_t * n_pending, const float * input, uint16_t lenght, float * output){
+    uint16_t n_out = 0;
+    // Complete the decimation period started in a previous block
+    if (*n_pending > 0){
+        while ((*n_pending < fir->decim) && (lenght > 0)){
+            pending[(*n_pending)++] = *input++;
+            lenght--;
+        }
+        if (*n_pending < fir->decim){
+            return 0;
+        }
+        n_out = kernel(fir, pending, output, 1);
+        *n_pending = 0;
+    }
+    uint16_t periods = lenght / fir->decim;
+    n_out += kernel(fir, input, &output[n_out], periods);
+    input += periods * fir->decim;
+    lenght -= periods * fir->decim;
+    while (lenght-- > 0){
+        pending[(*n_pending)++] = *input++;
+    }
+    return n_out;
+}
+
+static uint16_t DecimatorStageQ15(fir_s16_t * fir, int16_t * pending, uint8_t * n_pending, const int16_t * input, uint16_t lenght, int16_t * output){
+    uint16_t n_out = 0;
+    // Complete the decimation period started in a previous block
+    if (*n_pending > 0){
+        while ((*n_pending < fir->decim) && (lenght > 0)){
+            pending[(*n_pending)++] = *input++;
+            lenght--;
+        }
+        if (*n_pending < fir->decim){
+            return 0;
+        }
+        n_out = dsps_fird_s16(fir, pending, output, 1);
+        *n_pending = 0;
+    }
+    uint16_t periods = lenght / fir->decim;
+    n_out += dsps_fird_s16(fir, input, &output[n_out], periods);
+    input += periods * fir->decim;
+    lenght -= periods * fir->decim;
+    while (lenght-- > 0){
+        pending[(*n_pending)++] = *input++;
+    }
+    return n_out;
+}
+
+/*==================[external functions definition]==========================*/
+
+bool DecimatorInit(decimator_t * dec, uint8_t first_decim, uint8_t fir_decim, float * coeffs, float * delay, uint16_t n_taps){
+    if ((dec == NULL) || (coeffs == NULL) || (delay == NULL) || (n_taps < 2) ||
+        (fir_decim == 0) || (fir_decim > DECIMATOR_MAX_FIR_DECIM) ||
+        (first_decim == 0) || (first_decim > (1 << DECIMATOR_MAX_HALF_BANDS)) || (first_decim & (first_decim - 1))){
+        return false;
+    }
+    dec->n_half_bands = 0;
+    while ((1 << dec->n_half_bands) < first_decim){
+        dec->n_half_bands++;
+    }
+    // All the half band filters of every decimator share the same coefficients
+    DecimatorDesign(half_band_coeffs, DECIMATOR_HALF_BAND_TAPS, HALF_BAND_CUT_FREC);
+    for (uint8_t t = 1; t < HALF_BAND_CENTER; t += 2){
+        // sin(pi m / 2) / (pi m) is 0 for even m, only rounding is left
+        half_band_coeffs[t] = half_band_coeffs[DECIMATOR_HALF_BAND_TAPS - 1 - t] = 0;
+    }
+    for (uint8_t i = 0; i < dec->n_half_bands; i++){
+        dec->half_band[i].coeffs = half_band_coeffs;
+        dec->half_band[i].delay = dec->half_band_delay[i];
+        dec->half_band[i].N = DECIMATOR_HALF_BAND_TAPS;
+        dec->half_band[i].decim = 2;
+    }
+    DecimatorDesign(coeffs, n_taps, FIR_CUT_FREC / fir_decim);
+    if (dsps_fird_init_f32(&dec->fir, coeffs, delay, n_taps, fir_decim) != ESP_OK){
+        return false;
+    }
+    DecimatorReset(dec);
+    return true;
+}
+
+uint16_t DecimatorProcess(decimator_t * dec, const float * input_signal, uint16_t signal_lenght, float * output_signal){
+    uint16_t n_out = 0;
+    while (signal_lenght > 0){
+        uint16_t lenght = (signal_lenght < DECIMATOR_WORK_LENGHT) ? signal_lenght : DECIMATOR_WORK_LENGHT;
+        const float * input = input_signal;
+        uint16_t n = lenght;
+        // Half band filters work in place over the work buffer
+        for (uint8_t i = 0; i < dec->n_half_bands; i++){
+            n = DecimatorStage(&dec->half_band[i], DecimatorHalfBand, dec->half_band_pending[i], &dec->half_band_n_pending[i], input, n, dec->work);
+            input = dec->work;
+        }
+        n_out += DecimatorStage(&dec->fir, dsps_fird_f32, dec->fir_pending, &dec->fir_n_pending, input, n, &output_signal[n_out]);
+        input_signal += lenght;
+        signal_lenght -= lenght;
+    }
+    return n_out;
+}
+
+float DecimatorGroupDelay(const decimator_t * dec){
+    float delay = 0;
+    for (uint8_t i = 0; i < dec->n_half_bands; i++){
+        delay += (DECIMATOR_HALF_BAND_TAPS - 1) / 2.0f * (1 << i);
+    }
+    return delay + (dec->fir.N - 1) / 2.0f * (1 << dec->n_half_bands);
+}
+
+void DecimatorReset(decimator_t * dec){
+    for (uint8_t i = 0; i < dec->n_half_bands; i++){
+        memset(dec->half_band_delay[i], 0, sizeof(dec->half_band_delay[i]));
+        dec->half_band[i].pos = 0;
+        dec->half_band_n_pending[i] = 0;
+    }
+    memset(dec->fir.delay, 0, dec->fir.N * sizeof(float));
+    dec->fir.pos = 0;
+    dec->fir_n_pending = 0;
+}
+
+bool DecimatorInitQ15(decimator_q15_t * dec, uint8_t cic_decim, uint8_t fir_decim, int16_t * coeffs, int16_t * delay, uint16_t n_taps){
+    if ((dec == NULL) || (coeffs == NULL) || (delay == NULL) || (n_taps < 2) ||
+        (fir_decim == 0) || (fir_decim > DECIMATOR_MAX_FIR_DECIM) ||
+        (cic_decim == 0) || (cic_decim > DECIMATOR_MAX_CIC_DECIM)){
+        return false;
+    }
+    dec->cic_decim = cic_decim;
+    // CIC gain is cic_decim^order: the shift removes it up to a power of 2, the FIR the rest
+    float cic_gain = powf(cic_decim, DECIMATOR_CIC_ORDER);
+    dec->cic_shift = 0;
+    while ((1 << dec->cic_shift) < cic_gain){
+        dec->cic_shift++;
+    }
+    float sum = 0;
+    for (uint16_t i = 0; i < n_taps; i++){
+        sum += DecimatorTap(i, n_taps, FIR_CUT_FREC / fir_decim, cic_decim);
+    }
+    // Compensated design, quantized to Q14 tap by tap
+    float gain = (1 << dec->cic_shift) / cic_gain;
+    int32_t sum_abs = 0;
+    for (uint16_t i = 0; i < n_taps; i++){
+        float tap = roundf(DecimatorTap(i, n_taps, FIR_CUT_FREC / fir_decim, cic_decim) * gain / sum * COEFFS_Q14_ONE);
+        coeffs[i] = (tap > INT16_MAX) ? INT16_MAX : ((tap < INT16_MIN) ? INT16_MIN : (int16_t)tap);
+        sum_abs += abs(coeffs[i]);
+    }
+    // dsps_fird_s16() does not saturate its output: the FIR input is limited so the
+    // output can't exceed INT16_MAX for any signal (the gain of the taps is up to sum_abs)
+    int32_t limit = (int32_t)(((int64_t)INT16_MAX * COEFFS_Q14_ONE) / sum_abs);
+    dec->cic_limit = (limit > INT16_MAX) ? INT16_MAX : (int16_t)limit;
+    if (dsps_fird_init_s16(&dec->fir, coeffs, delay, n_taps, fir_decim, 0, FIR_Q14_SHIFT) != ESP_OK){
+        return false;
+    }
+    DecimatorResetQ15(dec);
+    return true;
+}
+
+uint16_t DecimatorProcessQ15(decimator_q15_t * dec, const int16_t * input_signal, uint16_t signal_lenght, int16_t * output_signal){
+    uint16_t n_out = 0;
+    while (signal_lenght > 0){
+        uint16_t lenght = (signal_lenght < DECIMATOR_WORK_LENGHT) ? signal_lenght : DECIMATOR_WORK_LENGHT;
+        uint16_t n = 0;
+        for (uint16_t i = 0; i < lenght; i++){
+            // Integrators run at the input rate
+            uint32_t acc = (uint32_t)(int32_t)input_signal[i];
+            for (uint8_t k = 0; k < DECIMATOR_CIC_ORDER; k++){
+                dec->integrator[k] += acc;
+                acc = dec->integrator[k];
+            }
+            if (++dec->cic_count < dec->cic_decim){
+                continue;
+            }
+            dec->cic_count = 0;
+            // Combs run at the output rate
+            for (uint8_t k = 0; k < DECIMATOR_CIC_ORDER; k++){
+                uint32_t prev = dec->comb[k];
+                dec->comb[k] = acc;
+                acc -= prev;
+            }
+            int32_t y = (int32_t)acc;
+            if (dec->cic_shift > 0){
+                y = (y + (1 << (dec->cic_shift - 1))) >> dec->cic_shift;
+            }
+            dec->work[n++] = (y > dec->cic_limit) ? dec->cic_limit : ((y < -dec->cic_limit) ? -dec->cic_limit : y);
+        }
+        n_out += DecimatorStageQ15(&dec->fir, dec->fir_pending, &dec->fir_n_pending, dec->work, n, &output_signal[n_out]);
+        input_signal += lenght;
+        signal_lenght -= lenght;
+    }
+    return n_out;
+}
+
+float DecimatorGroupDelayQ15(const decimator_q15_t * dec){
+    return DECIMATOR_CIC_ORDER * (dec->cic_decim - 1) / 2.0f + (dec->fir.coeffs_len - 1) / 2.0f * dec->cic_decim;
+}
+
+void DecimatorResetQ15(decimator_q15_t * dec){
+    memset(dec->integrator, 0, sizeof(dec->integrator));
+    memset(dec->comb, 0, sizeof(dec->comb));
+    dec->cic_count = 0;
+    memset(dec->fir.delay, 0, dec->fir.coeffs_len * sizeof(int16_t));
+    dec->fir.pos = 0;
+    dec->fir.d_pos = 0;
+    dec->fir_n_pending = 0;
+}
+
+/*==================[end of file]============================================*/
\ No newline at end of file
@@ -0,0 +1,192 @@
+/**
+ * @file fast_conv.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2023
+ * 
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include "fast_conv.h"
+#include "esp_dsp.h"
+/*==================[macros and definitions]=================================*/
+#define MIN_FFT_LENGHT      4       /*!< Minimum complex points of the FFT method */
+#define FFT_FLOPS           5       /*!< Operations of an N points FFT, over N log2(N) */
+#define SPECTRUM_FLOPS      8       /*!< Operations per point to pack, multiply and unpack */
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+/**
+ * @brief Complex FFT (with bit reversal) of fft_lenght points, radix-4 when possible
+ * 
+ * @param data          Complex values, transformed in place
+ * @param fft_lenght    Number of complex points (power of two)
+ */
+static void FastConvFFT(float * data, uint16_t fft_lenght);
+
+/**
+ * @brief Filter the samples already copied after the history in the line
+ * 
+ * @param conv          Pointer to the filter
+ * @param output        Filtered samples
+ * @param n_samples     Number of samples (up to block_lenght)
+ */
+static void FastConvProcess(fast_conv_t * conv, float * output, uint16_t n_samples);
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+static void FastConvFFT(float * data, uint16_t fft_lenght){
+    if (((dsp_power_of_two(fft_lenght) & 0x01) == 0) && dsps_fft4r_initialized &&
+        (fft_lenght <= dsps_fft4r_w_table_size / 2)){
+        dsps_fft4r_fc32(data, fft_lenght);
+        dsps_bit_rev4r_fc32(data, fft_lenght);
+    }
+    else{
+        dsps_fft2r_fc32(data, fft_lenght);
+        dsps_bit_rev2r_fc32(data, fft_lenght);
+    }
+}
+
+static void FastConvProcess(fast_conv_t * conv, float * output, uint16_t n_samples){
+    uint16_t history = conv->kernel_lenght - 1;
+    if (conv->fft_lenght == 0){
+        for (uint16_t i = 0; i < n_samples; i++){
+            dsps_dotprod_f32(&conv->line[i], conv->taps, &output[i], conv->kernel_lenght);
+        }
+    }
+    else{
+        // Overlap-save of two segments at once: the first half of the block as the
+        // real part and the second half as the imaginary part. The kernel is real,
+        // so the product of the spectrums keeps both results apart.
+        uint16_t first = (n_samples + 1) / 2;
+        uint16_t second = n_samples - first;
+        float * z = conv->segment;
+        for (uint16_t i = 0; i < history + first; i++){
+            z[2 * i] = conv->line[i];
+            z[2 * i + 1] = (i < history + second) ? conv->line[first + i] : 0;
+        }
+        memset(&z[2 * (history + first)], 0, 2 * (conv->fft_lenght - history - first) * sizeof(float));
+        FastConvFFT(z, conv->fft_lenght);
+        // Inverse FFT as FFT(conj(Z * H)) / N: taps already hold conj(H) / N
+        for (uint16_t k = 0; k < conv->fft_lenght; k++){
+            float re = z[2 * k], im = z[2 * k + 1];
+            float h_re = conv->taps[2 * k], h_im = conv->taps[2 * k + 1];
+            z[2 * k] = re * h_re + im * h_im;
+            z[2 * k + 1] = re * h_im - im * h_re;
+        }
+        FastConvFFT(z, conv->fft_lenght);
+        // First kernel_lenght - 1 values of each segment are wrapped around, and dropped
+        for (uint16_t i = 0; i < second; i++){
+            output[first + i] = -z[2 * (history + i) + 1];
+        }
+        for (uint16_t i = 0; i < first; i++){
+            output[i] = z[2 * (history + i)];
+        }
+    }
+    memmove(conv->line, &conv->line[n_samples], history * sizeof(float));
+}
+
+/*==================[external functions definition]==========================*/
+bool FastConvInit(fast_conv_t * conv, float * work, const float * kernel, uint16_t kernel_lenght,
+                  uint16_t block_lenght, fast_conv_mode_t mode, fast_conv_method_t method){
+    if ((conv == NULL) || (work == NULL) || (kernel == NULL) || (kernel_lenght == 0) || (block_lenght == 0) ||
+        (mode > FAST_CONV_CORRELATION) || (method > FAST_CONV_FFT)){
+        return false;
+    }
+    // Shortest FFT that holds the history and half of the block
+    uint32_t fft_lenght = MIN_FFT_LENGHT;
+    while (fft_lenght < (uint32_t)kernel_lenght - 1 + (block_lenght + 1) / 2){
+        fft_lenght *= 2;
+    }
+    bool fft_valid = dsps_fft2r_initialized && (fft_lenght <= (uint32_t)dsps_fft_w_table_size);
+    if (method == FAST_CONV_AUTO){
+        uint32_t direct_flops = 2 * (uint32_t)kernel_lenght * block_lenght;
+        uint32_t fft_flops = 2 * FFT_FLOPS * fft_lenght * dsp_power_of_two(fft_lenght) + SPECTRUM_FLOPS * fft_lenght;
+        method = (fft_valid && (fft_flops < direct_flops)) ? FAST_CONV_FFT : FAST_CONV_DIRECT;
+    }
+    else if ((method == FAST_CONV_FFT) && !fft_valid){
+        return false;
+    }
+    conv->kernel_lenght = kernel_lenght;
+    conv->block_lenght = block_lenght;
+    conv->taps = work;
+    if (method == FAST_CONV_DIRECT){
+        // Dot products run from the oldest sample: the convolution kernel goes reversed
+        conv->fft_lenght = 0;
+        conv->segment = NULL;
+        for (uint16_t i = 0; i < kernel_lenght; i++){
+            conv->taps[i] = (mode == FAST_CONV_CONVOLUTION) ? kernel[kernel_lenght - 1 - i] : kernel[i];
+        }
+        conv->line = &work[kernel_lenght];
+    }
+    else{
+        // Spectrum of the impulse response (the correlation pattern goes reversed)
+        conv->fft_lenght = fft_lenght;
+        memset(conv->taps, 0, 2 * fft_lenght * sizeof(float));
+        for (uint16_t i = 0; i < kernel_lenght; i++){
+            conv->taps[2 * i] = (mode == FAST_CONV_CONVOLUTION) ? kernel[i] : kernel[kernel_lenght - 1 - i];
+        }
+        FastConvFFT(conv->taps, fft_lenght);
+        float scale = 1.0f / fft_lenght;
+        for (uint16_t k = 0; k < fft_lenght; k++){
+            conv->taps[2 * k] *= scale;
+            conv->taps[2 * k + 1] *= -scale;
+        }
+        conv->segment = &work[2 * fft_lenght];
+        conv->line = &work[4 * fft_lenght];
+    }
+    FastConvReset(conv);
+    return true;
+}
+
+bool FastConvBlock(fast_conv_t * conv, const float * input, float * output, uint16_t n_samples){
+    if (n_samples > conv->block_lenght){
+        return false;
+    }
+    memcpy(&conv->line[conv->kernel_lenght - 1], input, n_samples * sizeof(float));
+    FastConvProcess(conv, output, n_samples);
+    return true;
+}
+
+void FastConvFull(fast_conv_t * conv, const float * signal, uint16_t signal_lenght, float * output){
+    FastConvReset(conv);
+    // 32 bits indexes: i + block_lenght can exceed UINT16_MAX on the last block
+    for (uint32_t i = 0; i < signal_lenght; i += conv->block_lenght){
+        uint16_t n = (signal_lenght - i < conv->block_lenght) ? signal_lenght - i : conv->block_lenght;
+        FastConvBlock(conv, &signal[i], &output[i], n);
+    }
+    // Tail: the kernel leaving the signal
+    for (uint32_t i = 0; i < conv->kernel_lenght - 1u; i += conv->block_lenght){
+        uint16_t n = (conv->kernel_lenght - 1 - i < conv->block_lenght) ? conv->kernel_lenght - 1 - i : conv->block_lenght;
+        memset(&conv->line[conv->kernel_lenght - 1], 0, n * sizeof(float));
+        FastConvProcess(conv, &output[signal_lenght + i], n);
+    }
+    FastConvReset(conv);
+}
+
+bool FastConvValid(fast_conv_t * conv, const float * signal, uint16_t signal_lenght, float * output){
+    if (signal_lenght < conv->kernel_lenght){
+        return false;
+    }
+    // The first kernel_lenght - 1 samples only fill the history
+    uint16_t history = conv->kernel_lenght - 1;
+    memcpy(conv->line, signal, history * sizeof(float));
+    for (uint32_t i = history; i < signal_lenght; i += conv->block_lenght){
+        uint16_t n = (signal_lenght - i < conv->block_lenght) ? signal_lenght - i : conv->block_lenght;
+        FastConvBlock(conv, &signal[i], &output[i - history], n);
+    }
+    FastConvReset(conv);
+    return true;
+}
+
+void FastConvReset(fast_conv_t * conv){
+    memset(conv->line, 0, (conv->kernel_lenght - 1 + conv->block_lenght) * sizeof(float));
+}
+
+/*==================[end of file]============================================*/
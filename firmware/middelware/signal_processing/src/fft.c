@@ -11,22 +11,372 @@
 
 /*==================[inclusions]=============================================*/
 #include <string.h>
+#include <stdlib.h>
 #include <math.h>
+#include <float.h>
 #include "fft.h"
 #include "esp_dsp.h"
 #include "esp_log.h"
 /*==================[macros and definitions]=================================*/
 #define TAG "FFT Module"
+#define WINDOW_CACHE_SIZE   12      /*!< Cached window lenghts: 1 to MAX_SIGNAL_LENGHT */
+#define Q15_INPUT_SHIFT     2       /*!< MAX_Q15_INPUT << 2 leaves one bit of headroom for the real spectrum unpacking */
+#define Q15_ROUND           (1 << 14)
+#define GOERTZEL_Q_SHIFT    30      /*!< Fractional bits of the fixed-point Goertzel coefficients */
+#define GOERTZEL_STATE_MAX  (1UL << 29) /*!< Bound of the fixed-point Goertzel state (one bit of headroom for s[n]) */
+#define SLIDING_RESONATORS  3       /*!< Bins k-1, k and k+1 are needed for the Hann window */
+#define FEATURES_PEAK_BINS  2       /*!< Bins on each side of the peak taken as signal by the SNR (Hann main lobe) */
 /*==================[internal data declaration]==============================*/
-static float fft_complex[2 * MAX_SIGNAL_LENGHT];
-static float wind[MAX_SIGNAL_LENGHT];
+static float fft_buffer[MAX_SIGNAL_LENGHT];          /*!< Real signal packed as signal_lenght / 2 complex values */
+static float * hann_cache[WINDOW_CACHE_SIZE];      /*!< Hann windows already generated, indexed by log2(lenght) */
+static int16_t fft_buffer_q15[MAX_SIGNAL_LENGHT];   /*!< Real signal packed as signal_lenght / 2 complex Q15 values */
+static int16_t * hann_q15_cache[WINDOW_CACHE_SIZE]; /*!< Q15 Hann windows already generated, indexed by log2(lenght) */
 /*==================[internal functions declaration]=========================*/
+/**
+ * @brief Return the Hann window for a given lenght, generating it only the first time
+ * 
+ * @param signal_lenght     Lenght of the window (power of two)
+ * @return const float*     Pointer to the window (NULL if there is not enough memory)
+ */
+static const float * FFTGetWindow(uint16_t signal_lenght);
+
+/**
+ * @brief Return the Q15 Hann window for a given lenght, generating it only the first time
+ * 
+ * @param signal_lenght     Lenght of the window (power of two)
+ * @return const int16_t*   Pointer to the window (NULL if there is not enough memory)
+ */
+static const int16_t * FFTGetWindowQ15(uint16_t signal_lenght);
+
+/**
+ * @brief Integer square root
+ * 
+ * @param value             Radicand
+ * @return uint16_t         Integer part of the square root of value
+ */
+static uint16_t FFTSqrtQ15(uint32_t value);
 
+/**
+ * @brief Compute the power spectrum of the windowed signal stored in buffer
+ * 
+ * The N real samples are processed as N/2 complex values (even samples as real 
+ * part, odd samples as imaginary part) with a radix-4 FFT (or radix-2 when N/2 is
+ * not a power of four), and the result is unpacked into the real signal spectrum.
+ * 
+ * @note  Power values are left in the first signal_lenght / 2 positions of buffer
+ * 
+ * @param buffer            Array with the windowed signal (of lenght = signal_lenght)
+ * @param signal_lenght     Lenght of the signal
+ */
+static void FFTPowerSpectrum(float * buffer, uint16_t signal_lenght);
+
+/**
+ * @brief Window a signal and compute its FFT magnitude in a workspace
+ * 
+ * @note  work can be the signal array, and fft can be the work array
+ * 
+ * @param work              Workspace (of lenght = signal_lenght)
+ * @param signal            Array with signal values (of lenght = signal_lenght)
+ * @param wind              Hann window (of lenght = signal_lenght)
+ * @param fft               Array to store FFT magnitude values (of lenght = signal_lenght / 2)
+ * @param signal_lenght     Lenght of the signal
+ */
+static void FFTMagnitudeWork(float * work, const float * signal, const float * wind, float * fft, uint16_t signal_lenght);
+
+/**
+ * @brief Window a signal and compute its FFT magnitude in a workspace, using fixed-point (Q15) arithmetic
+ * 
+ * @note  work can be the signal array, and fft can be the work array
+ * 
+ * @param work              Workspace (of lenght = signal_lenght)
+ * @param signal            Array with signal values (of lenght = signal_lenght)
+ * @param wind              Q15 Hann window (of lenght = signal_lenght)
+ * @param fft               Array to store FFT magnitude values (of lenght = signal_lenght / 2)
+ * @param signal_lenght     Lenght of the signal
+ */
+static void FFTMagnitudeWorkQ15(int16_t * work, const uint16_t * signal, const int16_t * wind, uint16_t * fft, uint16_t signal_lenght);
+
+/**
+ * @brief Window a signal and compute its spectral features in a workspace
+ * 
+ * @note  work can be the signal array
+ * 
+ * @param work              Workspace (of lenght = signal_lenght)
+ * @param signal            Array with signal values (of lenght = signal_lenght)
+ * @param wind              Hann window (of lenght = signal_lenght)
+ * @param config            Pointer to the features configuration
+ * @param features          Pointer to store the features
+ */
+static void FFTFeaturesWork(float * work, const float * signal, const float * wind, const fft_features_config_t * config, fft_features_t * features);
+
+/**
+ * @brief Convert power values into FFT magnitude values
+ * 
+ * @param power             Array with power values (of lenght = signal_lenght / 2)
+ * @param fft               Array to store FFT magnitude values (of lenght = signal_lenght / 2)
+ * @param signal_lenght     Lenght of the signal
+ * @param scale             Factor applied to power values before the conversion
+ */
+static void FFTPowerToMagnitude(const float * power, float * fft, uint16_t signal_lenght, float scale);
+
+/**
+ * @brief Compute the FFT of the last frame stored in a streaming analyzer
+ * 
+ * @param stream            Pointer to the analyzer state
+ * @return true             The frame completed a new averaged spectrum
+ * @return false            More frames are needed to complete the average
+ */
+static bool FFTStreamFrame(fft_stream_t * stream);
+
+/**
+ * @brief Check Goertzel bank parameters
+ * 
+ * Frequencies must be from min_freq up to (not including) sample_freq / 2, and the
+ * block lenght a power of two from 4 to MAX_SIGNAL_LENGHT.
+ * 
+ * @param frequencies       Array with the frequencies to analyze (of lenght = n_bins)
+ * @param n_bins            Number of frequencies
+ * @param sample_freq       Sample frequency
+ * @param block_lenght      Number of samples of each block
+ * @param min_freq          Lowest frequency accepted
+ * @return true             Valid parameters
+ * @return false            Invalid parameters
+ */
+static bool FFTGoertzelCheck(const float * frequencies, uint8_t n_bins, float sample_freq, uint16_t block_lenght, float min_freq);
 /*==================[internal data definition]===============================*/
 
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+static const float * FFTGetWindow(uint16_t signal_lenght){
+    int index = dsp_power_of_two(signal_lenght);
+    if (hann_cache[index] == NULL){
+        float * window = (float *)malloc(signal_lenght * sizeof(float));
+        if (window == NULL){
+            ESP_LOGE(TAG, "Not enough memory for a %d samples window", signal_lenght);
+            return NULL;
+        }
+        dsps_wind_hann_f32(window, signal_lenght);
+        hann_cache[index] = window;
+    }
+    return hann_cache[index];
+}
+
+static const int16_t * FFTGetWindowQ15(uint16_t signal_lenght){
+    int index = dsp_power_of_two(signal_lenght);
+    if (hann_q15_cache[index] == NULL){
+        int16_t * window = (int16_t *)malloc(signal_lenght * sizeof(int16_t));
+        if (window == NULL){
+            ESP_LOGE(TAG, "Not enough memory for a %d samples window", signal_lenght);
+            return NULL;
+        }
+        float len_mult = 1 / (float)(signal_lenght - 1);
+        for (int i = 0; i < signal_lenght; i++){
+            window[i] = (int16_t)(INT16_MAX * 0.5f * (1 - cosf(i * 2 * M_PI * len_mult)) + 0.5f);
+        }
+        hann_q15_cache[index] = window;
+    }
+    return hann_q15_cache[index];
+}
+
+static uint16_t FFTSqrtQ15(uint32_t value){
+    uint32_t root = 0;
+    uint32_t bit = 1UL << 30;
+    while (bit > value){
+        bit >>= 2;
+    }
+    while (bit != 0){
+        if (value >= root + bit){
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else{
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint16_t)root;
+}
+
+static void FFTPowerSpectrum(float * buffer, uint16_t signal_lenght){
+    int half = signal_lenght / 2;
+    // Calculate FFT of the N/2 complex values
+    if ((dsp_power_of_two(half) & 0x01) == 0){
+        dsps_fft4r_fc32(buffer, half);
+        dsps_bit_rev4r_fc32(buffer, half);
+    }
+    else{
+        dsps_fft2r_fc32(buffer, half);
+        dsps_bit_rev2r_fc32(buffer, half);
+    }
+    // Unpack the spectrum of the real signal (Nyquist bin is stored in buffer[1])
+    dsps_cplx2real_fc32(buffer, half);
+    buffer[1] = 0;
+    // Calculate power of each bin
+    for (int j = 0; j < half; j++){
+        buffer[j] = buffer[j*2+0]*buffer[j*2+0] + buffer[j*2+1]*buffer[j*2+1];
+    }
+}
+
+static void FFTMagnitudeWork(float * work, const float * signal, const float * wind, float * fft, uint16_t signal_lenght){
+    // Multiply input array with window (pairs of samples are packed as complex values)
+    dsps_mul_f32(signal, wind, work, signal_lenght, 1, 1, 1);
+    // Calculate FFT power
+    FFTPowerSpectrum(work, signal_lenght);
+    // Calculate FFT magnitude directly in fft array
+    FFTPowerToMagnitude(work, fft, signal_lenght, 1.0f);
+}
+
+static void FFTMagnitudeWorkQ15(int16_t * work, const uint16_t * signal, const int16_t * wind, uint16_t * fft, uint16_t signal_lenght){
+    int half = signal_lenght / 2;
+    // Multiply input array with window (pairs of samples are packed as complex values)
+    for (int i = 0; i < signal_lenght; i++){
+        int32_t sample = (int32_t)(signal[i] << Q15_INPUT_SHIFT);
+        work[i] = (int16_t)((sample * wind[i] + Q15_ROUND) >> 15);
+    }
+    // Calculate FFT of the N/2 complex values (each stage scales by 1/2)
+    dsps_fft2r_sc16(work, half);
+    dsps_bit_rev_sc16(work, half);
+    // Unpack the spectrum of the real signal (result is X[k] / N)
+    dsps_cplx2real_sc16_ansi(work, half);
+    // |X[k]| / N is already the magnitude of FFTMagnitude() in input units
+    fft[0] = abs(work[0]) / 2;
+    for (int j = 1; j < half; j++){
+        int32_t re = work[j*2+0];
+        int32_t im = work[j*2+1];
+        // Each square fits in int32_t, their sum (up to 2^31) only in uint32_t
+        fft[j] = FFTSqrtQ15((uint32_t)(re * re) + (uint32_t)(im * im));
+    }
+}
+
+static void FFTFeaturesWork(float * work, const float * signal, const float * wind, const fft_features_config_t * config, fft_features_t * features){
+    uint16_t half = config->signal_lenght / 2;
+    float norm = 2.0f / half;
+    float sum_magnitude = 0;
+    float sum_weighted = 0;
+    float total = 0;
+    float peak_power = -1;
+    int peak = config->first_bin;
+
+    dsps_mul_f32(signal, wind, work, config->signal_lenght, 1, 1, 1);
+    FFTPowerSpectrum(work, config->signal_lenght);
+    // DC magnitude is halved, as in FFTPowerToMagnitude()
+    work[0] = work[0] / 4;
+    memset(features->band_power, 0, sizeof(features->band_power));
+    // Bands are constant between edges: accumulate each segment and add it to the bands that cover it
+    for (int s = 0; s < config->n_edges - 1; s++){
+        uint16_t start = config->edges[s];
+        uint16_t end = config->edges[s + 1];
+        float segment = 0;
+        if (start >= config->first_bin){
+            for (int j = start; j < end; j++){
+                float power = work[j];
+                float magnitude = sqrtf(power);
+                segment += power;
+                sum_magnitude += magnitude;
+                sum_weighted += magnitude * j;
+                if (power > peak_power){
+                    peak_power = power;
+                    peak = j;
+                }
+            }
+            total += segment;
+        }
+        else{
+            for (int j = start; j < end; j++){
+                segment += work[j];
+            }
+        }
+        for (int b = 0; b < config->n_bands; b++){
+            if ((config->band_start[b] <= start) && (end <= config->band_end[b])){
+                features->band_power[b] += segment;
+            }
+        }
+    }
+    // Parabolic interpolation of the peak on a log scale (closer to the Hann main lobe than a linear one),
+    // magnitude is corrected with the Hann main lobe gain at that offset: sinc(d) / (1 - d^2)
+    float offset = 0;
+    float magnitude = sqrtf(peak_power);
+    if ((peak > config->first_bin) && (peak < half - 1) && (work[peak - 1] > 0) && (work[peak + 1] > 0)){
+        float left = logf(work[peak - 1]);
+        float center = logf(peak_power);
+        float right = logf(work[peak + 1]);
+        float den = left - 2 * center + right;
+        if (den < 0){
+            offset = 0.5f * (left - right) / den;
+        }
+        if (offset != 0){
+            float angle = M_PI * offset;
+            magnitude = magnitude * angle * (1 - offset * offset) / sinf(angle);
+        }
+    }
+    // SNR: main lobe of the peak against the rest of the analyzed bins
+    int first = (peak - FEATURES_PEAK_BINS > config->first_bin) ? peak - FEATURES_PEAK_BINS : config->first_bin;
+    int last = (peak + FEATURES_PEAK_BINS < half - 1) ? peak + FEATURES_PEAK_BINS : half - 1;
+    float signal_power = 0;
+    for (int j = first; j <= last; j++){
+        signal_power += work[j];
+    }
+    float noise_power = fmaxf(total - signal_power, total * FLT_EPSILON);
+
+    features->peak_frequency = (peak + offset) * config->bin_width;
+    features->peak_magnitude = norm * magnitude;
+    features->centroid = (sum_magnitude > 0) ? config->bin_width * sum_weighted / sum_magnitude : 0;
+    features->total_power = norm * norm * total;
+    features->snr = (signal_power > 0) ? 10 * log10f(signal_power / noise_power) : 0;
+    for (int b = 0; b < config->n_bands; b++){
+        features->band_power[b] *= norm * norm;
+    }
+}
+
+static void FFTPowerToMagnitude(const float * power, float * fft, uint16_t signal_lenght, float scale){
+    float norm = 2.0f / (signal_lenght / 2);
+    for (int j = 0; j < signal_lenght / 2; j++){
+        fft[j] = norm * sqrtf(power[j] * scale);
+    }
+    fft[0] = fft[0] / 2;
+}
+
+static bool FFTStreamFrame(fft_stream_t * stream){
+    uint16_t lenght = stream->frame_lenght;
+    uint16_t half = lenght / 2;
+    // Oldest samples go from write_index to the end of the circular buffer
+    uint16_t older = lenght - stream->write_index;
+    dsps_mul_f32(&stream->buffer[stream->write_index], stream->window, fft_buffer, older, 1, 1, 1);
+    dsps_mul_f32(stream->buffer, &stream->window[older], &fft_buffer[older], stream->write_index, 1, 1, 1);
+    FFTPowerSpectrum(fft_buffer, lenght);
+    // Welch average: accumulate power spectra
+    if (stream->frames == 0){
+        memcpy(stream->power, fft_buffer, half * sizeof(float));
+    }
+    else{
+        dsps_add_f32(stream->power, fft_buffer, stream->power, half, 1, 1, 1);
+    }
+    stream->frames++;
+    if (stream->frames < stream->averages){
+        return false;
+    }
+    // Latch the averaged spectrum in the second half of the power array
+    memcpy(&stream->power[half], stream->power, half * sizeof(float));
+    stream->frames = 0;
+    stream->ready = true;
+    return true;
+}
+
+static bool FFTGoertzelCheck(const float * frequencies, uint8_t n_bins, float sample_freq, uint16_t block_lenght, float min_freq){
+    if ((frequencies == NULL) || (n_bins == 0) || (sample_freq <= 0)){
+        return false;
+    }
+    if (!dsp_is_power_of_two(block_lenght) || (block_lenght < 4) || (block_lenght > MAX_SIGNAL_LENGHT)){
+        return false;
+    }
+    for (int k = 0; k < n_bins; k++){
+        if ((frequencies[k] < min_freq) || (frequencies[k] >= sample_freq / 2)){
+            return false;
+        }
+    }
+    return true;
+}
 
 /*==================[external functions definition]==========================*/
 bool FFTInit(void){
@@ -34,29 +384,26 @@ bool FFTInit(void){
     if (ret != ESP_OK){
         return false;
     }
+    // Radix-4 tables are also used to unpack real signal spectrums
+    ret = dsps_fft4r_init_fc32(NULL, MAX_SIGNAL_LENGHT / 2);
+    if (ret != ESP_OK){
+        return false;
+    }
+    // Fixed-point tables
+    ret = dsps_fft2r_init_sc16(NULL, CONFIG_DSP_MAX_FFT_SIZE);
+    if (ret != ESP_OK){
+        return false;
+    }
     return true;
 }
 
 void FFTMagnitude(float * signal, float * fft, uint16_t signal_lenght){
-    // Generate Hann window
-    dsps_wind_hann_f32(wind, signal_lenght);
-    // Clear fft array
-    memset(fft_complex, 0, 2 * MAX_SIGNAL_LENGHT * sizeof(float));
-    // Multiply input array with window and store as real part
-    dsps_mul_f32(signal, wind, fft_complex, signal_lenght, 1, 1, 2);    
-    // Calculate FFT  
-    dsps_fft2r_fc32(fft_complex, signal_lenght);
-    // Bit reverse
-    dsps_bit_rev_fc32(fft_complex, signal_lenght);
-    // Convert one complex vector to two complex vectors
-    dsps_cplx2reC_fc32(fft_complex, signal_lenght);
-    // Calculate FFT magnitude 
-    for (int j = 0; j < signal_lenght; j++){
-            fft_complex[j] = 2*(sqrt(fft_complex[j*2+0]*fft_complex[j*2+0] + fft_complex[j*2+1]*fft_complex[j*2+1])) / (signal_lenght/2);
-    }
-    fft_complex[0] = fft_complex[0] / 2;
-    // Copy result in fft array
-    memcpy(fft, fft_complex, (signal_lenght / 2) * sizeof(float));
+    // Get (cached) Hann window
+    const float * wind = FFTGetWindow(signal_lenght);
+    if (wind == NULL){
+        return;
+    }
+    FFTMagnitudeWork(fft_buffer, signal, wind, fft, signal_lenght);
 }
 
 void FFTFrequency(float sample_freq, uint16_t signal_lenght, float * f){
@@ -66,4 +413,467 @@ void FFTFrequency(float sample_freq, uint16_t signal_lenght, float * f){
     }
 }
 
+void FFTMagnitudeQ15(const uint16_t * signal, uint16_t * fft, uint16_t signal_lenght){
+    const int16_t * wind = FFTGetWindowQ15(signal_lenght);
+    if (wind == NULL){
+        return;
+    }
+    FFTMagnitudeWorkQ15(fft_buffer_q15, signal, wind, fft, signal_lenght);
+}
+
+bool FFTContextInit(fft_context_t * ctx, float * work, uint16_t signal_lenght){
+    if ((ctx == NULL) || (work == NULL)){
+        return false;
+    }
+    if (!dsp_is_power_of_two(signal_lenght) || (signal_lenght < 4) || (signal_lenght > MAX_SIGNAL_LENGHT)){
+        return false;
+    }
+    // The window is resolved here, so FFTContextMagnitude() does not touch the cache
+    ctx->window = FFTGetWindow(signal_lenght);
+    if (ctx->window == NULL){
+        return false;
+    }
+    ctx->work = work;
+    ctx->signal_lenght = signal_lenght;
+    return true;
+}
+
+void FFTContextMagnitude(fft_context_t * ctx, const float * signal, float * fft){
+    FFTMagnitudeWork(ctx->work, signal, ctx->window, fft, ctx->signal_lenght);
+}
+
+bool FFTContextInitQ15(fft_context_q15_t * ctx, int16_t * work, uint16_t signal_lenght){
+    if ((ctx == NULL) || (work == NULL)){
+        return false;
+    }
+    if (!dsp_is_power_of_two(signal_lenght) || (signal_lenght < 4) || (signal_lenght > MAX_SIGNAL_LENGHT)){
+        return false;
+    }
+    ctx->window = FFTGetWindowQ15(signal_lenght);
+    if (ctx->window == NULL){
+        return false;
+    }
+    ctx->work = work;
+    ctx->signal_lenght = signal_lenght;
+    return true;
+}
+
+void FFTContextMagnitudeQ15(fft_context_q15_t * ctx, const uint16_t * signal, uint16_t * fft){
+    FFTMagnitudeWorkQ15(ctx->work, signal, ctx->window, fft, ctx->signal_lenght);
+}
+
+bool FFTFeaturesInit(fft_features_config_t * config, float sample_freq, uint16_t signal_lenght, float min_freq, const float * bands, uint8_t n_bands){
+    if ((config == NULL) || (sample_freq <= 0) || (min_freq < 0) || (min_freq >= sample_freq / 2)){
+        return false;
+    }
+    if (!dsp_is_power_of_two(signal_lenght) || (signal_lenght < 4) || (signal_lenght > MAX_SIGNAL_LENGHT)){
+        return false;
+    }
+    if ((n_bands > FFT_MAX_BANDS) || ((n_bands > 0) && (bands == NULL))){
+        return false;
+    }
+    uint16_t half = signal_lenght / 2;
+    config->bin_width = sample_freq / signal_lenght;
+    config->signal_lenght = signal_lenght;
+    config->first_bin = (uint16_t)ceilf(min_freq / config->bin_width);
+    if (config->first_bin >= half){
+        return false;
+    }
+    config->n_bands = n_bands;
+    config->n_edges = 0;
+    config->edges[config->n_edges++] = 0;
+    config->edges[config->n_edges++] = config->first_bin;
+    config->edges[config->n_edges++] = half;
+    for (int b = 0; b < n_bands; b++){
+        if ((bands[2*b] < 0) || (bands[2*b] >= bands[2*b+1])){
+            return false;
+        }
+        float start = ceilf(bands[2*b] / config->bin_width);
+        float end = ceilf(bands[2*b+1] / config->bin_width);
+        config->band_start[b] = (start < half) ? (uint16_t)start : half;
+        config->band_end[b] = (end < half) ? (uint16_t)end : half;
+        config->edges[config->n_edges++] = config->band_start[b];
+        config->edges[config->n_edges++] = config->band_end[b];
+    }
+    // Sort the edges and remove the repeated ones
+    for (int i = 1; i < config->n_edges; i++){
+        uint16_t edge = config->edges[i];
+        int j = i;
+        while ((j > 0) && (config->edges[j - 1] > edge)){
+            config->edges[j] = config->edges[j - 1];
+            j--;
+        }
+        config->edges[j] = edge;
+    }
+    int n_edges = 1;
+    for (int i = 1; i < config->n_edges; i++){
+        if (config->edges[i] != config->edges[n_edges - 1]){
+            config->edges[n_edges++] = config->edges[i];
+        }
+    }
+    config->n_edges = n_edges;
+    return true;
+}
+
+bool FFTFeatures(const fft_features_config_t * config, const float * signal, fft_features_t * features){
+    const float * wind = FFTGetWindow(config->signal_lenght);
+    if (wind == NULL){
+        return false;
+    }
+    FFTFeaturesWork(fft_buffer, signal, wind, config, features);
+    return true;
+}
+
+bool FFTContextFeatures(fft_context_t * ctx, const fft_features_config_t * config, const float * signal, fft_features_t * features){
+    if (ctx->signal_lenght != config->signal_lenght){
+        return false;
+    }
+    FFTFeaturesWork(ctx->work, signal, ctx->window, config, features);
+    return true;
+}
+
+bool FFTStreamInit(fft_stream_t * stream, float * buffer, float * power, uint16_t frame_lenght, uint16_t hop_size, uint8_t averages){
+    if ((stream == NULL) || (buffer == NULL) || (power == NULL)){
+        return false;
+    }
+    if (!dsp_is_power_of_two(frame_lenght) || (frame_lenght < 4) || (frame_lenght > MAX_SIGNAL_LENGHT)){
+        return false;
+    }
+    if ((hop_size == 0) || (hop_size > frame_lenght) || (averages == 0)){
+        return false;
+    }
+    stream->window = FFTGetWindow(frame_lenght);
+    if (stream->window == NULL){
+        return false;
+    }
+    stream->buffer = buffer;
+    stream->power = power;
+    stream->frame_lenght = frame_lenght;
+    stream->hop_size = hop_size;
+    stream->averages = averages;
+    FFTStreamReset(stream);
+    return true;
+}
+
+bool FFTStreamPush(fft_stream_t * stream, const float * samples, uint16_t n_samples){
+    bool new_spectrum = false;
+    uint16_t lenght = stream->frame_lenght;
+    while (n_samples > 0){
+        // Copy as many samples as possible without wrapping the buffer or skipping a frame
+        uint16_t chunk = lenght - stream->write_index;
+        uint16_t to_frame = lenght - stream->fill;
+        if ((stream->hop_count < stream->hop_size) && ((stream->hop_size - stream->hop_count) > to_frame)){
+            to_frame = stream->hop_size - stream->hop_count;
+        }
+        if (to_frame < chunk){
+            chunk = to_frame;
+        }
+        if (n_samples < chunk){
+            chunk = n_samples;
+        }
+        memcpy(&stream->buffer[stream->write_index], samples, chunk * sizeof(float));
+        samples += chunk;
+        n_samples -= chunk;
+        stream->write_index += chunk;
+        if (stream->write_index == lenght){
+            stream->write_index = 0;
+        }
+        stream->fill += chunk;
+        if (stream->fill > lenght){
+            stream->fill = lenght;
+        }
+        stream->hop_count += chunk;
+        if ((stream->fill == lenght) && (stream->hop_count >= stream->hop_size)){
+            stream->hop_count = 0;
+            if (FFTStreamFrame(stream)){
+                new_spectrum = true;
+            }
+        }
+    }
+    return new_spectrum;
+}
+
+bool FFTStreamGetSpectrum(fft_stream_t * stream, float * fft){
+    if (!stream->ready){
+        return false;
+    }
+    FFTPowerToMagnitude(&stream->power[stream->frame_lenght / 2], fft, stream->frame_lenght, 1.0f / stream->averages);
+    stream->ready = false;
+    return true;
+}
+
+void FFTStreamReset(fft_stream_t * stream){
+    stream->write_index = 0;
+    stream->fill = 0;
+    stream->hop_count = 0;
+    stream->frames = 0;
+    stream->ready = false;
+}
+
+bool FFTGoertzelInit(fft_goertzel_t * goertzel, float * buffer, const float * frequencies, uint8_t n_bins, float sample_freq, uint16_t block_lenght){
+    if ((goertzel == NULL) || (buffer == NULL)){
+        return false;
+    }
+    if (!FFTGoertzelCheck(frequencies, n_bins, sample_freq, block_lenght, 0)){
+        return false;
+    }
+    goertzel->window = FFTGetWindow(block_lenght);
+    if (goertzel->window == NULL){
+        return false;
+    }
+    goertzel->coeffs = buffer;
+    goertzel->state = &buffer[2 * n_bins];
+    goertzel->magnitude = &buffer[4 * n_bins];
+    goertzel->n_bins = n_bins;
+    goertzel->block_lenght = block_lenght;
+    for (int k = 0; k < n_bins; k++){
+        float w = 2 * M_PI * frequencies[k] / sample_freq;
+        goertzel->coeffs[2*k+0] = 2 * cosf(w);
+        goertzel->coeffs[2*k+1] = sinf(w);
+    }
+    FFTGoertzelReset(goertzel);
+    return true;
+}
+
+bool FFTGoertzelUpdate(fft_goertzel_t * goertzel, float sample){
+    float x = sample * goertzel->window[goertzel->count];
+    float * state = goertzel->state;
+    const float * coeffs = goertzel->coeffs;
+    // s[n] = x[n] + 2 cos(w) s[n-1] - s[n-2]
+    for (int k = 0; k < goertzel->n_bins; k++){
+        float s = x + coeffs[2*k] * state[2*k] - state[2*k+1];
+        state[2*k+1] = state[2*k];
+        state[2*k] = s;
+    }
+    goertzel->count++;
+    if (goertzel->count < goertzel->block_lenght){
+        return false;
+    }
+    // X = s[N-1] - exp(-jw) s[N-2], with the normalization of FFTMagnitude()
+    float norm = 4.0f / goertzel->block_lenght;
+    for (int k = 0; k < goertzel->n_bins; k++){
+        float re = state[2*k] - 0.5f * coeffs[2*k] * state[2*k+1];
+        float im = coeffs[2*k+1] * state[2*k+1];
+        goertzel->magnitude[k] = norm * sqrtf(re * re + im * im);
+        if (coeffs[2*k] == 2.0f){
+            goertzel->magnitude[k] /= 2;
+        }
+        state[2*k] = 0;
+        state[2*k+1] = 0;
+    }
+    goertzel->count = 0;
+    goertzel->ready = true;
+    return true;
+}
+
+bool FFTGoertzelGetMagnitude(fft_goertzel_t * goertzel, float * magnitude){
+    if (!goertzel->ready){
+        return false;
+    }
+    memcpy(magnitude, goertzel->magnitude, goertzel->n_bins * sizeof(float));
+    goertzel->ready = false;
+    return true;
+}
+
+void FFTGoertzelReset(fft_goertzel_t * goertzel){
+    memset(goertzel->state, 0, 2 * goertzel->n_bins * sizeof(float));
+    goertzel->count = 0;
+    goertzel->ready = false;
+}
+
+bool FFTGoertzelInitQ15(fft_goertzel_q15_t * goertzel, int32_t * buffer, const float * frequencies, uint8_t n_bins, float sample_freq, uint16_t block_lenght){
+    if ((goertzel == NULL) || (buffer == NULL)){
+        return false;
+    }
+    // Lower frequencies would need more than 32 bits for the state
+    if (!FFTGoertzelCheck(frequencies, n_bins, sample_freq, block_lenght, sample_freq / block_lenght)){
+        return false;
+    }
+    goertzel->window = FFTGetWindowQ15(block_lenght);
+    if (goertzel->window == NULL){
+        return false;
+    }
+    goertzel->coeffs = buffer;
+    goertzel->state = &buffer[2 * n_bins];
+    goertzel->magnitude = &buffer[4 * n_bins];
+    goertzel->n_bins = n_bins;
+    goertzel->block_lenght = block_lenght;
+    float min_sin = 1.0f;
+    for (int k = 0; k < n_bins; k++){
+        double w = 2 * M_PI * frequencies[k] / sample_freq;
+        double coeff = 2 * cos(w) * (1UL << GOERTZEL_Q_SHIFT);
+        goertzel->coeffs[2*k+0] = (coeff >= INT32_MAX) ? INT32_MAX : (int32_t)lround(coeff);
+        goertzel->coeffs[2*k+1] = (int32_t)lround(sin(w) * (1UL << GOERTZEL_Q_SHIFT));
+        if (sinf(w) < min_sin){
+            min_sin = sinf(w);
+        }
+    }
+    // |s[n]| <= sum(|x|) / sin(w): keep as many fractional bits of the windowed samples (Q15) as fit below GOERTZEL_STATE_MAX
+    float bound = MAX_Q15_INPUT * (block_lenght / 2) / min_sin;
+    int input_shift = 0;
+    while ((bound * ldexpf(1.0f, 15 - input_shift) > GOERTZEL_STATE_MAX) && (input_shift < 30)){
+        input_shift++;
+    }
+    // Magnitude = 4 |X| / N, in input units
+    int output_shift = dsp_power_of_two(block_lenght) - 2 + 15 - input_shift;
+    if (output_shift < 0){
+        return false;
+    }
+    goertzel->input_shift = input_shift;
+    goertzel->output_shift = output_shift;
+    FFTGoertzelResetQ15(goertzel);
+    return true;
+}
+
+bool FFTGoertzelUpdateQ15(fft_goertzel_q15_t * goertzel, uint16_t sample){
+    int32_t x = ((int32_t)sample * goertzel->window[goertzel->count]) >> goertzel->input_shift;
+    int32_t * state = goertzel->state;
+    const int32_t * coeffs = goertzel->coeffs;
+    for (int k = 0; k < goertzel->n_bins; k++){
+        int32_t feedback = (int32_t)(((int64_t)coeffs[2*k] * state[2*k] + (1L << (GOERTZEL_Q_SHIFT - 1))) >> GOERTZEL_Q_SHIFT);
+        int32_t s = x + feedback - state[2*k+1];
+        state[2*k+1] = state[2*k];
+        state[2*k] = s;
+    }
+    goertzel->count++;
+    if (goertzel->count < goertzel->block_lenght){
+        return false;
+    }
+    // X = s[N-1] - exp(-jw) s[N-2], scaled down to magnitude values before the square root
+    uint8_t shift = goertzel->output_shift;
+    int32_t round = (shift > 0) ? (1L << (shift - 1)) : 0;
+    for (int k = 0; k < goertzel->n_bins; k++){
+        int64_t re = ((int64_t)state[2*k] << GOERTZEL_Q_SHIFT) - (int64_t)(coeffs[2*k] / 2) * state[2*k+1];
+        int64_t im = (int64_t)coeffs[2*k+1] * state[2*k+1];
+        int32_t re_mag = (int32_t)(((re >> GOERTZEL_Q_SHIFT) + round) >> shift);
+        int32_t im_mag = (int32_t)(((im >> GOERTZEL_Q_SHIFT) + round) >> shift);
+        // The squares can exceed 32 bits before saturation
+        uint64_t power = (uint64_t)((int64_t)re_mag * re_mag) + (uint64_t)((int64_t)im_mag * im_mag);
+        uint32_t magnitude = FFTSqrtQ15((power > UINT32_MAX) ? UINT32_MAX : (uint32_t)power);
+        goertzel->magnitude[k] = (magnitude > UINT16_MAX) ? UINT16_MAX : magnitude;
+        state[2*k] = 0;
+        state[2*k+1] = 0;
+    }
+    goertzel->count = 0;
+    goertzel->ready = true;
+    return true;
+}
+
+bool FFTGoertzelGetMagnitudeQ15(fft_goertzel_q15_t * goertzel, uint16_t * magnitude){
+    if (!goertzel->ready){
+        return false;
+    }
+    for (int k = 0; k < goertzel->n_bins; k++){
+        magnitude[k] = (uint16_t)goertzel->magnitude[k];
+    }
+    goertzel->ready = false;
+    return true;
+}
+
+void FFTGoertzelResetQ15(fft_goertzel_q15_t * goertzel){
+    memset(goertzel->state, 0, 2 * goertzel->n_bins * sizeof(int32_t));
+    goertzel->count = 0;
+    goertzel->ready = false;
+}
+
+bool FFTSlidingInit(fft_sliding_t * sliding, float * buffer, float * state, const uint16_t * bins, uint8_t n_bins, uint16_t window_lenght){
+    if ((sliding == NULL) || (buffer == NULL) || (state == NULL) || (bins == NULL) || (n_bins == 0)){
+        return false;
+    }
+    if ((window_lenght < 4) || (window_lenght > MAX_SIGNAL_LENGHT)){
+        return false;
+    }
+    for (int k = 0; k < n_bins; k++){
+        if (bins[k] >= window_lenght / 2){
+            return false;
+        }
+    }
+    uint16_t n_resonators = SLIDING_RESONATORS * n_bins;
+    sliding->buffer = buffer;
+    sliding->state = state;
+    sliding->anchor = &state[2 * n_resonators];
+    sliding->phasor = &state[4 * n_resonators];
+    sliding->twiddle = &state[6 * n_resonators];
+    sliding->bins = bins;
+    sliding->n_bins = n_bins;
+    sliding->window_lenght = window_lenght;
+    for (int r = 0; r < n_resonators; r++){
+        int bin = bins[r / SLIDING_RESONATORS] + (r % SLIDING_RESONATORS) - 1;
+        float w = 2 * M_PI * bin / window_lenght;
+        sliding->twiddle[2*r+0] = cosf(w);
+        sliding->twiddle[2*r+1] = sinf(w);
+    }
+    FFTSlidingReset(sliding);
+    return true;
+}
+
+void FFTSlidingUpdate(fft_sliding_t * sliding, float sample){
+    uint16_t n_resonators = SLIDING_RESONATORS * sliding->n_bins;
+    float * state = sliding->state;
+    float * anchor = sliding->anchor;
+    float * phasor = sliding->phasor;
+    const float * twiddle = sliding->twiddle;
+    float delta = sample - sliding->buffer[sliding->write_index];
+    sliding->buffer[sliding->write_index] = sample;
+    for (int r = 0; r < n_resonators; r++){
+        // X[k] = (X[k] + x[n] - x[n-N]) exp(j w)
+        float re = state[2*r+0] + delta;
+        float im = state[2*r+1];
+        state[2*r+0] = re * twiddle[2*r+0] - im * twiddle[2*r+1];
+        state[2*r+1] = re * twiddle[2*r+1] + im * twiddle[2*r+0];
+        // Same value by direct summation over the current block: sum(x[m] exp(-j w m))
+        anchor[2*r+0] += sample * phasor[2*r+0];
+        anchor[2*r+1] += sample * phasor[2*r+1];
+        re = phasor[2*r+0];
+        im = phasor[2*r+1];
+        phasor[2*r+0] = re * twiddle[2*r+0] + im * twiddle[2*r+1];
+        phasor[2*r+1] = im * twiddle[2*r+0] - re * twiddle[2*r+1];
+    }
+    sliding->write_index++;
+    if (sliding->fill < sliding->window_lenght){
+        sliding->fill++;
+    }
+    if (sliding->write_index == sliding->window_lenght){
+        // Block completed: re-anchor the recursive values to the direct summation
+        sliding->write_index = 0;
+        memcpy(state, anchor, 2 * n_resonators * sizeof(float));
+        memset(anchor, 0, 2 * n_resonators * sizeof(float));
+        for (int r = 0; r < n_resonators; r++){
+            phasor[2*r+0] = 1;
+            phasor[2*r+1] = 0;
+        }
+    }
+}
+
+bool FFTSlidingGetMagnitude(const fft_sliding_t * sliding, float * magnitude){
+    if (sliding->fill < sliding->window_lenght){
+        return false;
+    }
+    float norm = 4.0f / sliding->window_lenght;
+    const float * state = sliding->state;
+    for (int k = 0; k < sliding->n_bins; k++){
+        // Hann window: 0.5 X[k] - 0.25 (X[k-1] + X[k+1])
+        const float * x = &state[2 * SLIDING_RESONATORS * k];
+        float re = 0.5f * x[2] - 0.25f * (x[0] + x[4]);
+        float im = 0.5f * x[3] - 0.25f * (x[1] + x[5]);
+        magnitude[k] = norm * sqrtf(re * re + im * im);
+        if (sliding->bins[k] == 0){
+            magnitude[k] /= 2;
+        }
+    }
+    return true;
+}
+
+void FFTSlidingReset(fft_sliding_t * sliding){
+    uint16_t n_resonators = SLIDING_RESONATORS * sliding->n_bins;
+    memset(sliding->buffer, 0, sliding->window_lenght * sizeof(float));
+    memset(sliding->state, 0, 4 * n_resonators * sizeof(float));
+    for (int r = 0; r < n_resonators; r++){
+        sliding->phasor[2*r+0] = 1;
+        sliding->phasor[2*r+1] = 0;
+    }
+    sliding->write_index = 0;
+    sliding->fill = 0;
+}
+
 /*==================[end of file]============================================*/
\ No newline at end of file
@@ -10,146 +10,320 @@
  */
 
 /*==================[inclusions]=============================================*/
+#include <string.h>
+#include <math.h>
 #include "iir_filter.h"
 #include "esp_dsp.h"
+#include "esp_attr.h"
 /*==================[macros and definitions]=================================*/
-#define N_SOS       5
-#define N_DELAY     2
-// 2nd order Butterworth 
-#define ORDER2_Q    (1 / 1.414)
-// 4th order Butterworth 
-#define ORDER4_Q1   (1 / 0.765)
-#define ORDER4_Q2   (1 / 1.848)
-// 6th order Butterworth 
-#define ORDER6_Q1   (1 / 0.518)
-#define ORDER6_Q2   (1 / 1.414)
-#define ORDER6_Q3   (1 / 1.932)
-// 8th order Butterworth 
-#define ORDER8_Q1   (1 / 0.390)
-#define ORDER8_Q2   (1 / 1.111)
-#define ORDER8_Q3   (1 / 1.663)
-#define ORDER8_Q4   (1 / 1.962)
+#define LEGACY_SECTIONS     (ORDER_8 / 2)   /*!< Maximum number of sections of LowPass/HiPass filters */
+#define NOTCH_Q             10.0f           /*!< Quality factor of notch sections (-3 dB bandwidth = notch_frec / NOTCH_Q) */
+#define NOTCH_GAIN          -120.0f         /*!< dsps_biquad_gen_notch_f32() gain parameter (-60 dB at notch_frec) */
+#define Q15_MAX             INT16_MAX
+#define Q15_MIN             INT16_MIN
+#define Q_COEFF_ONE         (1 << IIR_COEFFS_Q_SHIFT)
+#define Q_ROUND             (1 << (IIR_COEFFS_Q_SHIFT - 1))
+#define ERROR_SHIFT         (IIR_COEFFS_Q_SHIFT - 15)   /*!< Rounding errors are kept with 15 bits */
 /*==================[internal data declaration]==============================*/
-static uint8_t lp_order, hp_order;
-float hp2_delay[N_DELAY] = {0, 0};  // delay
-float hp4_delay[N_DELAY] = {0, 0};  // delay
-float hp6_delay[N_DELAY] = {0, 0};  // delay
-float hp8_delay[N_DELAY] = {0, 0};  // delay
-float lp2_delay[N_DELAY] = {0, 0};  // delay
-float lp4_delay[N_DELAY] = {0, 0};  // delay
-float lp6_delay[N_DELAY] = {0, 0};  // delay
-float lp8_delay[N_DELAY] = {0, 0};  // delay
-float lp2_sos_coeff[N_SOS]; 
-float lp4_sos_coeff[N_SOS]; 
-float lp6_sos_coeff[N_SOS]; 
-float lp8_sos_coeff[N_SOS]; 
-float hp2_sos_coeff[N_SOS]; 
-float hp4_sos_coeff[N_SOS]; 
-float hp6_sos_coeff[N_SOS]; 
-float hp8_sos_coeff[N_SOS]; 
+static float lp_coeffs[IIR_COEFFS_LENGHT(LEGACY_SECTIONS)];
+static float lp_delay[IIR_DELAY_LENGHT(LEGACY_SECTIONS, 1)];
+static float hp_coeffs[IIR_COEFFS_LENGHT(LEGACY_SECTIONS)];
+static float hp_delay[IIR_DELAY_LENGHT(LEGACY_SECTIONS, 1)];
+static iir_filter_t lp_filter = {.n_sections = 0};
+static iir_filter_t hp_filter = {.n_sections = 0};
 /*==================[internal functions declaration]=========================*/
+/**
+ * @brief Quality factor of one of the second order sections of a Butterworth filter
+ * 
+ * @param section       Section number (0 to n_sections - 1)
+ * @param n_sections    Number of sections of the filter (order = 2 * n_sections)
+ * @return float        Quality factor of the section
+ */
+static float IIRButterworthQ(uint8_t section, uint8_t n_sections);
+
+/**
+ * @brief Check the order of a LowPass/HiPass filter (only the filter_order_t values fit the static arrays)
+ * 
+ * @param order         Filter's order
+ * @return true         Order is 2, 4, 6 or 8
+ * @return false        Unsupported order
+ */
+static bool IIRLegacyOrder(filter_order_t order);
 
+/**
+ * @brief Quantize the floating point design of a Q15 filter to Q30 coefficients
+ * 
+ * @param filter        Pointer to the filter object
+ */
+static void IIRFilterQuantize(iir_filter_t * filter);
+
+/**
+ * @brief Filter one sample through a floating point cascade (transposed direct form II)
+ * 
+ * @param coeffs        Coefficients of the sections
+ * @param delay         Delay lines of the sections for one channel
+ * @param n_sections    Number of sections
+ * @param x             Input sample
+ * @return float        Output sample
+ */
+FORCE_INLINE_ATTR float IIRCascadeStep(const float * coeffs, float * delay, uint8_t n_sections, float x);
+
+/**
+ * @brief Filter one sample through a fixed point cascade (direct form I)
+ * 
+ * @param coeffs        Q30 coefficients of the sections
+ * @param delay         Delay lines of the sections for one channel
+ * @param n_sections    Number of sections
+ * @param x             Q15 input sample
+ * @return int16_t      Q15 output sample
+ */
+FORCE_INLINE_ATTR int16_t IIRCascadeStepQ15(const int32_t * coeffs, int16_t * delay, uint8_t n_sections, int16_t x);
 /*==================[internal data definition]===============================*/
 
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+static float IIRButterworthQ(uint8_t section, uint8_t n_sections){
+    // Poles of a Butterworth filter of order n are at angles (2k + 1) * pi / (2n)
+    return 1 / (2 * sinf((2 * section + 1) * M_PI / (4 * n_sections)));
+}
+
+static bool IIRLegacyOrder(filter_order_t order){
+    return (order == ORDER_2) || (order == ORDER_4) || (order == ORDER_6) || (order == ORDER_8);
+}
+
+static void IIRFilterQuantize(iir_filter_t * filter){
+    if (filter->format != IIR_Q15){
+        return;
+    }
+    for (uint16_t i = 0; i < IIR_COEFFS_LENGHT(filter->n_sections); i++){
+        float value = roundf(filter->coeffs[i] * Q_COEFF_ONE);
+        // Only a coefficient of exactly 2 is out of range
+        if (value >= (float)INT32_MAX){
+            filter->coeffs_q[i] = INT32_MAX;
+        }
+        else{
+            filter->coeffs_q[i] = (int32_t)value;
+        }
+    }
+}
+
+FORCE_INLINE_ATTR float IIRCascadeStep(const float * coeffs, float * delay, uint8_t n_sections, float x){
+    // Transposed direct form II: each section output feeds the next one
+    for (uint8_t s = 0; s < n_sections; s++){
+        float y = coeffs[0] * x + delay[0];
+        delay[0] = coeffs[1] * x - coeffs[3] * y + delay[1];
+        delay[1] = coeffs[2] * x - coeffs[4] * y;
+        x = y;
+        coeffs += IIR_SOS_COEFFS;
+        delay += IIR_SOS_DELAY;
+    }
+    return x;
+}
+
+FORCE_INLINE_ATTR int16_t IIRCascadeStepQ15(const int32_t * coeffs, int16_t * delay, uint8_t n_sections, int16_t x){
+    // Direct form I: delay lines keep x[n-1], x[n-2], y[n-1], y[n-2] of each section
+    for (uint8_t s = 0; s < n_sections; s++){
+        // Rounding errors of previous outputs are fed back shaped by (1 - z^-1)^2,
+        // so they are not amplified by poles near z = 1 (low cut-off frequencies)
+        int64_t acc = Q_ROUND + (((2 * (int64_t)delay[4] - delay[5])) << ERROR_SHIFT);
+        acc += (int64_t)coeffs[0] * x;
+        acc += (int64_t)coeffs[1] * delay[0];
+        acc += (int64_t)coeffs[2] * delay[1];
+        acc -= (int64_t)coeffs[3] * delay[2];
+        acc -= (int64_t)coeffs[4] * delay[3];
+        int64_t y = acc >> IIR_COEFFS_Q_SHIFT;
+        int16_t error = (int16_t)((acc - Q_ROUND - (y << IIR_COEFFS_Q_SHIFT)) >> ERROR_SHIFT);
+        if (y > Q15_MAX){
+            y = Q15_MAX;
+        }
+        else if (y < Q15_MIN){
+            y = Q15_MIN;
+        }
+        delay[1] = delay[0];
+        delay[0] = x;
+        delay[3] = delay[2];
+        delay[2] = y;
+        delay[5] = delay[4];
+        delay[4] = error;
+        x = y;
+        coeffs += IIR_SOS_COEFFS;
+        delay += IIR_SOS_DELAY_Q15;
+    }
+    return x;
+}
 
 /*==================[external functions definition]==========================*/
 
 void LowPassInit(float sample_frec, float cut_frec, filter_order_t order){
-    float f = cut_frec / sample_frec;
-    lp_order = order;
-    switch(lp_order){
-        case ORDER_2:
-            dsps_biquad_gen_lpf_f32(lp2_sos_coeff, f, ORDER2_Q);
-        break;
-        case ORDER_4:
-            dsps_biquad_gen_lpf_f32(lp2_sos_coeff, f, ORDER4_Q1);
-            dsps_biquad_gen_lpf_f32(lp4_sos_coeff, f, ORDER4_Q2);
-        break;
-        case ORDER_6:
-            dsps_biquad_gen_lpf_f32(lp2_sos_coeff, f, ORDER6_Q1);
-            dsps_biquad_gen_lpf_f32(lp4_sos_coeff, f, ORDER6_Q2);
-            dsps_biquad_gen_lpf_f32(lp6_sos_coeff, f, ORDER6_Q3);
-        break;
-        case ORDER_8:
-            dsps_biquad_gen_lpf_f32(lp2_sos_coeff, f, ORDER8_Q1);
-            dsps_biquad_gen_lpf_f32(lp4_sos_coeff, f, ORDER8_Q2);
-            dsps_biquad_gen_lpf_f32(lp6_sos_coeff, f, ORDER8_Q3);
-            dsps_biquad_gen_lpf_f32(lp8_sos_coeff, f, ORDER8_Q4);
-        break;
+    if (!IIRLegacyOrder(order) || !IIRFilterInit(&lp_filter, lp_coeffs, lp_delay, order / 2, 1)){
+        return;
     }
+    IIRFilterDesignLowPass(&lp_filter, sample_frec, cut_frec);
 }
 
 void HiPassInit(float sample_frec, float cut_frec, filter_order_t order){
-    float f = cut_frec / sample_frec;
-    hp_order = order;
-    switch(hp_order){
-        case ORDER_2:
-            dsps_biquad_gen_hpf_f32(hp2_sos_coeff, f, ORDER2_Q);
-        break;
-        case ORDER_4:
-            dsps_biquad_gen_hpf_f32(hp2_sos_coeff, f, ORDER4_Q1);
-            dsps_biquad_gen_hpf_f32(hp4_sos_coeff, f, ORDER4_Q2);
-        break;
-        case ORDER_6:
-            dsps_biquad_gen_hpf_f32(hp2_sos_coeff, f, ORDER6_Q1);
-            dsps_biquad_gen_hpf_f32(hp4_sos_coeff, f, ORDER6_Q2);
-            dsps_biquad_gen_hpf_f32(hp6_sos_coeff, f, ORDER6_Q3);
-        break;
-        case ORDER_8:
-            dsps_biquad_gen_hpf_f32(hp2_sos_coeff, f, ORDER8_Q1);
-            dsps_biquad_gen_hpf_f32(hp4_sos_coeff, f, ORDER8_Q2);
-            dsps_biquad_gen_hpf_f32(hp6_sos_coeff, f, ORDER8_Q3);
-            dsps_biquad_gen_hpf_f32(hp8_sos_coeff, f, ORDER8_Q4);
-        break;
+    if (!IIRLegacyOrder(order) || !IIRFilterInit(&hp_filter, hp_coeffs, hp_delay, order / 2, 1)){
+        return;
     }
+    IIRFilterDesignHiPass(&hp_filter, sample_frec, cut_frec);
 }
 
 void LowPassFilter(float * input_signal, float * output_signal, int16_t signal_lenght){
-    switch(lp_order){
-        case ORDER_2:
-            dsps_biquad_f32(input_signal, output_signal, signal_lenght, lp2_sos_coeff, lp2_delay);
-        break;
-        case ORDER_4:
-            dsps_biquad_f32(input_signal, output_signal, signal_lenght, lp2_sos_coeff, lp2_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, lp4_sos_coeff, lp4_delay);
-        break;
-        case ORDER_6:
-            dsps_biquad_f32(input_signal, output_signal, signal_lenght, lp2_sos_coeff, lp2_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, lp4_sos_coeff, lp4_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, lp6_sos_coeff, lp6_delay);
-        break;
-        case ORDER_8:
-            dsps_biquad_f32(input_signal, output_signal, signal_lenght, lp2_sos_coeff, lp2_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, lp4_sos_coeff, lp4_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, lp6_sos_coeff, lp6_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, lp8_sos_coeff, lp8_delay);
-        break;
+    if (signal_lenght <= 0){
+        return;
     }
+    IIRFilterProcess(&lp_filter, input_signal, output_signal, signal_lenght);
 }
 
 void HiPassFilter(float * input_signal, float * output_signal, int16_t signal_lenght){
-    switch(hp_order){
-        case ORDER_2:
-            dsps_biquad_f32(input_signal, output_signal, signal_lenght, hp2_sos_coeff, hp2_delay);
-        break;
-        case ORDER_4:
-            dsps_biquad_f32(input_signal, output_signal, signal_lenght, hp2_sos_coeff, hp2_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, hp4_sos_coeff, hp4_delay);
-        break;
-        case ORDER_6:
-            dsps_biquad_f32(input_signal, output_signal, signal_lenght, hp2_sos_coeff, hp2_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, hp4_sos_coeff, hp4_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, hp6_sos_coeff, hp6_delay);
-        break;
-        case ORDER_8:
-            dsps_biquad_f32(input_signal, output_signal, signal_lenght, hp2_sos_coeff, hp2_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, hp4_sos_coeff, hp4_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, hp6_sos_coeff, hp6_delay);
-            dsps_biquad_f32(output_signal, output_signal, signal_lenght, hp8_sos_coeff, hp8_delay);
-        break;
+    if (signal_lenght <= 0){
+        return;
+    }
+    IIRFilterProcess(&hp_filter, input_signal, output_signal, signal_lenght);
+}
+
+bool IIRFilterInit(iir_filter_t * filter, float * coeffs, float * delay, uint8_t n_sections, uint8_t n_channels){
+    if ((filter == NULL) || (coeffs == NULL) || (delay == NULL) || (n_sections == 0) || (n_channels == 0)){
+        return false;
+    }
+    filter->coeffs = coeffs;
+    filter->delay = delay;
+    filter->n_sections = n_sections;
+    filter->n_channels = n_channels;
+    filter->format = IIR_FLOAT;
+    filter->coeffs_q = NULL;
+    filter->delay_q15 = NULL;
+    memset(coeffs, 0, IIR_COEFFS_LENGHT(n_sections) * sizeof(float));
+    for (uint8_t i = 0; i < n_sections; i++){
+        coeffs[i * IIR_SOS_COEFFS] = 1;
+    }
+    IIRFilterReset(filter);
+    return true;
+}
+
+bool IIRFilterInitQ15(iir_filter_t * filter, float * coeffs, int32_t * coeffs_q, int16_t * delay_q15, uint8_t n_sections, uint8_t n_channels){
+    if ((filter == NULL) || (coeffs == NULL) || (coeffs_q == NULL) || (delay_q15 == NULL) || (n_sections == 0) || (n_channels == 0)){
+        return false;
+    }
+    filter->coeffs = coeffs;
+    filter->delay = NULL;
+    filter->n_sections = n_sections;
+    filter->n_channels = n_channels;
+    filter->format = IIR_Q15;
+    filter->coeffs_q = coeffs_q;
+    filter->delay_q15 = delay_q15;
+    memset(coeffs, 0, IIR_COEFFS_LENGHT(n_sections) * sizeof(float));
+    for (uint8_t i = 0; i < n_sections; i++){
+        coeffs[i * IIR_SOS_COEFFS] = 1;
+    }
+    IIRFilterQuantize(filter);
+    IIRFilterReset(filter);
+    return true;
+}
+
+void IIRFilterDesignLowPass(iir_filter_t * filter, float sample_frec, float cut_frec){
+    float f = cut_frec / sample_frec;
+    for (uint8_t i = 0; i < filter->n_sections; i++){
+        dsps_biquad_gen_lpf_f32(&filter->coeffs[i * IIR_SOS_COEFFS], f, IIRButterworthQ(i, filter->n_sections));
+    }
+    IIRFilterQuantize(filter);
+}
+
+void IIRFilterDesignHiPass(iir_filter_t * filter, float sample_frec, float cut_frec){
+    float f = cut_frec / sample_frec;
+    for (uint8_t i = 0; i < filter->n_sections; i++){
+        dsps_biquad_gen_hpf_f32(&filter->coeffs[i * IIR_SOS_COEFFS], f, IIRButterworthQ(i, filter->n_sections));
+    }
+    IIRFilterQuantize(filter);
+}
+
+bool IIRFilterDesignBandPass(iir_filter_t * filter, float sample_frec, float low_cut_frec, filter_order_t hp_order, float high_cut_frec, filter_order_t lp_order, float notch_frec){
+    uint8_t hp_sections = hp_order / 2;
+    uint8_t lp_sections = lp_order / 2;
+    if (filter->n_sections != IIR_BAND_PASS_SECTIONS(hp_order, lp_order, notch_frec > 0)){
+        return false;
+    }
+    float * coeffs = filter->coeffs;
+    for (uint8_t i = 0; i < hp_sections; i++){
+        dsps_biquad_gen_hpf_f32(coeffs, low_cut_frec / sample_frec, IIRButterworthQ(i, hp_sections));
+        coeffs += IIR_SOS_COEFFS;
+    }
+    for (uint8_t i = 0; i < lp_sections; i++){
+        dsps_biquad_gen_lpf_f32(coeffs, high_cut_frec / sample_frec, IIRButterworthQ(i, lp_sections));
+        coeffs += IIR_SOS_COEFFS;
+    }
+    if (notch_frec > 0){
+        dsps_biquad_gen_notch_f32(coeffs, notch_frec / sample_frec, NOTCH_GAIN, NOTCH_Q);
+    }
+    IIRFilterQuantize(filter);
+    return true;
+}
+
+void IIRFilterProcess(iir_filter_t * filter, const float * input_signal, float * output_signal, uint16_t n_frames){
+    uint8_t n_sections = filter->n_sections;
+    uint8_t n_channels = filter->n_channels;
+    if (filter->format != IIR_FLOAT){
+        return;
+    }
+    for (uint16_t i = 0; i < n_frames; i++){
+        float * delay = filter->delay;
+        for (uint8_t ch = 0; ch < n_channels; ch++){
+            *output_signal++ = IIRCascadeStep(filter->coeffs, delay, n_sections, *input_signal++);
+            delay += IIR_SOS_DELAY * n_sections;
+        }
+    }
+}
+
+void IIRFilterProcessQ15(iir_filter_t * filter, const int16_t * input_signal, int16_t * output_signal, uint16_t n_frames){
+    uint8_t n_sections = filter->n_sections;
+    uint8_t n_channels = filter->n_channels;
+    if (filter->format != IIR_Q15){
+        return;
+    }
+    for (uint16_t i = 0; i < n_frames; i++){
+        int16_t * delay = filter->delay_q15;
+        for (uint8_t ch = 0; ch < n_channels; ch++){
+            *output_signal++ = IIRCascadeStepQ15(filter->coeffs_q, delay, n_sections, *input_signal++);
+            delay += IIR_SOS_DELAY_Q15 * n_sections;
+        }
+    }
+}
+
+float IRAM_ATTR IIRFilterSample(iir_filter_t * filter, uint8_t channel, float input){
+    if ((filter->format != IIR_FLOAT) || (channel >= filter->n_channels)){
+        return input;
+    }
+    float * delay = &filter->delay[channel * filter->n_sections * IIR_SOS_DELAY];
+    return IIRCascadeStep(filter->coeffs, delay, filter->n_sections, input);
+}
+
+int16_t IRAM_ATTR IIRFilterSampleInt16(iir_filter_t * filter, uint8_t channel, int16_t input){
+    if (channel >= filter->n_channels){
+        return input;
+    }
+    if (filter->format == IIR_Q15){
+        int16_t * delay = &filter->delay_q15[channel * filter->n_sections * IIR_SOS_DELAY_Q15];
+        return IIRCascadeStepQ15(filter->coeffs_q, delay, filter->n_sections, input);
+    }
+    float * delay = &filter->delay[channel * filter->n_sections * IIR_SOS_DELAY];
+    float output = IIRCascadeStep(filter->coeffs, delay, filter->n_sections, input);
+    if (output >= Q15_MAX){
+        return Q15_MAX;
+    }
+    else if (output <= Q15_MIN){
+        return Q15_MIN;
+    }
+    // Rounding without library calls, which could be placed in flash
+    return (int16_t)(output + ((output >= 0) ? 0.5f : -0.5f));
+}
+
+void IIRFilterReset(iir_filter_t * filter){
+    if (filter->format == IIR_Q15){
+        memset(filter->delay_q15, 0, IIR_DELAY_Q15_LENGHT(filter->n_sections, filter->n_channels) * sizeof(int16_t));
+    }
+    else{
+        memset(filter->delay, 0, IIR_DELAY_LENGHT(filter->n_sections, filter->n_channels) * sizeof(float));
     }
 }
 
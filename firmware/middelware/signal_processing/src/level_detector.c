@@ -0,0 +1,471 @@
+/**
+ * @file level_detector.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2023
+ * 
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stddef.h>
+#include <math.h>
+#include "level_detector.h"
+/*==================[macros and definitions]=================================*/
+#define Q15_ONE             (1 << 15)
+#define FRAC_BITS           16      /*!< Fractional bits of the 16 bits detectors state */
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+/**
+ * @brief Averaging coefficient of a first order low pass
+ * 
+ * @param sample_freq   Sample frequency, in Hz
+ * @param time_ms       Time constant, in ms (0 for a coefficient of 1)
+ * @return float        Coefficient (0 to 1)
+ */
+static float LevelAlpha(float sample_freq, float time_ms);
+
+/**
+ * @brief Averaging coefficient of a first order low pass, in Q15 (at least 1)
+ * 
+ * @param sample_freq   Sample frequency, in Hz
+ * @param time_ms       Time constant, in ms (0 for a coefficient of 1)
+ * @return int32_t      Coefficient (1 to 32768)
+ */
+static int32_t LevelAlphaQ15(float sample_freq, float time_ms);
+
+/**
+ * @brief Rounded integer square root
+ * 
+ * @param value         Value
+ * @return uint16_t     Square root of value, rounded to the nearest integer
+ */
+static uint16_t LevelSqrt(uint32_t value);
+
+/**
+ * @brief Mean square value of a RMS detector
+ * 
+ * In block mode the detector keeps the sum of the last block: the division is
+ * done here, when the level is read, and not once per block.
+ * 
+ * @param rms           Pointer to the detector
+ * @return float        Mean square value
+ */
+static inline float LevelMeanSquare(const level_rms_t * rms);
+
+/**
+ * @brief Mean square value of a 16 bits RMS detector (see LevelMeanSquare())
+ * 
+ * @param rms           Pointer to the detector
+ * @return int64_t      Mean square value, with FRAC_BITS fractional bits
+ */
+static inline int64_t LevelMeanSquareQ15(const level_rms_q15_t * rms);
+
+/**
+ * @brief RMS detector step (mean square update)
+ * 
+ * @param rms           Pointer to the detector
+ * @param sample        New sample
+ * @return true         New RMS value
+ * @return false        No new RMS value
+ */
+static inline bool LevelRMSStep(level_rms_t * rms, float sample);
+
+/**
+ * @brief 16 bits RMS detector step (mean square update)
+ * 
+ * @param rms           Pointer to the detector
+ * @param sample        New sample
+ * @return true         New RMS value
+ * @return false        No new RMS value
+ */
+static inline bool LevelRMSStepQ15(level_rms_q15_t * rms, int16_t sample);
+
+/**
+ * @brief Envelope detector step
+ * 
+ * @param env           Pointer to the detector
+ * @param sample        New sample
+ */
+static inline void LevelEnvelopeStep(level_envelope_t * env, float sample);
+
+/**
+ * @brief 16 bits envelope detector step
+ * 
+ * @param env           Pointer to the detector
+ * @param sample        New sample
+ */
+static inline void LevelEnvelopeStepQ15(level_envelope_q15_t * env, int16_t sample);
+
+/**
+ * @brief Crest factor detector step
+ * 
+ * @param crest         Pointer to the detector
+ * @param sample        New sample
+ * @return true         A block is complete
+ * @return false        No new crest factor
+ */
+static inline bool LevelCrestStep(level_crest_t * crest, float sample);
+
+/**
+ * @brief 16 bits crest factor detector step
+ * 
+ * @param crest         Pointer to the detector
+ * @param sample        New sample
+ * @return true         A block is complete
+ * @return false        No new crest factor
+ */
+static inline bool LevelCrestStepQ15(level_crest_q15_t * crest, int16_t sample);
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+static float LevelAlpha(float sample_freq, float time_ms){
+    if (time_ms == 0){
+        return 1.0f;
+    }
+    return 1.0f - expf(-1000.0f / (time_ms * sample_freq));
+}
+
+static int32_t LevelAlphaQ15(float sample_freq, float time_ms){
+    int32_t alpha = (int32_t)lroundf(LevelAlpha(sample_freq, time_ms) * Q15_ONE);
+    return (alpha < 1) ? 1 : alpha;
+}
+
+static uint16_t LevelSqrt(uint32_t value){
+    uint32_t root = 0;
+    uint32_t bit = 1UL << 30;
+    while (bit > value){
+        bit >>= 2;
+    }
+    while (bit != 0){
+        if (value >= root + bit){
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else{
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    // value is now the remainder: round up if it is above root (sqrt >= root + 0.5)
+    if (value > root){
+        root++;
+    }
+    return (root > UINT16_MAX) ? UINT16_MAX : (uint16_t)root;
+}
+
+static inline float LevelMeanSquare(const level_rms_t * rms){
+    return (rms->block_lenght == 0) ? rms->mean_square : rms->mean_square / rms->block_lenght;
+}
+
+static inline int64_t LevelMeanSquareQ15(const level_rms_q15_t * rms){
+    if (rms->block_lenght == 0){
+        return rms->mean_square;
+    }
+    return (int64_t)(((uint64_t)rms->mean_square << FRAC_BITS) / rms->block_lenght);
+}
+
+static inline bool LevelRMSStep(level_rms_t * rms, float sample){
+    float squared = sample * sample;
+    if (rms->block_lenght == 0){
+        rms->mean_square += rms->alpha * (squared - rms->mean_square);
+        return true;
+    }
+    rms->sum += squared;
+    if (++rms->count < rms->block_lenght){
+        return false;
+    }
+    rms->mean_square = rms->sum;
+    rms->sum = 0;
+    rms->count = 0;
+    return true;
+}
+
+static inline bool LevelRMSStepQ15(level_rms_q15_t * rms, int16_t sample){
+    uint32_t squared = (uint32_t)((int32_t)sample * sample);
+    if (rms->block_lenght == 0){
+        int64_t target = (int64_t)squared << FRAC_BITS;
+        rms->mean_square += ((target - rms->mean_square) * rms->alpha) >> 15;
+        return true;
+    }
+    rms->sum += squared;
+    if (++rms->count < rms->block_lenght){
+        return false;
+    }
+    rms->mean_square = (int64_t)rms->sum;
+    rms->sum = 0;
+    rms->count = 0;
+    return true;
+}
+
+static inline void LevelEnvelopeStep(level_envelope_t * env, float sample){
+    float magnitude = fabsf(sample);
+    if (magnitude >= env->envelope){
+        env->envelope += env->attack * (magnitude - env->envelope);
+        env->hold_count = env->hold;
+    }
+    else if (env->hold_count > 0){
+        env->hold_count--;
+    }
+    else{
+        env->envelope += env->release * (magnitude - env->envelope);
+    }
+}
+
+static inline void LevelEnvelopeStepQ15(level_envelope_q15_t * env, int16_t sample){
+    // |-32768| is taken as 32767 so the magnitude fits with its fractional bits
+    int32_t magnitude = (sample < -INT16_MAX) ? INT16_MAX : ((sample < 0) ? -sample : sample);
+    int32_t target = magnitude << FRAC_BITS;
+    if (target >= env->envelope){
+        env->envelope += (int32_t)(((int64_t)(target - env->envelope) * env->attack) >> 15);
+        env->hold_count = env->hold;
+    }
+    else if (env->hold_count > 0){
+        env->hold_count--;
+    }
+    else{
+        env->envelope += (int32_t)(((int64_t)(target - env->envelope) * env->release) >> 15);
+    }
+}
+
+static inline bool LevelCrestStep(level_crest_t * crest, float sample){
+    float magnitude = fabsf(sample);
+    if (magnitude > crest->peak){
+        crest->peak = magnitude;
+    }
+    if (!LevelRMSStep(&crest->rms, sample)){
+        return false;
+    }
+    crest->block_peak = crest->peak;
+    crest->peak = 0;
+    return true;
+}
+
+static inline bool LevelCrestStepQ15(level_crest_q15_t * crest, int16_t sample){
+    uint16_t magnitude = (uint16_t)((sample < 0) ? -(int32_t)sample : sample);
+    if (magnitude > crest->peak){
+        crest->peak = magnitude;
+    }
+    if (!LevelRMSStepQ15(&crest->rms, sample)){
+        return false;
+    }
+    crest->block_peak = crest->peak;
+    crest->peak = 0;
+    return true;
+}
+
+/*==================[external functions definition]==========================*/
+bool LevelRMSInit(level_rms_t * rms, uint16_t block_lenght){
+    if ((rms == NULL) || (block_lenght == 0)){
+        return false;
+    }
+    rms->alpha = 0;
+    rms->block_lenght = block_lenght;
+    LevelRMSReset(rms);
+    return true;
+}
+
+bool LevelRMSInitExp(level_rms_t * rms, float sample_freq, float time_ms){
+    if ((rms == NULL) || !(sample_freq > 0) || !(time_ms > 0)){
+        return false;
+    }
+    rms->alpha = LevelAlpha(sample_freq, time_ms);
+    rms->block_lenght = 0;
+    LevelRMSReset(rms);
+    return true;
+}
+
+bool LevelRMSSample(level_rms_t * rms, float sample){
+    return LevelRMSStep(rms, sample);
+}
+
+bool LevelRMSBlock(level_rms_t * rms, const float * signal, uint16_t signal_lenght){
+    bool updated = false;
+    for (uint16_t i = 0; i < signal_lenght; i++){
+        updated |= LevelRMSStep(rms, signal[i]);
+    }
+    return updated;
+}
+
+float LevelRMSGet(const level_rms_t * rms){
+    return sqrtf(LevelMeanSquare(rms));
+}
+
+void LevelRMSReset(level_rms_t * rms){
+    rms->mean_square = 0;
+    rms->sum = 0;
+    rms->count = 0;
+}
+
+bool LevelRMSInitQ15(level_rms_q15_t * rms, uint16_t block_lenght){
+    if ((rms == NULL) || (block_lenght == 0)){
+        return false;
+    }
+    rms->alpha = 0;
+    rms->block_lenght = block_lenght;
+    LevelRMSResetQ15(rms);
+    return true;
+}
+
+bool LevelRMSInitExpQ15(level_rms_q15_t * rms, float sample_freq, float time_ms){
+    if ((rms == NULL) || !(sample_freq > 0) || !(time_ms > 0)){
+        return false;
+    }
+    rms->alpha = LevelAlphaQ15(sample_freq, time_ms);
+    rms->block_lenght = 0;
+    LevelRMSResetQ15(rms);
+    return true;
+}
+
+bool LevelRMSSampleQ15(level_rms_q15_t * rms, int16_t sample){
+    return LevelRMSStepQ15(rms, sample);
+}
+
+bool LevelRMSBlockQ15(level_rms_q15_t * rms, const int16_t * signal, uint16_t signal_lenght){
+    bool updated = false;
+    for (uint16_t i = 0; i < signal_lenght; i++){
+        updated |= LevelRMSStepQ15(rms, signal[i]);
+    }
+    return updated;
+}
+
+uint16_t LevelRMSGetQ15(const level_rms_q15_t * rms){
+    int64_t mean_square = LevelMeanSquareQ15(rms) >> FRAC_BITS;
+    return LevelSqrt((mean_square > 0) ? (uint32_t)mean_square : 0);
+}
+
+void LevelRMSResetQ15(level_rms_q15_t * rms){
+    rms->mean_square = 0;
+    rms->sum = 0;
+    rms->count = 0;
+}
+
+bool LevelEnvelopeInit(level_envelope_t * env, float sample_freq, float attack_ms, float hold_ms, float release_ms){
+    if ((env == NULL) || !(sample_freq > 0) || !(attack_ms >= 0) || !(hold_ms >= 0) || !(release_ms >= 0)){
+        return false;
+    }
+    env->attack = LevelAlpha(sample_freq, attack_ms);
+    env->release = LevelAlpha(sample_freq, release_ms);
+    env->hold = (uint32_t)lroundf(hold_ms * sample_freq / 1000);
+    LevelEnvelopeReset(env);
+    return true;
+}
+
+void LevelEnvelopeSample(level_envelope_t * env, float sample){
+    LevelEnvelopeStep(env, sample);
+}
+
+void LevelEnvelopeBlock(level_envelope_t * env, const float * signal, uint16_t signal_lenght){
+    for (uint16_t i = 0; i < signal_lenght; i++){
+        LevelEnvelopeStep(env, signal[i]);
+    }
+}
+
+float LevelEnvelopeGet(const level_envelope_t * env){
+    return env->envelope;
+}
+
+void LevelEnvelopeReset(level_envelope_t * env){
+    env->envelope = 0;
+    env->hold_count = 0;
+}
+
+bool LevelEnvelopeInitQ15(level_envelope_q15_t * env, float sample_freq, float attack_ms, float hold_ms, float release_ms){
+    if ((env == NULL) || !(sample_freq > 0) || !(attack_ms >= 0) || !(hold_ms >= 0) || !(release_ms >= 0)){
+        return false;
+    }
+    env->attack = LevelAlphaQ15(sample_freq, attack_ms);
+    env->release = LevelAlphaQ15(sample_freq, release_ms);
+    env->hold = (uint32_t)lroundf(hold_ms * sample_freq / 1000);
+    LevelEnvelopeResetQ15(env);
+    return true;
+}
+
+void LevelEnvelopeSampleQ15(level_envelope_q15_t * env, int16_t sample){
+    LevelEnvelopeStepQ15(env, sample);
+}
+
+void LevelEnvelopeBlockQ15(level_envelope_q15_t * env, const int16_t * signal, uint16_t signal_lenght){
+    for (uint16_t i = 0; i < signal_lenght; i++){
+        LevelEnvelopeStepQ15(env, signal[i]);
+    }
+}
+
+uint16_t LevelEnvelopeGetQ15(const level_envelope_q15_t * env){
+    return (uint16_t)((env->envelope + (1 << (FRAC_BITS - 1))) >> FRAC_BITS);
+}
+
+void LevelEnvelopeResetQ15(level_envelope_q15_t * env){
+    env->envelope = 0;
+    env->hold_count = 0;
+}
+
+bool LevelCrestInit(level_crest_t * crest, uint16_t block_lenght){
+    if ((crest == NULL) || !LevelRMSInit(&crest->rms, block_lenght)){
+        return false;
+    }
+    LevelCrestReset(crest);
+    return true;
+}
+
+bool LevelCrestSample(level_crest_t * crest, float sample){
+    return LevelCrestStep(crest, sample);
+}
+
+bool LevelCrestBlock(level_crest_t * crest, const float * signal, uint16_t signal_lenght){
+    bool updated = false;
+    for (uint16_t i = 0; i < signal_lenght; i++){
+        updated |= LevelCrestStep(crest, signal[i]);
+    }
+    return updated;
+}
+
+float LevelCrestGet(const level_crest_t * crest){
+    float rms = LevelRMSGet(&crest->rms);
+    return (rms > 0) ? crest->block_peak / rms : 0;
+}
+
+void LevelCrestReset(level_crest_t * crest){
+    LevelRMSReset(&crest->rms);
+    crest->peak = 0;
+    crest->block_peak = 0;
+}
+
+bool LevelCrestInitQ15(level_crest_q15_t * crest, uint16_t block_lenght){
+    if ((crest == NULL) || !LevelRMSInitQ15(&crest->rms, block_lenght)){
+        return false;
+    }
+    LevelCrestResetQ15(crest);
+    return true;
+}
+
+bool LevelCrestSampleQ15(level_crest_q15_t * crest, int16_t sample){
+    return LevelCrestStepQ15(crest, sample);
+}
+
+bool LevelCrestBlockQ15(level_crest_q15_t * crest, const int16_t * signal, uint16_t signal_lenght){
+    bool updated = false;
+    for (uint16_t i = 0; i < signal_lenght; i++){
+        updated |= LevelCrestStepQ15(crest, signal[i]);
+    }
+    return updated;
+}
+
+float LevelCrestGetQ15(const level_crest_q15_t * crest){
+    // Crest factor is read once per block: the mean square is used without the integer square root
+    float mean_square = (float)LevelMeanSquareQ15(&crest->rms) / (1 << FRAC_BITS);
+    return (mean_square > 0) ? crest->block_peak / sqrtf(mean_square) : 0;
+}
+
+void LevelCrestResetQ15(level_crest_q15_t * crest){
+    LevelRMSResetQ15(&crest->rms);
+    crest->peak = 0;
+    crest->block_peak = 0;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,254 @@
+/**
+ * @file nlms_filter.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2023
+ * 
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include <math.h>
+#include "nlms_filter.h"
+#include "dsps_dotprod.h"
+/*==================[macros and definitions]=================================*/
+#define SINE_BITS           8       /*!< log2 of the sine table lenght */
+#define SINE_LENGHT         (1 << SINE_BITS)
+#define QUARTER_PERIOD      (1UL << 30)     /*!< 90 degrees of phase (2^32 = one period) */
+#define EPSILON             1e-6f   /*!< Regularization per weight (float filters) */
+#define EPSILON_Q15         16      /*!< Regularization per weight (16 bits filters), in LSB^2 */
+#define MU_Q15_ONE          (1 << 15)
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+/**
+ * @brief Sine of a phase, from the table with linear interpolation
+ * 
+ * @param phase         Phase (2^32 = one period)
+ * @return int32_t      Sine, Q15 (-32767 to 32767)
+ */
+static int32_t NLMSFilterSine(uint32_t phase);
+
+/**
+ * @brief Validate the mains canceller parameters and fill the sine table
+ * 
+ * @param sample_freq   Sample frequency, in Hz
+ * @param mains_frec    Mains frequency, in Hz
+ * @param harmonics     Number of harmonics
+ * @param mu            Step size
+ * @param phase_step    Pointer to store the phase increment per sample
+ * @return true         Valid parameters
+ * @return false        Invalid parameters
+ */
+static bool NLMSFilterMainsSetup(float sample_freq, float mains_frec, uint8_t harmonics, float mu, uint32_t * phase_step);
+/*==================[internal data definition]===============================*/
+static int16_t sine_table[SINE_LENGHT + 1];
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+static int32_t NLMSFilterSine(uint32_t phase){
+    uint32_t index = phase >> (32 - SINE_BITS);
+    int32_t frac = (int32_t)((phase >> (16 - SINE_BITS)) & 0xFFFF);
+    int32_t a = sine_table[index];
+    return a + (((sine_table[index + 1] - a) * frac) >> 16);
+}
+
+static bool NLMSFilterMainsSetup(float sample_freq, float mains_frec, uint8_t harmonics, float mu, uint32_t * phase_step){
+    if (!(sample_freq > 0) || !(mains_frec > 0) || (harmonics == 0) || (harmonics > NLMS_MAX_HARMONICS) ||
+        !(harmonics * mains_frec < sample_freq / 2) || !(mu > 0) || !(mu < 2)){
+        return false;
+    }
+    // All the mains cancellers share the same table
+    for (uint16_t i = 0; i <= SINE_LENGHT; i++){
+        sine_table[i] = (int16_t)lroundf(INT16_MAX * sinf(2 * M_PI * i / SINE_LENGHT));
+    }
+    *phase_step = (uint32_t)llroundf(mains_frec / sample_freq * 4294967296.0f);
+    return true;
+}
+
+/*==================[external functions definition]==========================*/
+bool NLMSFilterInit(nlms_filter_t * filter, float * weights, float * delay, uint16_t lenght, float mu){
+    if ((filter == NULL) || (weights == NULL) || (delay == NULL) || (lenght == 0) || !(mu > 0) || !(mu < 2)){
+        return false;
+    }
+    filter->weights = weights;
+    filter->delay = delay;
+    filter->lenght = lenght;
+    filter->mu = mu;
+    filter->epsilon = EPSILON * lenght;
+    filter->harmonics = 0;
+    filter->phase_step = 0;
+    NLMSFilterReset(filter);
+    return true;
+}
+
+bool NLMSFilterInitMains(nlms_filter_t * filter, float * weights, float * delay, float sample_freq, float mains_frec, uint8_t harmonics, float mu){
+    if ((filter == NULL) || (weights == NULL) || (delay == NULL) ||
+        !NLMSFilterMainsSetup(sample_freq, mains_frec, harmonics, mu, &filter->phase_step)){
+        return false;
+    }
+    filter->weights = weights;
+    filter->delay = delay;
+    filter->lenght = NLMS_MAINS_LENGHT(harmonics);
+    filter->mu = mu;
+    filter->epsilon = EPSILON * filter->lenght;
+    filter->harmonics = harmonics;
+    NLMSFilterReset(filter);
+    return true;
+}
+
+float NLMSFilterSample(nlms_filter_t * filter, float input, float reference){
+    const float * x;
+    if (filter->harmonics == 0){
+        // Circular buffer written twice: the window starting at pos is always contiguous
+        float oldest = filter->delay[filter->pos];
+        filter->delay[filter->pos] = reference;
+        filter->delay[filter->pos + filter->lenght] = reference;
+        if (++filter->pos == filter->lenght){
+            // Once per lenght samples the running sum is replaced by the exact one, so its
+            // rounding errors can't build up (e.g. small samples after large ones)
+            filter->pos = 0;
+            dsps_dotprod_f32(filter->delay, filter->delay, &filter->power, filter->lenght);
+        }
+        else{
+            filter->power += reference * reference - oldest * oldest;
+            if (filter->power < 0){
+                filter->power = 0;
+            }
+        }
+        x = &filter->delay[filter->pos];
+    }
+    else{
+        filter->power = 0;
+        for (uint8_t h = 0; h < filter->harmonics; h++){
+            uint32_t phase = filter->phase * (h + 1);
+            float s = NLMSFilterSine(phase) * (1.0f / INT16_MAX);
+            float c = NLMSFilterSine(phase + QUARTER_PERIOD) * (1.0f / INT16_MAX);
+            filter->delay[2 * h] = s;
+            filter->delay[2 * h + 1] = c;
+            filter->power += s * s + c * c;
+        }
+        filter->phase += filter->phase_step;
+        x = filter->delay;
+    }
+    float estimate;
+    dsps_dotprod_f32(x, filter->weights, &estimate, filter->lenght);
+    float error = input - estimate;
+    float step = filter->mu * error / (filter->power + filter->epsilon);
+    for (uint16_t i = 0; i < filter->lenght; i++){
+        filter->weights[i] += step * x[i];
+    }
+    return error;
+}
+
+void NLMSFilterBlock(nlms_filter_t * filter, const float * input, const float * reference, float * output, uint16_t signal_lenght){
+    for (uint16_t i = 0; i < signal_lenght; i++){
+        output[i] = NLMSFilterSample(filter, input[i], (reference != NULL) ? reference[i] : 0);
+    }
+}
+
+void NLMSFilterReset(nlms_filter_t * filter){
+    memset(filter->weights, 0, filter->lenght * sizeof(float));
+    memset(filter->delay, 0, ((filter->harmonics == 0) ? NLMS_DELAY_LENGHT(filter->lenght) : filter->lenght) * sizeof(float));
+    filter->power = 0;
+    filter->pos = 0;
+    filter->phase = 0;
+}
+
+bool NLMSFilterInitQ15(nlms_filter_q15_t * filter, int16_t * weights, int32_t * weights_acc, int16_t * delay, uint16_t lenght, float mu){
+    if ((filter == NULL) || (weights == NULL) || (weights_acc == NULL) || (delay == NULL) || (lenght == 0) ||
+        !(mu > 0) || !(mu < 2)){
+        return false;
+    }
+    filter->weights = weights;
+    filter->weights_acc = weights_acc;
+    filter->delay = delay;
+    filter->lenght = lenght;
+    filter->mu = (int32_t)lroundf(mu * MU_Q15_ONE);
+    filter->epsilon = (int64_t)EPSILON_Q15 * lenght;
+    filter->harmonics = 0;
+    filter->phase_step = 0;
+    NLMSFilterResetQ15(filter);
+    return true;
+}
+
+bool NLMSFilterInitMainsQ15(nlms_filter_q15_t * filter, int16_t * weights, int32_t * weights_acc, int16_t * delay,
+                            float sample_freq, float mains_frec, uint8_t harmonics, float mu){
+    if ((filter == NULL) || (weights == NULL) || (weights_acc == NULL) || (delay == NULL) ||
+        !NLMSFilterMainsSetup(sample_freq, mains_frec, harmonics, mu, &filter->phase_step)){
+        return false;
+    }
+    filter->weights = weights;
+    filter->weights_acc = weights_acc;
+    filter->delay = delay;
+    filter->lenght = NLMS_MAINS_LENGHT(harmonics);
+    filter->mu = (int32_t)lroundf(mu * MU_Q15_ONE);
+    filter->epsilon = (int64_t)EPSILON_Q15 * filter->lenght;
+    filter->harmonics = harmonics;
+    NLMSFilterResetQ15(filter);
+    return true;
+}
+
+int16_t NLMSFilterSampleQ15(nlms_filter_q15_t * filter, int16_t input, int16_t reference){
+    const int16_t * x;
+    if (filter->harmonics == 0){
+        int32_t oldest = filter->delay[filter->pos];
+        filter->delay[filter->pos] = reference;
+        filter->delay[filter->pos + filter->lenght] = reference;
+        if (++filter->pos == filter->lenght){
+            filter->pos = 0;
+        }
+        filter->power += (int32_t)reference * reference - oldest * oldest;
+        x = &filter->delay[filter->pos];
+    }
+    else{
+        filter->power = 0;
+        for (uint8_t h = 0; h < filter->harmonics; h++){
+            uint32_t phase = filter->phase * (h + 1);
+            int32_t s = NLMSFilterSine(phase);
+            int32_t c = NLMSFilterSine(phase + QUARTER_PERIOD);
+            filter->delay[2 * h] = (int16_t)s;
+            filter->delay[2 * h + 1] = (int16_t)c;
+            filter->power += s * s + c * c;
+        }
+        filter->phase += filter->phase_step;
+        x = filter->delay;
+    }
+    int16_t estimate;
+    dsps_dotprod_s16(x, filter->weights, &estimate, filter->lenght, 0);
+    int32_t error = (int32_t)input - estimate;
+    error = (error > INT16_MAX) ? INT16_MAX : ((error < INT16_MIN) ? INT16_MIN : error);
+
+    // Q31 weight change per unit of reference: mu * error * 2^31 / power, with mu in Q15
+    int64_t step = ((int64_t)filter->mu * error * (1 << 16)) / (filter->power + filter->epsilon);
+    step = (step > INT32_MAX) ? INT32_MAX : ((step < -INT32_MAX) ? -INT32_MAX : step);
+    for (uint16_t i = 0; i < filter->lenght; i++){
+        int64_t weight = filter->weights_acc[i] + step * x[i];
+        weight = (weight > INT32_MAX) ? INT32_MAX : ((weight < -INT32_MAX) ? -INT32_MAX : weight);
+        filter->weights_acc[i] = (int32_t)weight;
+        int32_t weight_q15 = (int32_t)((weight + (1 << 15)) >> 16);
+        filter->weights[i] = (int16_t)((weight_q15 > INT16_MAX) ? INT16_MAX : weight_q15);
+    }
+    return (int16_t)error;
+}
+
+void NLMSFilterBlockQ15(nlms_filter_q15_t * filter, const int16_t * input, const int16_t * reference, int16_t * output, uint16_t signal_lenght){
+    for (uint16_t i = 0; i < signal_lenght; i++){
+        output[i] = NLMSFilterSampleQ15(filter, input[i], (reference != NULL) ? reference[i] : 0);
+    }
+}
+
+void NLMSFilterResetQ15(nlms_filter_q15_t * filter){
+    memset(filter->weights, 0, filter->lenght * sizeof(int16_t));
+    memset(filter->weights_acc, 0, filter->lenght * sizeof(int32_t));
+    memset(filter->delay, 0, ((filter->harmonics == 0) ? NLMS_DELAY_LENGHT(filter->lenght) : filter->lenght) * sizeof(int16_t));
+    filter->power = 0;
+    filter->pos = 0;
+    filter->phase = 0;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,250 @@
+/**
+ * @file qrs_detector.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-16
+ * 
+ * @copyright Copyright (c) 2023
+ * 
+ */
+
+/*==================[inclusions]=============================================*/
+#include <string.h>
+#include <stdlib.h>
+#include "qrs_detector.h"
+/*==================[macros and definitions]=================================*/
+#define BAND_PASS_LOW       5.0f    /*!< Band pass lower cut-off frequency (Hz) */
+#define BAND_PASS_HIGH      15.0f   /*!< Band pass upper cut-off frequency (Hz) */
+#define SQUARE_SHIFT        8       /*!< Squared derivative is scaled by 2^-8, so a 150 ms window fits in 32 bits */
+#define LEARN_TIME_MS       2000    /*!< Learning phase of the thresholds */
+#define RELEARN_TIME_MS     3000    /*!< Time without beats after which thresholds are learned again */
+#define REFRACTORY_MS       200     /*!< Minimum time between R peaks */
+#define T_WAVE_MS           360     /*!< Time after an R peak where a peak can be a T wave */
+#define SEARCH_BACK_RATIO   166     /*!< Search back after 166 % of the average RR interval */
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+/**
+ * @brief Start the learning phase of the thresholds
+ * 
+ * @param det           Pointer to the detector
+ */
+static void QRSDetectorLearn(qrs_detector_t * det);
+
+/**
+ * @brief Register a detected beat and update the RR intervals
+ * 
+ * @param det           Pointer to the detector
+ * @param r_peak        Sample of the R peak
+ * @param slope         Highest derivative magnitude of the QRS
+ * @param beat          Pointer to store the beat (can be NULL)
+ */
+static void QRSDetectorBeat(qrs_detector_t * det, uint32_t r_peak, uint16_t slope, qrs_beat_t * beat);
+
+/**
+ * @brief Classify a peak of the integrated signal as QRS or noise
+ * 
+ * @param det           Pointer to the detector
+ * @param beat          Pointer to store the beat (can be NULL)
+ * @return true         The peak is a QRS
+ * @return false        The peak is noise (or a T wave)
+ */
+static bool QRSDetectorPeak(qrs_detector_t * det, qrs_beat_t * beat);
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+static void QRSDetectorLearn(qrs_detector_t * det){
+    det->learn_end = det->n + (uint32_t)det->sample_freq * LEARN_TIME_MS / 1000;
+    det->learn_sum = 0;
+    det->learn_max = 0;
+    det->noise = 0;
+    // RR intervals are not valid across a learning phase
+    memset(det->rr, 0, sizeof(det->rr));
+    det->rr_sum = 0;
+    det->rr_index = 0;
+    det->rr_count = 0;
+    det->beat_found = false;
+}
+
+static void QRSDetectorBeat(qrs_detector_t * det, uint32_t r_peak, uint16_t slope, qrs_beat_t * beat){
+    uint32_t rr = 0;
+    if (det->beat_found){
+        rr = r_peak - det->last_r;
+        det->rr_sum += rr - det->rr[det->rr_index];
+        det->rr[det->rr_index] = rr;
+        det->rr_index = (det->rr_index + 1) % QRS_RR_AVERAGE;
+        if (det->rr_count < QRS_RR_AVERAGE){
+            det->rr_count++;
+        }
+    }
+    det->beat_found = true;
+    det->last_r = r_peak;
+    det->last_slope = slope;
+    det->noise = 0;
+    if (beat != NULL){
+        beat->r_peak = r_peak;
+        beat->rr = rr;
+        beat->heart_rate = (rr > 0) ? (uint16_t)((60UL * det->sample_freq + rr / 2) / rr) : 0;
+    }
+}
+
+static bool QRSDetectorPeak(qrs_detector_t * det, qrs_beat_t * beat){
+    int32_t peak = (int32_t)det->candidate;
+    bool qrs = false;
+    bool refractory = det->beat_found && (det->candidate_r - det->last_r < det->refractory);
+    if ((peak > det->threshold) && !refractory){
+        // A peak close to the last QRS with half its slope is a T wave
+        bool t_wave = det->beat_found && (det->candidate_r - det->last_r < det->t_wave) &&
+                      (det->candidate_slope < det->last_slope / 2);
+        qrs = !t_wave;
+    }
+    if (qrs){
+        det->spki += (peak - det->spki) >> 3;
+        QRSDetectorBeat(det, det->candidate_r, det->candidate_slope, beat);
+    }
+    else{
+        det->npki += (peak - det->npki) >> 3;
+        // Keep the highest noise peak for the search back
+        if (!refractory && (peak > det->threshold / 2) && (det->candidate > det->noise)){
+            det->noise = det->candidate;
+            det->noise_r = det->candidate_r;
+            det->noise_slope = det->candidate_slope;
+        }
+    }
+    det->threshold = det->npki + ((det->spki - det->npki) >> 2);
+    return qrs;
+}
+
+/*==================[external functions definition]==========================*/
+bool QRSDetectorInit(qrs_detector_t * det, uint16_t sample_freq, float notch_frec){
+    if ((det == NULL) || (sample_freq < QRS_MIN_SAMPLE_FREQ) || (sample_freq > QRS_MAX_SAMPLE_FREQ)){
+        return false;
+    }
+    if ((notch_frec < 0) || (notch_frec >= sample_freq / 2)){
+        return false;
+    }
+    uint8_t n_sections = IIR_BAND_PASS_SECTIONS(ORDER_2, ORDER_2, notch_frec > 0);
+    if (!IIRFilterInitQ15(&det->band_pass, det->coeffs, det->coeffs_q, det->delay_q15, n_sections, 1)){
+        return false;
+    }
+    IIRFilterDesignBandPass(&det->band_pass, sample_freq, BAND_PASS_LOW, ORDER_2, BAND_PASS_HIGH, ORDER_2, notch_frec);
+    det->sample_freq = sample_freq;
+    det->deriv_step = sample_freq / 200;
+    det->window = (uint16_t)((uint32_t)sample_freq * 150 / 1000);
+    det->refractory = (uint16_t)((uint32_t)sample_freq * REFRACTORY_MS / 1000);
+    det->t_wave = (uint16_t)((uint32_t)sample_freq * T_WAVE_MS / 1000);
+    QRSDetectorReset(det);
+    return true;
+}
+
+bool QRSDetectorProcess(qrs_detector_t * det, int16_t sample, qrs_beat_t * beat){
+    uint32_t n = det->n;
+    det->n++;
+    // Band pass, starting from the first sample so the filter does not see a step
+    if (n == 0){
+        det->offset = sample;
+    }
+    int32_t input = (int32_t)sample - det->offset;
+    input = (input > INT16_MAX) ? INT16_MAX : ((input < INT16_MIN) ? INT16_MIN : input);
+    int16_t filtered = IIRFilterSampleInt16(&det->band_pass, 0, (int16_t)input);
+
+    // Five point derivative: 2 x[n] + x[n-1] - x[n-3] - 2 x[n-4] (taps 5 ms apart at 200 Hz)
+    uint8_t lenght = 4 * det->deriv_step + 1;
+    uint8_t index = det->filtered_index;
+    det->filtered[index] = filtered;
+    det->filtered_index = (index + 1 == lenght) ? 0 : index + 1;
+    int32_t deriv = 2 * filtered
+                    + det->filtered[(index + lenght - det->deriv_step) % lenght]
+                    - det->filtered[(index + lenght - 3 * det->deriv_step) % lenght]
+                    - 2 * det->filtered[(index + 1) % lenght];
+    deriv = (deriv > INT16_MAX) ? INT16_MAX : ((deriv < -INT16_MAX) ? -INT16_MAX : deriv);
+
+    // Squaring and moving window integration
+    uint32_t squared = (uint32_t)(deriv * deriv) >> SQUARE_SHIFT;
+    det->integral += squared - det->squared[det->squared_index];
+    det->squared[det->squared_index] = squared;
+    det->squared_index = (det->squared_index + 1 == det->window) ? 0 : det->squared_index + 1;
+    uint32_t integral = det->integral;
+
+    // R peak (highest band pass magnitude) and slope of the current peak
+    uint16_t magnitude = (uint16_t)abs(filtered);
+    if (magnitude > det->candidate_r_value){
+        det->candidate_r_value = magnitude;
+        det->candidate_r = n;
+    }
+    if ((uint16_t)abs(deriv) > det->candidate_slope){
+        det->candidate_slope = (uint16_t)abs(deriv);
+    }
+    if (integral > det->candidate){
+        det->candidate = integral;
+    }
+
+    // Learning phase: thresholds from the maximum and mean of the integrated signal
+    if (n < det->learn_end){
+        det->learn_sum += integral;
+        if (integral > det->learn_max){
+            det->learn_max = integral;
+        }
+        if (n + 1 == det->learn_end){
+            uint32_t learn_lenght = (uint32_t)det->sample_freq * LEARN_TIME_MS / 1000;
+            det->spki = (int32_t)(det->learn_max / 3);
+            det->npki = (int32_t)(det->learn_sum / learn_lenght / 2);
+            det->threshold = det->npki + ((det->spki - det->npki) >> 2);
+            det->candidate = 0;
+            det->candidate_r_value = 0;
+            det->candidate_slope = 0;
+            det->last_r = n;
+        }
+        return false;
+    }
+
+    bool found = false;
+    // The peak ends when the integrated signal falls to half its value
+    if ((det->candidate > 0) && (integral < det->candidate / 2)){
+        found = QRSDetectorPeak(det, beat);
+        det->candidate = 0;
+        det->candidate_r_value = 0;
+        det->candidate_slope = 0;
+    }
+    if (!found && det->beat_found && (det->rr_count > 0) && (det->noise > 0)){
+        // Search back: take the highest noise peak if the next beat takes too long
+        uint32_t rr_average = det->rr_sum / det->rr_count;
+        if (n - det->last_r > rr_average * SEARCH_BACK_RATIO / 100){
+            det->spki += ((int32_t)det->noise - det->spki) >> 2;
+            det->threshold = det->npki + ((det->spki - det->npki) >> 2);
+            QRSDetectorBeat(det, det->noise_r, det->noise_slope, beat);
+            found = true;
+        }
+    }
+    if (!found && (n - det->last_r > (uint32_t)det->sample_freq * RELEARN_TIME_MS / 1000)){
+        QRSDetectorLearn(det);
+    }
+    return found;
+}
+
+void QRSDetectorReset(qrs_detector_t * det){
+    IIRFilterReset(&det->band_pass);
+    memset(det->filtered, 0, sizeof(det->filtered));
+    memset(det->squared, 0, sizeof(det->squared));
+    det->integral = 0;
+    det->filtered_index = 0;
+    det->squared_index = 0;
+    det->n = 0;
+    det->spki = 0;
+    det->npki = 0;
+    det->threshold = 0;
+    det->candidate = 0;
+    det->candidate_r = 0;
+    det->candidate_r_value = 0;
+    det->candidate_slope = 0;
+    det->noise_slope = 0;
+    det->noise_r = 0;
+    det->last_slope = 0;
+    det->last_r = 0;
+    QRSDetectorLearn(det);
+}
+
+/*==================[end of file]============================================*/
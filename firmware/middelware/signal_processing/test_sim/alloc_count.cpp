@@ -0,0 +1,37 @@
+/* Replacement of the global operator new that counts the heap allocations of the C++ code */
+#include <stdlib.h>
+#include <new>
+
+#include "ekf_models.h"
+
+static uint32_t alloc_count;
+
+void *operator new(size_t size)
+{
+    alloc_count++;
+    void *p = malloc(size ? size : 1);
+    if (p == NULL) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void *operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void *p) noexcept
+{
+    free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+    free(p);
+}
+
+uint32_t AllocCount(void)
+{
+    return alloc_count;
+}
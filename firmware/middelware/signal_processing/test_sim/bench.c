@@ -0,0 +1,129 @@
+/* Timing, reporting and baseline comparison of the host benchmarks */
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "bench.h"
+
+#define MAX_RESULTS     256
+#define NAME_LENGHT     32
+
+typedef struct {
+    char suite[NAME_LENGHT];
+    char name[NAME_LENGHT];
+    uint32_t size;
+    char unit[NAME_LENGHT];
+    float ticks;
+} bench_result_t;
+
+static bench_result_t results[MAX_RESULTS];
+static int n_results;
+
+float BenchMeasure(bench_function_t function, void *context, uint32_t items_per_call)
+{
+    /* Warm up (caches, lazily generated tables) and calibrate the number of calls */
+    uint32_t calls = 1;
+    uint32_t ticks;
+    function(context);
+    do {
+        uint32_t start = dsp_get_cpu_cycle_count();
+        for (uint32_t i = 0; i < calls; i++) {
+            function(context);
+        }
+        ticks = dsp_get_cpu_cycle_count() - start;
+        if (ticks < BENCH_MIN_TICKS) {
+            calls *= 2;
+        }
+    } while (ticks < BENCH_MIN_TICKS);
+
+    float best = INFINITY;
+    for (int run = 0; run < BENCH_RUNS; run++) {
+        uint32_t start = dsp_get_cpu_cycle_count();
+        for (uint32_t i = 0; i < calls; i++) {
+            function(context);
+        }
+        ticks = dsp_get_cpu_cycle_count() - start;
+        best = fminf(best, (float)ticks / ((float)calls * items_per_call));
+    }
+    return best;
+}
+
+void BenchReport(const char *suite, const char *name, uint32_t size, const char *unit, float ticks_per_item)
+{
+    printf("%-8s %-24s %6u %10.2f %s/%-7s %10.2f M%s/s\n", suite, name, (unsigned)size, ticks_per_item,
+           TICKS_UNIT, unit, 1000.0f / ticks_per_item, unit);
+    if (n_results == MAX_RESULTS) {
+        return;
+    }
+    bench_result_t *result = &results[n_results++];
+    snprintf(result->suite, NAME_LENGHT, "%s", suite);
+    snprintf(result->name, NAME_LENGHT, "%s", name);
+    snprintf(result->unit, NAME_LENGHT, "%s", unit);
+    result->size = size;
+    result->ticks = ticks_per_item;
+}
+
+static const bench_result_t *BenchFind(const char *suite, const char *name, uint32_t size)
+{
+    for (int i = 0; i < n_results; i++) {
+        if (!strcmp(results[i].suite, suite) && !strcmp(results[i].name, name) && (results[i].size == size)) {
+            return &results[i];
+        }
+    }
+    return NULL;
+}
+
+int BenchFinish(const char *output, const char *baseline, float tolerance)
+{
+    printf("\n%i results\n", n_results);
+    if (output != NULL) {
+        FILE *file = fopen(output, "w");
+        if (file == NULL) {
+            printf("Can not write %s\n", output);
+            return 1;
+        }
+        fprintf(file, "suite,name,size,unit,%s_per_item\n", TICKS_UNIT);
+        for (int i = 0; i < n_results; i++) {
+            fprintf(file, "%s,%s,%u,%s,%.3f\n", results[i].suite, results[i].name, (unsigned)results[i].size,
+                    results[i].unit, results[i].ticks);
+        }
+        fclose(file);
+        printf("Results written to %s\n", output);
+    }
+    if (baseline == NULL) {
+        return 0;
+    }
+
+    FILE *file = fopen(baseline, "r");
+    if (file == NULL) {
+        printf("Can not read %s\n", baseline);
+        return 1;
+    }
+    int regressions = 0;
+    int compared = 0;
+    char line[4 * NAME_LENGHT];
+    printf("\nComparison with %s (tolerance %.0f %%)\n", baseline, tolerance);
+    while (fgets(line, sizeof(line), file) != NULL) {
+        char suite[NAME_LENGHT];
+        char name[NAME_LENGHT];
+        char unit[NAME_LENGHT];
+        unsigned size;
+        float ticks;
+        if (sscanf(line, "%31[^,],%31[^,],%u,%31[^,],%f", suite, name, &size, unit, &ticks) != 5) {
+            continue;
+        }
+        const bench_result_t *result = BenchFind(suite, name, size);
+        if (result == NULL) {
+            continue;
+        }
+        compared++;
+        float change = 100.0f * (result->ticks - ticks) / ticks;
+        if (change > tolerance) {
+            printf("SLOWER %-8s %-24s %6u %10.2f -> %10.2f (%+.0f %%)\n", suite, name, size, ticks, result->ticks, change);
+            regressions++;
+        }
+    }
+    fclose(file);
+    printf("%i results compared, %i regression(s)\n", compared, regressions);
+    return regressions;
+}
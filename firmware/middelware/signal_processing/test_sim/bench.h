@@ -0,0 +1,42 @@
+#ifndef BENCH_H_
+#define BENCH_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "test_sim.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Each measurement repeats the benchmarked function for at least BENCH_MIN_TICKS,
+ * BENCH_RUNS times, and keeps the fastest run (the least disturbed by the host) */
+#define BENCH_MIN_TICKS     10000000
+#define BENCH_RUNS          5
+
+typedef void (*bench_function_t)(void *context);
+
+/* Time function(context), that processes items_per_call items, and return ticks per item */
+float BenchMeasure(bench_function_t function, void *context, uint32_t items_per_call);
+
+/* Add a result to the report: suite and name identify it in baseline files */
+void BenchReport(const char *suite, const char *name, uint32_t size, const char *unit, float ticks_per_item);
+
+/* Print the summary, write results to output (if not NULL) and compare them with
+ * baseline (if not NULL). Return the number of results slower than the baseline
+ * by more than tolerance percent */
+int BenchFinish(const char *output, const char *baseline, float tolerance);
+
+void bench_fft(void);
+void bench_iir(void);
+void bench_fir(void);
+void bench_conv(void);
+void bench_matrix(void);
+void bench_mat_factor(void);
+void bench_ekf(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BENCH_H_
@@ -0,0 +1,67 @@
+/* Convolution benchmarks: esp-dsp ANSI convolution against the fast_conv direct and FFT methods */
+#include <stdio.h>
+#include <math.h>
+
+#include "esp_dsp.h"
+#include "fft.h"
+#include "fast_conv.h"
+#include "bench.h"
+
+#define BLOCK_LENGHT    256
+#define MAX_KERNEL      1024
+
+static const uint16_t kernels[] = {8, 16, 32, 64, 128, 256, 512, 1024};
+
+static float signal[BLOCK_LENGHT + MAX_KERNEL];
+static float output[BLOCK_LENGHT + MAX_KERNEL];
+static float kernel[MAX_KERNEL];
+static float work[FAST_CONV_WORK_LENGHT(MAX_KERNEL, BLOCK_LENGHT)];
+static uint16_t kernel_lenght;
+
+static void BenchConv(void *context)
+{
+    dsps_conv_f32_ansi(signal, BLOCK_LENGHT, kernel, kernel_lenght, output);
+}
+
+static void BenchFastConv(void *context)
+{
+    FastConvBlock((fast_conv_t *)context, signal, output, BLOCK_LENGHT);
+}
+
+void bench_conv(void)
+{
+    fast_conv_t conv;
+
+    if (!FFTInit()) {
+        printf("FFTInit failed\n");
+        return;
+    }
+    for (int i = 0; i < BLOCK_LENGHT + MAX_KERNEL; i++) {
+        signal[i] = 0.5f * sinf(2 * M_PI * 0.01f * i) + 0.2f * sinf(2 * M_PI * 0.3f * i);
+    }
+    for (int i = 0; i < MAX_KERNEL; i++) {
+        kernel[i] = 1.0f / MAX_KERNEL;
+    }
+    /* Blocks of BLOCK_LENGHT samples, size is the kernel lenght */
+    uint16_t crossover = 0;
+    for (int k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++) {
+        kernel_lenght = kernels[k];
+        BenchReport("conv", "dsps_conv_f32", kernel_lenght, "sample", BenchMeasure(BenchConv, NULL, BLOCK_LENGHT));
+        FastConvInit(&conv, work, kernel, kernel_lenght, BLOCK_LENGHT, FAST_CONV_CONVOLUTION, FAST_CONV_DIRECT);
+        float direct = BenchMeasure(BenchFastConv, &conv, BLOCK_LENGHT);
+        BenchReport("conv", "FastConvBlock direct", kernel_lenght, "sample", direct);
+        FastConvInit(&conv, work, kernel, kernel_lenght, BLOCK_LENGHT, FAST_CONV_CONVOLUTION, FAST_CONV_FFT);
+        float fft = BenchMeasure(BenchFastConv, &conv, BLOCK_LENGHT);
+        BenchReport("conv", "FastConvBlock FFT", kernel_lenght, "sample", fft);
+        if ((crossover == 0) && (fft < direct)) {
+            crossover = kernel_lenght;
+        }
+    }
+    /* Shortest kernel that FAST_CONV_AUTO filters with the FFT */
+    uint16_t auto_crossover = 0;
+    for (kernel_lenght = 1; (kernel_lenght <= MAX_KERNEL) && (auto_crossover == 0); kernel_lenght++) {
+        FastConvInit(&conv, work, kernel, kernel_lenght, BLOCK_LENGHT, FAST_CONV_CONVOLUTION, FAST_CONV_AUTO);
+        auto_crossover = (conv.fft_lenght != 0) ? kernel_lenght : 0;
+    }
+    printf("conv     FFT faster from %u values (measured), FAST_CONV_AUTO uses it from %u values\n", crossover, auto_crossover);
+}
@@ -0,0 +1,83 @@
+/* EKF benchmarks: a step (prediction and update) of the dynamic ekf against ekf_fixed, and of
+ * ekf_imu13states with its declared sparsity against dense products */
+#include <stdio.h>
+#include <math.h>
+
+#include "ekf_imu13states.h"
+#include "ekf_models.h"
+#include "bench.h"
+
+#define EKF_DT      0.01f
+
+static float u[EKF_NW];
+static float measured[EKF_NZ];
+static float expected[EKF_NZ];
+static float R[EKF_NZ];
+static float accel[3] = {0, 0, 1};
+static float magn[3] = {1, 0, 0};
+
+static dspm::Mat *H;
+static dspm::MatFixed<EKF_NZ, EKF_NX> h;
+
+static void BenchEkf(void *context)
+{
+    ekf_linear *filter = (ekf_linear *)context;
+    filter->Process(u, EKF_DT);
+    filter->Update(*H, measured, expected, R);
+}
+
+static void BenchEkfFixed(void *context)
+{
+    ekf_linear_fixed *filter = (ekf_linear_fixed *)context;
+    filter->Process(u, EKF_DT);
+    filter->Update(h, measured, expected, R);
+}
+
+static void BenchEkfImu(void *context)
+{
+    ekf_imu13states *filter = (ekf_imu13states *)context;
+    filter->Process(u, EKF_DT);
+    filter->UpdateRefMeasurement(accel, magn, R);
+}
+
+/* Heap allocations of a call to function */
+static uint32_t Allocations(bench_function_t function, void *context)
+{
+    uint32_t allocs = AllocCount();
+    function(context);
+    return AllocCount() - allocs;
+}
+
+void bench_ekf(void)
+{
+    ekf_linear legacy;
+    ekf_linear_fixed fixed;
+    ekf_imu13states imu, imu_dense;
+    dspm::Mat H_legacy(EKF_NZ, EKF_NX);
+
+    legacy.Init();
+    fixed.Init();
+    imu.Init();
+    imu_dense.Init();
+    imu_dense.SparsityDense();
+    for (int m = 0; m < EKF_NZ; m++) {
+        for (int k = 0; k < EKF_NX; k++) {
+            H_legacy(m, k) = h(m, k) = EkfModelH(m, k);
+        }
+        R[m] = 0.1f;
+        measured[m] = 0.5f;
+    }
+    for (int j = 0; j < EKF_NW; j++) {
+        u[j] = 0.01f * j;
+    }
+    H = &H_legacy;
+
+    uint32_t legacy_allocs = Allocations(BenchEkf, &legacy);
+    uint32_t fixed_allocs = Allocations(BenchEkfFixed, &fixed);
+    uint32_t imu_allocs = Allocations(BenchEkfImu, &imu);
+    BenchReport("ekf", "ekf", EKF_NX, "step", BenchMeasure(BenchEkf, &legacy, 1));
+    BenchReport("ekf", "ekf_fixed", EKF_NX, "step", BenchMeasure(BenchEkfFixed, &fixed, 1));
+    BenchReport("ekf", "ekf_imu13states", EKF_NX, "step", BenchMeasure(BenchEkfImu, &imu, 1));
+    BenchReport("ekf", "ekf_imu13states dense", EKF_NX, "step", BenchMeasure(BenchEkfImu, &imu_dense, 1));
+    printf("ekf      heap allocations per step: ekf %u, ekf_fixed %u, ekf_imu13states %u\n", legacy_allocs, fixed_allocs, imu_allocs);
+}
@@ -0,0 +1,78 @@
+/* FFT benchmarks: middleware spectra and the esp-dsp kernels they are built on */
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "esp_dsp.h"
+#include "fft.h"
+#include "bench.h"
+
+static float signal[MAX_SIGNAL_LENGHT];
+static uint16_t signal_q15[MAX_SIGNAL_LENGHT];
+static float fft[MAX_SIGNAL_LENGHT];
+static uint16_t fft_q15[MAX_SIGNAL_LENGHT / 2];
+static float data[2 * MAX_SIGNAL_LENGHT];
+static int16_t data_sc16[2 * MAX_SIGNAL_LENGHT];
+static float tone[2 * MAX_SIGNAL_LENGHT];
+static int16_t tone_sc16[2 * MAX_SIGNAL_LENGHT];
+static uint16_t lenght;
+
+static void BenchMagnitude(void *context)
+{
+    FFTMagnitude(signal, fft, lenght);
+}
+
+static void BenchMagnitudeQ15(void *context)
+{
+    FFTMagnitudeQ15(signal_q15, fft_q15, lenght);
+}
+
+static void BenchFft2r(void *context)
+{
+    memcpy(data, tone, 2 * lenght * sizeof(float));
+    dsps_fft2r_fc32(data, lenght);
+    dsps_bit_rev2r_fc32(data, lenght);
+}
+
+static void BenchFft4r(void *context)
+{
+    memcpy(data, tone, 2 * lenght * sizeof(float));
+    dsps_fft4r_fc32(data, lenght);
+    dsps_bit_rev4r_fc32(data, lenght);
+}
+
+static void BenchFft2rSc16(void *context)
+{
+    memcpy(data_sc16, tone_sc16, 2 * lenght * sizeof(int16_t));
+    dsps_fft2r_sc16(data_sc16, lenght);
+    dsps_bit_rev_sc16(data_sc16, lenght);
+}
+
+void bench_fft(void)
+{
+    if (!FFTInit()) {
+        printf("FFTInit failed\n");
+        return;
+    }
+    for (int i = 0; i < MAX_SIGNAL_LENGHT; i++) {
+        signal_q15[i] = (uint16_t)(1650.0f + 1200.0f * sinf(2 * M_PI * 0.05f * i));
+        signal[i] = signal_q15[i];
+        tone[2 * i] = 1200.0f * sinf(2 * M_PI * 0.05f * i);
+        tone[2 * i + 1] = 0;
+        tone_sc16[2 * i] = (int16_t)tone[2 * i];
+        tone_sc16[2 * i + 1] = 0;
+    }
+    for (lenght = 64; lenght <= MAX_SIGNAL_LENGHT; lenght <<= 1) {
+        BenchReport("fft", "FFTMagnitude", lenght, "sample", BenchMeasure(BenchMagnitude, NULL, lenght));
+        BenchReport("fft", "FFTMagnitudeQ15", lenght, "sample", BenchMeasure(BenchMagnitudeQ15, NULL, lenght));
+    }
+    /* Complex transforms of the same tone: each call reloads its input (the copy is included in the
+     * time), otherwise the unscaled float transforms would grow without bound */
+    for (lenght = 64; lenght <= MAX_SIGNAL_LENGHT; lenght <<= 1) {
+        BenchReport("fft", "dsps_fft2r_fc32", lenght, "sample", BenchMeasure(BenchFft2r, NULL, lenght));
+        if ((dsp_power_of_two(lenght) & 0x01) == 0) {
+            BenchReport("fft", "dsps_fft4r_fc32", lenght, "sample", BenchMeasure(BenchFft4r, NULL, lenght));
+        }
+        BenchReport("fft", "dsps_fft2r_sc16", lenght, "sample", BenchMeasure(BenchFft2rSc16, NULL, lenght));
+    }
+}
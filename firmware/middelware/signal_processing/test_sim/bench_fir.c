@@ -0,0 +1,79 @@
+/* FIR benchmarks: esp-dsp ANSI kernels and the decimator built on them */
+#include <stdio.h>
+#include <math.h>
+
+#include "esp_dsp.h"
+#include "decimator.h"
+#include "bench.h"
+
+#define BLOCK_LENGHT    256
+#define MAX_TAPS        256
+#define DECIM           4
+
+static const uint16_t taps[] = {16, 32, 64, 128, 256};
+
+static float signal[BLOCK_LENGHT];
+static float output[BLOCK_LENGHT];
+static int16_t signal_q15[BLOCK_LENGHT];
+static int16_t output_q15[BLOCK_LENGHT];
+static float coeffs[MAX_TAPS];
+static float delay[MAX_TAPS + 4];   /* dsps_fir_init_f32() clears 4 extra samples */
+static int16_t coeffs_q15[MAX_TAPS];
+static int16_t delay_q15[MAX_TAPS];
+
+static void BenchFir(void *context)
+{
+    dsps_fir_f32_ansi((fir_f32_t *)context, signal, output, BLOCK_LENGHT);
+}
+
+static void BenchFird(void *context)
+{
+    dsps_fird_f32_ansi((fir_f32_t *)context, signal, output, BLOCK_LENGHT / DECIM);
+}
+
+static void BenchFirdS16(void *context)
+{
+    dsps_fird_s16_ansi((fir_s16_t *)context, signal_q15, output_q15, BLOCK_LENGHT);
+}
+
+static void BenchDecimator(void *context)
+{
+    DecimatorProcess((decimator_t *)context, signal, BLOCK_LENGHT, output);
+}
+
+static void BenchDecimatorQ15(void *context)
+{
+    DecimatorProcessQ15((decimator_q15_t *)context, signal_q15, BLOCK_LENGHT, output_q15);
+}
+
+void bench_fir(void)
+{
+    fir_f32_t fir;
+    fir_s16_t fir_s16;
+    static decimator_t dec;
+    static decimator_q15_t dec_q15;
+
+    for (int i = 0; i < BLOCK_LENGHT; i++) {
+        signal[i] = 0.5f * sinf(2 * M_PI * 0.01f * i) + 0.2f * sinf(2 * M_PI * 0.3f * i);
+        signal_q15[i] = (int16_t)lrintf(signal[i] * 32767);
+    }
+    for (int i = 0; i < MAX_TAPS; i++) {
+        coeffs[i] = 1.0f / MAX_TAPS;
+        coeffs_q15[i] = 32767 / MAX_TAPS;
+    }
+    for (int t = 0; t < sizeof(taps) / sizeof(taps[0]); t++) {
+        dsps_fir_init_f32(&fir, coeffs, delay, taps[t]);
+        BenchReport("fir", "dsps_fir_f32", taps[t], "sample", BenchMeasure(BenchFir, &fir, BLOCK_LENGHT));
+        dsps_fird_init_f32(&fir, coeffs, delay, taps[t], DECIM);
+        BenchReport("fir", "dsps_fird_f32/4", taps[t], "sample", BenchMeasure(BenchFird, &fir, BLOCK_LENGHT));
+        dsps_fird_init_s16(&fir_s16, coeffs_q15, delay_q15, taps[t], 1, 0, 0);
+        BenchReport("fir", "dsps_fird_s16", taps[t], "sample", BenchMeasure(BenchFirdS16, &fir_s16, BLOCK_LENGHT));
+    }
+    /* Decimation by 16, size is the FIR taps */
+    if (!DecimatorInit(&dec, 4, 4, coeffs, delay, 96) || !DecimatorInitQ15(&dec_q15, 4, 4, coeffs_q15, delay_q15, 96)) {
+        printf("Decimator init failed\n");
+        return;
+    }
+    BenchReport("fir", "DecimatorProcess", 96, "sample", BenchMeasure(BenchDecimator, &dec, BLOCK_LENGHT));
+    BenchReport("fir", "DecimatorProcessQ15", 96, "sample", BenchMeasure(BenchDecimatorQ15, &dec_q15, BLOCK_LENGHT));
+}
@@ -0,0 +1,73 @@
+/* IIR benchmarks: filter objects (float and Q15) against the plain dsps_biquad_f32 cascade */
+#include <stdio.h>
+#include <math.h>
+
+#include "esp_dsp.h"
+#include "iir_filter.h"
+#include "bench.h"
+
+#define SAMPLE_FREC     1000.0f
+#define CUT_FREC        40.0f
+#define BLOCK_LENGHT    256
+#define MAX_SECTIONS    (ORDER_8 / 2)
+
+static float signal[BLOCK_LENGHT];
+static float output[BLOCK_LENGHT];
+static int16_t signal_q15[BLOCK_LENGHT];
+static int16_t output_q15[BLOCK_LENGHT];
+static float coeffs[IIR_COEFFS_LENGHT(MAX_SECTIONS)];
+static float delay[IIR_DELAY_LENGHT(MAX_SECTIONS, 1)];
+static float coeffs_design[IIR_COEFFS_LENGHT(MAX_SECTIONS)];
+static int32_t coeffs_q[IIR_COEFFS_LENGHT(MAX_SECTIONS)];
+static int16_t delay_q15[IIR_DELAY_Q15_LENGHT(MAX_SECTIONS, 1)];
+static float biquad_delay[MAX_SECTIONS][2];
+
+static void BenchProcess(void *context)
+{
+    IIRFilterProcess((iir_filter_t *)context, signal, output, BLOCK_LENGHT);
+}
+
+static void BenchProcessQ15(void *context)
+{
+    IIRFilterProcessQ15((iir_filter_t *)context, signal_q15, output_q15, BLOCK_LENGHT);
+}
+
+static void BenchSample(void *context)
+{
+    for (int i = 0; i < BLOCK_LENGHT; i++) {
+        output[i] = IIRFilterSample((iir_filter_t *)context, 0, signal[i]);
+    }
+}
+
+static void BenchBiquad(void *context)
+{
+    iir_filter_t *filter = (iir_filter_t *)context;
+    dsps_biquad_f32(signal, output, BLOCK_LENGHT, filter->coeffs, biquad_delay[0]);
+    for (int s = 1; s < filter->n_sections; s++) {
+        dsps_biquad_f32(output, output, BLOCK_LENGHT, &filter->coeffs[s * IIR_SOS_COEFFS], biquad_delay[s]);
+    }
+}
+
+void bench_iir(void)
+{
+    iir_filter_t filter, filter_q15;
+
+    for (int i = 0; i < BLOCK_LENGHT; i++) {
+        signal[i] = 0.5f * sinf(2 * M_PI * 10 * i / SAMPLE_FREC) + 0.2f * sinf(2 * M_PI * 120 * i / SAMPLE_FREC);
+        signal_q15[i] = (int16_t)lrintf(signal[i] * 32767);
+    }
+    for (int order = ORDER_2; order <= ORDER_8; order += 2) {
+        int n_sections = order / 2;
+        if (!IIRFilterInit(&filter, coeffs, delay, n_sections, 1)
+            || !IIRFilterInitQ15(&filter_q15, coeffs_design, coeffs_q, delay_q15, n_sections, 1)) {
+            printf("IIR filter init failed\n");
+            return;
+        }
+        IIRFilterDesignLowPass(&filter, SAMPLE_FREC, CUT_FREC);
+        IIRFilterDesignLowPass(&filter_q15, SAMPLE_FREC, CUT_FREC);
+        BenchReport("iir", "IIRFilterProcess", order, "sample", BenchMeasure(BenchProcess, &filter, BLOCK_LENGHT));
+        BenchReport("iir", "IIRFilterProcessQ15", order, "sample", BenchMeasure(BenchProcessQ15, &filter_q15, BLOCK_LENGHT));
+        BenchReport("iir", "IIRFilterSample", order, "sample", BenchMeasure(BenchSample, &filter, BLOCK_LENGHT));
+        BenchReport("iir", "dsps_biquad_f32", order, "sample", BenchMeasure(BenchBiquad, &filter, BLOCK_LENGHT));
+    }
+}
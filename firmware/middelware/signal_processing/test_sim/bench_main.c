@@ -0,0 +1,47 @@
+/* Host benchmarks of the signal_processing middleware and the esp-dsp ANSI kernels
+ *
+ *   bench_signal_processing [-o results.csv] [-b baseline.csv] [-t tolerance_percent]
+ *
+ * Exits with failure when a result is slower than the baseline by more than the tolerance.
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "bench.h"
+
+#define DEFAULT_TOLERANCE   25.0f
+
+int main(int argc, char *argv[])
+{
+    const char *output = NULL;
+    const char *baseline = NULL;
+    float tolerance = DEFAULT_TOLERANCE;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-o") && (i + 1 < argc)) {
+            output = argv[++i];
+        } else if (!strcmp(argv[i], "-b") && (i + 1 < argc)) {
+            baseline = argv[++i];
+        } else if (!strcmp(argv[i], "-t") && (i + 1 < argc)) {
+            tolerance = atof(argv[++i]);
+        } else {
+            printf("usage: %s [-o results.csv] [-b baseline.csv] [-t tolerance_percent]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    printf("%-8s %-24s %6s %21s %18s\n", "suite", "name", "size", "time", "throughput");
+    bench_fft();
+    bench_iir();
+    bench_fir();
+    bench_conv();
+    bench_matrix();
+    bench_mat_factor();
+    bench_ekf();
+
+    if (BenchFinish(output, baseline, tolerance)) {
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
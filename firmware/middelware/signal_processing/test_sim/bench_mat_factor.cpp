@@ -0,0 +1,93 @@
+/* Matrix decomposition benchmarks: Mat::solve and Mat::pinv against MatLU and MatLDLT, with the
+ * decomposition calculated for each solution and reused */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "mat.h"
+#include "mat_factor.h"
+#include "bench.h"
+
+#define MAX_SIZE    16
+
+static const int sizes[] = {4, 6, 8, 16};
+
+static dspm::Mat *A;
+static dspm::Mat *S;
+static dspm::Mat *b;
+static dspm::Mat *x;
+static float v[MAX_SIZE];
+
+static void BenchSolve(void *context)
+{
+    dspm::Mat::solve(*A, *b);
+}
+
+static void BenchPinv(void *context)
+{
+    S->pinv();
+}
+
+static void BenchLU(void *context)
+{
+    dspm::MatLU *lu = (dspm::MatLU *)context;
+    lu->factor(*A);
+    lu->solve(*b, *x);
+}
+
+static void BenchLUSolve(void *context)
+{
+    ((dspm::MatLU *)context)->solve(*b, *x);
+}
+
+static void BenchLDLT(void *context)
+{
+    dspm::MatLDLT *ldlt = (dspm::MatLDLT *)context;
+    ldlt->factor(*S);
+    ldlt->solve(*b, *x);
+}
+
+static void BenchLDLTUpdate(void *context)
+{
+    dspm::MatLDLT *ldlt = (dspm::MatLDLT *)context;
+    ldlt->update(v, 0.1f);
+    ldlt->update(v, -0.1f);
+}
+
+static void BenchLDLTInverse(void *context)
+{
+    dspm::MatLDLT *ldlt = (dspm::MatLDLT *)context;
+    ldlt->factor(*S);
+    ldlt->inverse();
+}
+
+void bench_mat_factor(void)
+{
+    for (int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        int n = sizes[s];
+        dspm::Mat a(n, n), m(n, n), rhs(n, 1), result(n, 1);
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                a(i, j) = (i == j) ? n : (float)((i * 7 + j * 3) % 5) - 2;
+                m(i, j) = (float)((i * 5 + j * 11) % 7) - 3;
+            }
+            rhs(i, 0) = i + 1;
+            v[i] = 0.5f * (i % 3);
+        }
+        dspm::Mat s_ = m * m.t() + dspm::Mat::eye(n);
+        A = &a;
+        S = &s_;
+        b = &rhs;
+        x = &result;
+        dspm::MatLU lu(n);
+        dspm::MatLDLT ldlt(s_);
+
+        /* Size is the matrix size, a solution (or inverse) per call */
+        BenchReport("factor", "Mat::solve", n, "solve", BenchMeasure(BenchSolve, NULL, 1));
+        BenchReport("factor", "MatLU factor+solve", n, "solve", BenchMeasure(BenchLU, &lu, 1));
+        BenchReport("factor", "MatLU solve", n, "solve", BenchMeasure(BenchLUSolve, &lu, 1));
+        BenchReport("factor", "MatLDLT factor+solve", n, "solve", BenchMeasure(BenchLDLT, &ldlt, 1));
+        BenchReport("factor", "MatLDLT update", n, "update", BenchMeasure(BenchLDLTUpdate, &ldlt, 2));
+        BenchReport("factor", "Mat::pinv", n, "inverse", BenchMeasure(BenchPinv, NULL, 1));
+        BenchReport("factor", "MatLDLT inverse", n, "inverse", BenchMeasure(BenchLDLTInverse, &ldlt, 1));
+    }
+}
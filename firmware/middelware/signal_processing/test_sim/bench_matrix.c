@@ -0,0 +1,87 @@
+/* Matrix benchmarks: esp-dsp ANSI matrix multiplication of square matrices, the unrolled 3x3 / 4x4 kernels,
+ * and the blocked GEMM kernel (plain, with both operands transposed, and on a sub-matrix) */
+#include <stdio.h>
+
+#include "esp_dsp.h"
+#include "bench.h"
+
+#define MAX_SIZE    64
+
+static const int sizes[] = {3, 4, 8, 16, 32, 64};
+
+static float a[MAX_SIZE * MAX_SIZE];
+static float b[MAX_SIZE * MAX_SIZE];
+static float c[MAX_SIZE * MAX_SIZE];
+static int size;
+
+static void BenchMult(void *context)
+{
+    dspm_mult_f32_ansi(a, b, c, size, size, size);
+}
+
+static void BenchMultVector(void *context)
+{
+    dspm_mult_f32_ansi(a, b, c, size, size, 1);
+}
+
+static void BenchGemm(void *context)
+{
+    dspm_gemm_f32(a, b, c, size, size, size, 1, 0, size, size, size, 0, 0);
+}
+
+static void BenchGemmTrans(void *context)
+{
+    dspm_gemm_f32(a, b, c, size, size, size, 1, 0, size, size, size, 1, 1);
+}
+
+/* Sub-matrix of a MAX_SIZE x MAX_SIZE matrix, accumulated over C */
+static void BenchGemmROI(void *context)
+{
+    dspm_gemm_f32(a, b, c, size, size, size, 1, 1, MAX_SIZE, MAX_SIZE, MAX_SIZE, 0, 0);
+}
+
+static void BenchMult3x3x1(void *context)
+{
+    dspm_mult_3x3x1_f32(a, b, c);
+}
+
+static void BenchMult3x3x3(void *context)
+{
+    dspm_mult_3x3x3_f32(a, b, c);
+}
+
+static void BenchMult4x4x1(void *context)
+{
+    dspm_mult_4x4x1_f32(a, b, c);
+}
+
+static void BenchMult4x4x4(void *context)
+{
+    dspm_mult_4x4x4_f32(a, b, c);
+}
+
+void bench_matrix(void)
+{
+    for (int i = 0; i < MAX_SIZE * MAX_SIZE; i++) {
+        a[i] = (float)(i % 7) - 3;
+        b[i] = (float)(i % 5) * 0.5f;
+    }
+    for (int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        size = sizes[s];
+        BenchReport("matrix", "dspm_mult_f32", size, "MAC", BenchMeasure(BenchMult, NULL, size * size * size));
+        BenchReport("matrix", "dspm_mult_f32_nx1", size, "MAC", BenchMeasure(BenchMultVector, NULL, size * size));
+        if (size >= 4) {
+            BenchReport("matrix", "dspm_gemm_f32", size, "MAC", BenchMeasure(BenchGemm, NULL, size * size * size));
+            BenchReport("matrix", "dspm_gemm_f32 A'B'", size, "MAC", BenchMeasure(BenchGemmTrans, NULL, size * size * size));
+            BenchReport("matrix", "dspm_gemm_f32 ROI", size, "MAC", BenchMeasure(BenchGemmROI, NULL, size * size * size));
+        }
+        if (size == 3) {
+            BenchReport("matrix", "dspm_mult_3x3x3_f32", size, "MAC", BenchMeasure(BenchMult3x3x3, NULL, 27));
+            BenchReport("matrix", "dspm_mult_3x3x1_f32", size, "MAC", BenchMeasure(BenchMult3x3x1, NULL, 9));
+        }
+        if (size == 4) {
+            BenchReport("matrix", "dspm_mult_4x4x4_f32", size, "MAC", BenchMeasure(BenchMult4x4x4, NULL, 64));
+            BenchReport("matrix", "dspm_mult_4x4x1_f32", size, "MAC", BenchMeasure(BenchMult4x4x1, NULL, 16));
+        }
+    }
+}
@@ -0,0 +1,82 @@
+#ifndef EKF_MODELS_H_
+#define EKF_MODELS_H_
+
+/* Linear system with the size of ekf_imu13states, implemented with the dynamic ekf
+ * and with ekf_fixed, used by the tests and the benchmarks of the EKF */
+#include <stdint.h>
+#include "ekf.h"
+#include "ekf_fixed.h"
+
+#define EKF_NX      13
+#define EKF_NW      18
+#define EKF_NZ      6
+
+/* Number of calls to operator new since the program started */
+uint32_t AllocCount(void);
+
+/* Deterministic model values: stable F, full G, diagonal Q and a sparse H */
+static inline float EkfModelF(int i, int j)
+{
+    return (i == j) ? -0.5f : 0.05f * (float)(((i * 7 + j * 3) % 11) - 5) / 5;
+}
+
+static inline float EkfModelG(int i, int j)
+{
+    return 0.1f * (float)(((i * 5 + j) % 9) - 4) / 4;
+}
+
+static inline float EkfModelH(int m, int k)
+{
+    return ((k % 3) == (m % 3)) ? 1.0f - 0.1f * m : 0;
+}
+
+class ekf_linear : public ekf {
+public:
+    ekf_linear() : ekf(EKF_NX, EKF_NW) {}
+    virtual void Init()
+    {
+        for (int i = 0; i < EKF_NW; i++) {
+            this->Q(i, i) = 0.01f;
+        }
+        for (int i = 0; i < EKF_NX; i++) {
+            this->P(i, i) = 1;
+        }
+    }
+    virtual void LinearizeFG(dspm::Mat &x, float *u)
+    {
+        for (int i = 0; i < EKF_NX; i++) {
+            for (int j = 0; j < EKF_NX; j++) {
+                this->F(i, j) = EkfModelF(i, j);
+            }
+            for (int j = 0; j < EKF_NW; j++) {
+                this->G(i, j) = EkfModelG(i, j);
+            }
+        }
+    }
+};
+
+class ekf_linear_fixed : public ekf_fixed<EKF_NX, EKF_NW> {
+public:
+    virtual void Init()
+    {
+        for (int i = 0; i < EKF_NW; i++) {
+            this->Q(i, i) = 0.01f;
+        }
+        for (int i = 0; i < EKF_NX; i++) {
+            this->Pij(i, i) = 1;
+        }
+    }
+    virtual void LinearizeFG(state_t &x, float *u)
+    {
+        for (int i = 0; i < EKF_NX; i++) {
+            for (int j = 0; j < EKF_NX; j++) {
+                this->F(i, j) = EkfModelF(i, j);
+            }
+            for (int j = 0; j < EKF_NW; j++) {
+                this->G(i, j) = EkfModelG(i, j);
+            }
+        }
+    }
+};
+
+#endif // EKF_MODELS_H_
@@ -0,0 +1,58 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+
+bool test_fft_real(void);
+bool test_fft_q15(void);
+bool test_fft_goertzel(void);
+bool test_fft_sliding(void);
+bool test_fft_context(void);
+bool test_fft_features(void);
+bool test_iir_filter(void);
+bool test_iir_q15(void);
+bool test_iir_band_pass(void);
+bool test_decimator(void);
+bool test_qrs_detector(void);
+bool test_level_detector(void);
+bool test_nlms_filter(void);
+bool test_fast_conv(void);
+bool test_ekf_fixed(void);
+bool test_rv32_kernels(void);
+bool test_mult_small(void);
+bool test_mat_factor(void);
+bool test_gemm(void);
+bool test_fft_tables(void);
+
+int main(void)
+{
+    int failed = 0;
+    printf("main starts!\n");
+
+    failed += !test_fft_real();
+    failed += !test_fft_q15();
+    failed += !test_fft_goertzel();
+    failed += !test_fft_sliding();
+    failed += !test_fft_context();
+    failed += !test_fft_features();
+    failed += !test_iir_filter();
+    failed += !test_iir_q15();
+    failed += !test_iir_band_pass();
+    failed += !test_decimator();
+    failed += !test_qrs_detector();
+    failed += !test_level_detector();
+    failed += !test_nlms_filter();
+    failed += !test_fast_conv();
+    failed += !test_ekf_fixed();
+    failed += !test_rv32_kernels();
+    failed += !test_mult_small();
+    failed += !test_mat_factor();
+    failed += !test_gemm();
+    failed += !test_fft_tables();
+
+    if (failed) {
+        printf("%i test(s) failed\n", failed);
+        return EXIT_FAILURE;
+    }
+    printf("Test done\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,153 @@
+/* Multi-stage decimators: block size independence, alias rejection, pass band, group delay and full scale */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "esp_dsp.h"
+#include "decimator.h"
+#include "test_sim.h"
+
+#define SIGNAL_LENGHT       4096
+#define N_TAPS              96
+#define FIRST_DECIM         4
+#define FIR_DECIM           4
+#define TOTAL_DECIM         (FIRST_DECIM * FIR_DECIM)
+#define OUTPUT_LENGHT       (SIGNAL_LENGHT / TOTAL_DECIM + 1)
+#define MAX_STOP_BAND       0.01f   /* Gain of tones above the output Nyquist frequency */
+#define MAX_PASS_BAND_ERROR 0.05f   /* Gain error of tones in the pass band */
+#define SQUARE_HALF_PERIOD  512     /* Input samples of each half of the full scale square wave */
+
+static float signal[SIGNAL_LENGHT];
+static float output[OUTPUT_LENGHT];
+static float output_blocks[OUTPUT_LENGHT];
+static int16_t signal_q15[SIGNAL_LENGHT];
+static int16_t output_q15[OUTPUT_LENGHT];
+static int16_t output_blocks_q15[OUTPUT_LENGHT];
+static float coeffs[N_TAPS];
+static float delay[N_TAPS];
+static int16_t coeffs_q15[N_TAPS];
+static int16_t delay_q15[N_TAPS];
+
+/* Amplitude of a tone (frec relative to the input sample frequency) at the decimator output */
+static float ToneGain(decimator_t * dec, decimator_q15_t * dec_q15, float frec)
+{
+    uint16_t n;
+    float peak = 0;
+    for (int i = 0; i < SIGNAL_LENGHT; i++) {
+        signal[i] = sinf(2 * M_PI * frec * i);
+        signal_q15[i] = (int16_t)lrintf(16000 * signal[i]);
+    }
+    if (dec != NULL) {
+        DecimatorReset(dec);
+        n = DecimatorProcess(dec, signal, SIGNAL_LENGHT, output);
+        for (int i = n / 2; i < n; i++) {
+            peak = fmaxf(peak, fabsf(output[i]));
+        }
+    } else {
+        DecimatorResetQ15(dec_q15);
+        n = DecimatorProcessQ15(dec_q15, signal_q15, SIGNAL_LENGHT, output_q15);
+        for (int i = n / 2; i < n; i++) {
+            peak = fmaxf(peak, fabsf(output_q15[i] / 16000.0f));
+        }
+    }
+    return peak;
+}
+
+bool test_decimator(void)
+{
+    decimator_t dec;
+    decimator_q15_t dec_q15;
+
+    TEST_CHECK(!DecimatorInit(&dec, 3, FIR_DECIM, coeffs, delay, N_TAPS), "DecimatorInit accepted a first decimation of 3");
+    TEST_CHECK(!DecimatorInitQ15(&dec_q15, DECIMATOR_MAX_CIC_DECIM + 1, FIR_DECIM, coeffs_q15, delay_q15, N_TAPS), "DecimatorInitQ15 accepted a CIC decimation too high");
+    TEST_CHECK(DecimatorInit(&dec, FIRST_DECIM, FIR_DECIM, coeffs, delay, N_TAPS), "DecimatorInit failed");
+    TEST_CHECK(DecimatorInitQ15(&dec_q15, FIRST_DECIM, FIR_DECIM, coeffs_q15, delay_q15, N_TAPS), "DecimatorInitQ15 failed");
+
+    /* Blocks of random lenght must give the same output as a single block */
+    srand(8);
+    for (int i = 0; i < SIGNAL_LENGHT; i++) {
+        signal[i] = sinf(2 * M_PI * 0.01f * i) + 0.3f * ((float)rand() / RAND_MAX - 0.5f);
+        signal_q15[i] = (int16_t)lrintf(16000 * signal[i]);
+    }
+    uint16_t n = DecimatorProcess(&dec, signal, SIGNAL_LENGHT, output);
+    uint16_t n_q15 = DecimatorProcessQ15(&dec_q15, signal_q15, SIGNAL_LENGHT, output_q15);
+    TEST_CHECK((n == SIGNAL_LENGHT / TOTAL_DECIM) && (n_q15 == n), "%u / %u decimated samples", n, n_q15);
+    DecimatorReset(&dec);
+    DecimatorResetQ15(&dec_q15);
+    uint16_t n_blocks = 0, n_blocks_q15 = 0;
+    for (int i = 0; i < SIGNAL_LENGHT;) {
+        int lenght = 1 + rand() % 97;
+        if (i + lenght > SIGNAL_LENGHT) {
+            lenght = SIGNAL_LENGHT - i;
+        }
+        n_blocks += DecimatorProcess(&dec, &signal[i], lenght, &output_blocks[n_blocks]);
+        n_blocks_q15 += DecimatorProcessQ15(&dec_q15, &signal_q15[i], lenght, &output_blocks_q15[n_blocks_q15]);
+        i += lenght;
+    }
+    TEST_CHECK((n_blocks == n) && (n_blocks_q15 == n), "%u / %u decimated samples with random blocks", n_blocks, n_blocks_q15);
+    for (int i = 0; i < n; i++) {
+        TEST_CHECK(output_blocks[i] == output[i], "float output differs at sample %i: %f %f", i, output_blocks[i], output[i]);
+        TEST_CHECK(output_blocks_q15[i] == output_q15[i], "Q15 output differs at sample %i", i);
+    }
+
+    /* Group delay: output k is computed with input samples up to (k + 1) * TOTAL_DECIM - 1,
+       so a slow tone at the output must be the input tone delayed by the group delay */
+    float frec = 0.05f / TOTAL_DECIM;
+    for (int i = 0; i < SIGNAL_LENGHT; i++) {
+        signal[i] = sinf(2 * M_PI * frec * i);
+        signal_q15[i] = (int16_t)lrintf(16000 * signal[i]);
+    }
+    DecimatorReset(&dec);
+    DecimatorResetQ15(&dec_q15);
+    n = DecimatorProcess(&dec, signal, SIGNAL_LENGHT, output);
+    DecimatorProcessQ15(&dec_q15, signal_q15, SIGNAL_LENGHT, output_q15);
+    float max_error = 0, max_error_q15 = 0;
+    for (int k = n / 2; k < n; k++) {
+        float t = (k + 1) * TOTAL_DECIM - 1;
+        max_error = fmaxf(max_error, fabsf(output[k] - sinf(2 * M_PI * frec * (t - DecimatorGroupDelay(&dec)))));
+        max_error_q15 = fmaxf(max_error_q15, fabsf(output_q15[k] / 16000.0f - sinf(2 * M_PI * frec * (t - DecimatorGroupDelayQ15(&dec_q15)))));
+    }
+    TEST_CHECK(max_error < MAX_PASS_BAND_ERROR / 5, "float group delay error %f", max_error);
+    TEST_CHECK(max_error_q15 < MAX_PASS_BAND_ERROR / 5, "Q15 group delay error %f", max_error_q15);
+
+    /* Full scale square wave: the overshoot of the 16 bits decimator saturates instead of wrapping */
+    for (int i = 0; i < SIGNAL_LENGHT; i++) {
+        signal_q15[i] = ((i / SQUARE_HALF_PERIOD) % 2) ? INT16_MIN : INT16_MAX;
+    }
+    DecimatorResetQ15(&dec_q15);
+    n = DecimatorProcessQ15(&dec_q15, signal_q15, SIGNAL_LENGHT, output_q15);
+    for (int k = 0; k < n; k++) {
+        /* Input sample at the output time, after the first edge of the step response */
+        int t = (k + 1) * TOTAL_DECIM - 1 - (int)DecimatorGroupDelayQ15(&dec_q15);
+        if ((t >= TOTAL_DECIM) && ((t % SQUARE_HALF_PERIOD) >= TOTAL_DECIM)) {
+            TEST_CHECK((output_q15[k] > 0) == (signal_q15[t] > 0), "Q15 full scale output %i wrapped at sample %i", output_q15[k], k);
+        }
+    }
+
+    printf("\nDecimator %i x %i, %i taps FIR\n", FIRST_DECIM, FIR_DECIM, N_TAPS);
+    printf("%10s %12s %12s %12s %12s %14s\n", "type", "delay", "gain 0.2 fo", "gain 0.35 fo", "gain 0.65 fo", TICKS_UNIT "/sample");
+    for (int type = 0; type < 2; type++) {
+        decimator_t * d = (type == 0) ? &dec : NULL;
+        float pass_low = ToneGain(d, &dec_q15, 0.2f / TOTAL_DECIM);
+        float pass_high = ToneGain(d, &dec_q15, 0.35f / TOTAL_DECIM);
+        float stop = ToneGain(d, &dec_q15, 0.65f / TOTAL_DECIM);
+        float stop_max = 0;
+        for (float f = 0.65f / TOTAL_DECIM; f < 0.5f; f += 0.37f / TOTAL_DECIM) {
+            stop_max = fmaxf(stop_max, ToneGain(d, &dec_q15, f));
+        }
+        uint32_t start = dsp_get_cpu_cycle_count();
+        if (type == 0) {
+            DecimatorProcess(&dec, signal, SIGNAL_LENGHT, output);
+        } else {
+            DecimatorProcessQ15(&dec_q15, signal_q15, SIGNAL_LENGHT, output_q15);
+        }
+        float ticks = (float)(dsp_get_cpu_cycle_count() - start) / SIGNAL_LENGHT;
+        printf("%10s %12.1f %12.3f %12.3f %12.4f %14.2f\n", (type == 0) ? "half band" : "CIC",
+               (type == 0) ? DecimatorGroupDelay(&dec) : DecimatorGroupDelayQ15(&dec_q15), pass_low, pass_high, stop, ticks);
+        printf("%10s max gain above 0.65 fo: %.4f\n", "", stop_max);
+        TEST_CHECK(fabsf(pass_low - 1) < MAX_PASS_BAND_ERROR, "pass band gain %f", pass_low);
+        TEST_CHECK(fabsf(pass_high - 1) < MAX_PASS_BAND_ERROR, "pass band gain %f", pass_high);
+        TEST_CHECK(stop_max < MAX_STOP_BAND, "stop band gain %f", stop_max);
+    }
+    return true;
+}
@@ -0,0 +1,217 @@
+/* Fixed size matrices and EKF: same results as dspm::Mat and ekf, without heap allocations,
+ * and a replay of a synthetic IMU record with the declared sparsity of ekf_imu13states */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "mat.h"
+#include "mat_fixed.h"
+#include "ekf_imu13states.h"
+#include "ekf_models.h"
+#include "test_sim.h"
+
+#define MAX_ERROR       1e-5f   /* Relative to the largest value */
+#define EKF_STEPS       200
+#define EKF_DT          0.01f
+#define MAX_EKF_DRIFT   2e-3f   /* Relative error against ekf after EKF_STEPS steps */
+#define MAX_BIAS_ERROR  0.1f    /* Same limit as the esp-dsp ekf_imu13states test */
+#define IMU_STEPS       4000
+#define IMU_NOISE       0.01f   /* Peak noise of the accelerometer and magnetometer */
+#define GYRO_NOISE      0.005f  /* Peak noise of the gyroscope, rad/s */
+
+static const float gyro_bias[3] = {0.05f, -0.03f, 0.02f};
+
+/* Synthetic IMU record: gyroscope with bias, accelerometer and magnetometer of a slow rotation */
+static float record_gyro[IMU_STEPS][3];
+static float record_accel[IMU_STEPS][3];
+static float record_magn[IMU_STEPS][3];
+
+/* Largest difference against the reference values, relative to the largest reference value */
+static float Error(const float *values, const float *reference, int lenght)
+{
+    float max_value = 0, max_error = 0;
+    for (int i = 0; i < lenght; i++) {
+        max_value = fmaxf(max_value, fabsf(reference[i]));
+        max_error = fmaxf(max_error, fabsf(values[i] - reference[i]));
+    }
+    return max_error / max_value;
+}
+
+/* Input and measurement of a step of the linear model */
+static void EkfStepData(int n, float *u, float *measured, float *expected, const float *x)
+{
+    for (int j = 0; j < EKF_NW; j++) {
+        u[j] = sinf(0.1f * n + j);
+    }
+    for (int m = 0; m < EKF_NZ; m++) {
+        measured[m] = cosf(0.05f * n + m);
+        expected[m] = 0;
+        for (int k = 0; k < EKF_NX; k++) {
+            expected[m] += EkfModelH(m, k) * x[k];
+        }
+    }
+}
+
+static float Noise(float peak)
+{
+    return peak * (2.0f * rand() / RAND_MAX - 1);
+}
+
+static void ImuRecord(void)
+{
+    dspm::MatFixed<3, 3> Rm = dspm::MatFixed<3, 3>::eye();
+    float accel0_data[] = {0, 0, 1};
+    float magn0_data[] = {1, 0, 0};
+    dspm::MatFixed<3, 1> accel0(accel0_data), magn0(magn0_data);
+    for (int n = 0; n < IMU_STEPS; n++) {
+        float rate[3];
+        for (int i = 0; i < 3; i++) {
+            rate[i] = 0.5f * (i + 1) * sinf(2 * M_PI * 0.1f * (i + 1) * n * EKF_DT);
+            record_gyro[n][i] = rate[i] + gyro_bias[i] + Noise(GYRO_NOISE);
+            rate[i] *= EKF_DT;
+        }
+        Rm = Rm * ekf_imu13states::eul2rotm(rate);
+        dspm::MatFixed<3, 1> accel = Rm.t() * accel0;
+        dspm::MatFixed<3, 1> magn = Rm.t() * magn0;
+        for (int i = 0; i < 3; i++) {
+            record_accel[n][i] = accel[i] + Noise(IMU_NOISE);
+            record_magn[n][i] = magn[i] + Noise(IMU_NOISE);
+        }
+    }
+}
+
+extern "C" bool test_ekf_fixed(void)
+{
+    dspm::MatFixed<4, 3> a, c;
+    dspm::MatFixed<3, 5> b;
+    dspm::MatFixed<5, 3> d;
+    srand(21);
+    for (int i = 0; i < a.length; i++) {
+        a[i] = (float)rand() / RAND_MAX - 0.5f;
+        c[i] = (float)rand() / RAND_MAX - 0.5f;
+    }
+    for (int i = 0; i < b.length; i++) {
+        b[i] = (float)rand() / RAND_MAX - 0.5f;
+        d[i] = (float)rand() / RAND_MAX - 0.5f;
+    }
+    dspm::Mat A(a.data, 4, 3), B(b.data, 3, 5), C(c.data, 4, 3), D(d.data, 5, 3);
+
+    /* Element-wise expressions, products and transpose against dspm::Mat */
+    dspm::MatFixed<4, 3> sum = a + 2 * c - c / 4 - (-a);
+    dspm::Mat Sum = A + 2 * C - C / 4 + A;
+    TEST_CHECK(Error(sum.data, Sum.data, sum.length) < MAX_ERROR, "expression error %g", Error(sum.data, Sum.data, sum.length));
+    dspm::MatFixed<4, 5> product = (a + c) * b;
+    dspm::Mat Product = (A + C) * B;
+    TEST_CHECK(Error(product.data, Product.data, product.length) < MAX_ERROR, "product error %g", Error(product.data, Product.data, product.length));
+    dspm::MatFixed<4, 5> product_t;
+    dspm::mult_t(a, d, product_t);
+    dspm::Mat Product_t = A * D.t();
+    TEST_CHECK(Error(product_t.data, Product_t.data, product_t.length) < MAX_ERROR, "mult_t error %g", Error(product_t.data, Product_t.data, product_t.length));
+    dspm::MatFixed<3, 4> transposed = a.t();
+    dspm::Mat Transposed = A.t();
+    TEST_CHECK(Error(transposed.data, Transposed.data, transposed.length) < MAX_ERROR, "transpose error");
+    dspm::MatFixed<4, 3> square = a;
+    square *= b.Get<3, 3>(0, 1);
+    dspm::Mat Square = A * B.Get(0, 3, 1, 3);
+    TEST_CHECK(Error(square.data, Square.data, square.length) < MAX_ERROR, "*= error %g", Error(square.data, Square.data, square.length));
+    dspm::MatFixed<5, 6> region;
+    region.Copy(a, 1, 2);
+    dspm::MatFixed<4, 3> copied = region.Get<4, 3>(1, 2);
+    TEST_CHECK(Error(copied.data, a.data, a.length) < MAX_ERROR, "Copy / Get error");
+    TEST_CHECK(fabsf(a.norm() - A.norm()) < MAX_ERROR, "norm error");
+
+    /* Same state and covariance as the dynamic ekf, with no allocation per step */
+    ekf_linear legacy;
+    ekf_linear_fixed fixed;
+    legacy.Init();
+    fixed.Init();
+    dspm::Mat H(EKF_NZ, EKF_NX);
+    dspm::MatFixed<EKF_NZ, EKF_NX> h;
+    for (int m = 0; m < EKF_NZ; m++) {
+        for (int k = 0; k < EKF_NX; k++) {
+            H(m, k) = h(m, k) = EkfModelH(m, k);
+        }
+    }
+    float u[EKF_NW], measured[EKF_NZ], expected[EKF_NZ], R[EKF_NZ];
+    for (int m = 0; m < EKF_NZ; m++) {
+        R[m] = 0.1f;
+    }
+    uint32_t legacy_allocs = 0, fixed_allocs = 0;
+    for (int n = 0; n < EKF_STEPS; n++) {
+        uint32_t allocs = AllocCount();
+        EkfStepData(n, u, measured, expected, legacy.X.data);
+        legacy.Process(u, EKF_DT);
+        legacy.Update(H, measured, expected, R);
+        legacy_allocs += AllocCount() - allocs;
+
+        allocs = AllocCount();
+        EkfStepData(n, u, measured, expected, fixed.X.data);
+        fixed.Process(u, EKF_DT);
+        fixed.Update(h, measured, expected, R);
+        fixed_allocs += AllocCount() - allocs;
+
+        /* The rounding differences of the packed covariance add up step after step */
+        float max_error = (n == 0) ? MAX_ERROR : MAX_EKF_DRIFT;
+        float error = Error(fixed.X.data, legacy.X.data, EKF_NX);
+        TEST_CHECK(error < max_error, "ekf_fixed state error %g at step %i", error, n);
+        dspm::MatFixed<EKF_NX, EKF_NX> fixed_P;
+        fixed.GetP(fixed_P);
+        error = Error(fixed_P.data, legacy.P.data, EKF_NX * EKF_NX);
+        TEST_CHECK(error < max_error, "ekf_fixed covariance error %g at step %i", error, n);
+    }
+    TEST_CHECK(fixed_allocs == 0, "ekf_fixed allocated %u times", fixed_allocs);
+    dspm::Mat P_mat(EKF_NX, EKF_NX);
+    fixed.GetP(P_mat);
+    TEST_CHECK(Error(P_mat.data, legacy.P.data, EKF_NX * EKF_NX) < MAX_EKF_DRIFT, "ekf_fixed GetP into a dspm::Mat differs from ekf");
+
+    /* Singular S (a row of H and its R are 0): UpdateRef leaves the state and covariance as they are */
+    dspm::Mat X_before = legacy.X, P_before = legacy.P;
+    for (int k = 0; k < EKF_NX; k++) {
+        H(0, k) = 0;
+    }
+    R[0] = 0;
+    legacy.UpdateRef(H, measured, expected, R);
+    TEST_CHECK(Error(legacy.X.data, X_before.data, EKF_NX) == 0, "UpdateRef changed the state with a singular S");
+    TEST_CHECK(Error(legacy.P.data, P_before.data, EKF_NX * EKF_NX) == 0, "UpdateRef changed the covariance with a singular S");
+    R[0] = 0.1f;
+
+    /* Attitude filter converges to the gyroscope bias, with no allocation per step */
+    ekf_imu13states imu;
+    imu.Init();
+    imu.Test();
+    uint32_t allocs = AllocCount();
+    float gyro[3] = {0.1f, 0.2f, 0.3f}, accel[3] = {0, 0, 1}, magn[3] = {1, 0, 0};
+    imu.Process(gyro, EKF_DT);
+    imu.UpdateRefMeasurement(accel, magn, R);
+    TEST_CHECK(AllocCount() == allocs, "ekf_imu13states allocated %u times", AllocCount() - allocs);
+    imu.TestFull(false);
+    for (int i = 0; i < 3; i++) {
+        TEST_CHECK(fabsf(imu.X.data[4 + i] - 0.1f * (i + 1)) < MAX_BIAS_ERROR, "gyro bias %i is %g, expected %g", i, imu.X.data[4 + i], 0.1f * (i + 1));
+    }
+
+    /* Replay of the IMU record: the declared entries of F and G give the same estimates as dense products */
+    ImuRecord();
+    ekf_imu13states sparse, dense;
+    sparse.Init();
+    dense.Init();
+    dense.SparsityDense();
+    float max_difference = 0;
+    for (int n = 0; n < IMU_STEPS; n++) {
+        sparse.Process(record_gyro[n], EKF_DT);
+        dense.Process(record_gyro[n], EKF_DT);
+        TEST_CHECK(sparse.SparsityCovers(), "F or G has values outside the declared entries at step %i", n);
+        sparse.UpdateRefMeasurement(record_accel[n], record_magn[n], R);
+        dense.UpdateRefMeasurement(record_accel[n], record_magn[n], R);
+        for (int i = 0; i < EKF_NX; i++) {
+            max_difference = fmaxf(max_difference, fabsf(sparse.X[i] - dense.X[i]));
+        }
+    }
+    TEST_CHECK(max_difference < MAX_ERROR, "sparse and dense estimates differ by %g", max_difference);
+    for (int i = 0; i < 3; i++) {
+        TEST_CHECK(fabsf(sparse.X[4 + i] - gyro_bias[i]) < MAX_BIAS_ERROR, "replay gyro bias %i is %g, expected %g", i, sparse.X[4 + i], gyro_bias[i]);
+    }
+    printf("\nFixed size EKF: same results as ekf, %u heap allocations in %i steps (ekf: %u)\n", fixed_allocs, EKF_STEPS, legacy_allocs);
+    printf("IMU replay: declared sparsity and dense products differ by %g in %i steps, gyro bias error %g %g %g\n", max_difference, IMU_STEPS,
+           sparse.X[4] - gyro_bias[0], sparse.X[5] - gyro_bias[1], sparse.X[6] - gyro_bias[2]);
+    return true;
+}
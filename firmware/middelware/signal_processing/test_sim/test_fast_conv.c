@@ -0,0 +1,120 @@
+/* Fast convolution and correlation against dsps_conv/corr/ccorr, with both methods and blocks of any size */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "esp_dsp.h"
+#include "dsps_ccorr.h"
+#include "fft.h"
+#include "fast_conv.h"
+#include "test_sim.h"
+
+#define MAX_KERNEL          1024
+#define MAX_BLOCK           256
+#define SIGNAL_LENGHT       2000
+#define MAX_ERROR           1e-4f   /* Relative to the largest output value */
+#define LONG_LENGHT         UINT16_MAX  /* Longest signal: the last block ends past UINT16_MAX */
+#define LONG_KERNEL         7
+
+static float signal[SIGNAL_LENGHT];
+static float kernel[MAX_KERNEL];
+static float expected[SIGNAL_LENGHT + MAX_KERNEL];
+static float result[SIGNAL_LENGHT + MAX_KERNEL];
+static float work[FAST_CONV_WORK_LENGHT(MAX_KERNEL, MAX_BLOCK)];
+static float long_signal[LONG_LENGHT];
+static float long_expected[LONG_LENGHT + LONG_KERNEL];
+static float long_result[LONG_LENGHT + LONG_KERNEL];
+
+/* Largest difference against the expected values, relative to the largest expected value */
+static float Error(const float * values, const float * reference, int lenght)
+{
+    float max_value = 0, max_error = 0;
+    for (int i = 0; i < lenght; i++) {
+        max_value = fmaxf(max_value, fabsf(reference[i]));
+        max_error = fmaxf(max_error, fabsf(values[i] - reference[i]));
+    }
+    return max_error / max_value;
+}
+
+bool test_fast_conv(void)
+{
+    static const uint16_t kernels[] = {1, 7, 64, 300};
+    static const uint16_t blocks[] = {1, 33, 256};
+    static const char * methods[] = {"auto", "direct", "FFT"};
+    fast_conv_t conv;
+
+    TEST_CHECK(FFTInit(), "FFTInit failed");
+    srand(20);
+    for (int i = 0; i < SIGNAL_LENGHT; i++) {
+        signal[i] = (float)rand() / RAND_MAX - 0.5f;
+    }
+    for (int i = 0; i < MAX_KERNEL; i++) {
+        kernel[i] = (float)rand() / RAND_MAX - 0.5f;
+    }
+
+    TEST_CHECK(!FastConvInit(&conv, work, kernel, 0, MAX_BLOCK, FAST_CONV_CONVOLUTION, FAST_CONV_AUTO), "FastConvInit accepted an empty kernel");
+    TEST_CHECK(!FastConvInit(&conv, work, kernel, MAX_KERNEL, 0, FAST_CONV_CONVOLUTION, FAST_CONV_AUTO), "FastConvInit accepted empty blocks");
+    TEST_CHECK(!FastConvInit(&conv, work, kernel, 4000, 1000, FAST_CONV_CONVOLUTION, FAST_CONV_FFT), "FastConvInit accepted an FFT above the tables");
+    TEST_CHECK(FastConvInit(&conv, work, kernel, 16, 32, FAST_CONV_CONVOLUTION, FAST_CONV_DIRECT), "FastConvInit failed");
+    TEST_CHECK(!FastConvBlock(&conv, signal, result, 33), "FastConvBlock accepted more than block_lenght samples");
+
+    /* Same results as the esp-dsp functions, with every method and block lenght */
+    for (int k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++) {
+        uint16_t kernel_lenght = kernels[k];
+        for (int b = 0; b < sizeof(blocks) / sizeof(blocks[0]); b++) {
+            for (int m = FAST_CONV_AUTO; m <= FAST_CONV_FFT; m++) {
+                TEST_CHECK(FastConvInit(&conv, work, kernel, kernel_lenght, blocks[b], FAST_CONV_CONVOLUTION, m),
+                           "FastConvInit failed (%u, %u, %s)", kernel_lenght, blocks[b], methods[m]);
+                dsps_conv_f32_ansi(signal, SIGNAL_LENGHT, kernel, kernel_lenght, expected);
+                FastConvFull(&conv, signal, SIGNAL_LENGHT, result);
+                float error = Error(result, expected, SIGNAL_LENGHT + kernel_lenght - 1);
+                TEST_CHECK(error < MAX_ERROR, "convolution error %g (kernel %u, block %u, %s)", error, kernel_lenght, blocks[b], methods[m]);
+
+                TEST_CHECK(FastConvInit(&conv, work, kernel, kernel_lenght, blocks[b], FAST_CONV_CORRELATION, m),
+                           "FastConvInit failed (%u, %u, %s)", kernel_lenght, blocks[b], methods[m]);
+                dsps_ccorr_f32_ansi(signal, SIGNAL_LENGHT, kernel, kernel_lenght, expected);
+                FastConvFull(&conv, signal, SIGNAL_LENGHT, result);
+                error = Error(result, expected, SIGNAL_LENGHT + kernel_lenght - 1);
+                TEST_CHECK(error < MAX_ERROR, "cross correlation error %g (kernel %u, block %u, %s)", error, kernel_lenght, blocks[b], methods[m]);
+                dsps_corr_f32_ansi(signal, SIGNAL_LENGHT, kernel, kernel_lenght, expected);
+                TEST_CHECK(FastConvValid(&conv, signal, SIGNAL_LENGHT, result), "FastConvValid failed");
+                error = Error(result, expected, SIGNAL_LENGHT - kernel_lenght + 1);
+                TEST_CHECK(error < MAX_ERROR, "correlation error %g (kernel %u, block %u, %s)", error, kernel_lenght, blocks[b], methods[m]);
+            }
+        }
+    }
+
+    /* Streaming with blocks of random sizes, in place, gives the same samples */
+    TEST_CHECK(FastConvInit(&conv, work, kernel, 300, MAX_BLOCK, FAST_CONV_CONVOLUTION, FAST_CONV_FFT), "FastConvInit failed");
+    dsps_conv_f32_ansi(signal, SIGNAL_LENGHT, kernel, 300, expected);
+    memcpy(result, signal, sizeof(signal));
+    for (int i = 0, n; i < SIGNAL_LENGHT; i += n) {
+        n = 1 + rand() % MAX_BLOCK;
+        n = (n > SIGNAL_LENGHT - i) ? SIGNAL_LENGHT - i : n;
+        TEST_CHECK(FastConvBlock(&conv, &result[i], &result[i], n), "FastConvBlock failed");
+    }
+    float error = Error(result, expected, SIGNAL_LENGHT);
+    TEST_CHECK(error < MAX_ERROR, "streaming convolution error %g", error);
+
+    /* Longest signal: the block indexes must not wrap around at UINT16_MAX */
+    for (int i = 0; i < LONG_LENGHT; i++) {
+        long_signal[i] = signal[i % SIGNAL_LENGHT];
+    }
+    TEST_CHECK(FastConvInit(&conv, work, kernel, LONG_KERNEL, MAX_BLOCK, FAST_CONV_CONVOLUTION, FAST_CONV_DIRECT), "FastConvInit failed");
+    dsps_conv_f32_ansi(long_signal, LONG_LENGHT, kernel, LONG_KERNEL, long_expected);
+    FastConvFull(&conv, long_signal, LONG_LENGHT, long_result);
+    error = Error(long_result, long_expected, LONG_LENGHT + LONG_KERNEL - 1);
+    TEST_CHECK(error < MAX_ERROR, "convolution error %g with %i samples", error, LONG_LENGHT);
+    dsps_corr_f32_ansi(long_signal, LONG_LENGHT, kernel, LONG_KERNEL, long_expected);
+    TEST_CHECK(FastConvInit(&conv, work, kernel, LONG_KERNEL, MAX_BLOCK, FAST_CONV_CORRELATION, FAST_CONV_DIRECT), "FastConvInit failed");
+    TEST_CHECK(FastConvValid(&conv, long_signal, LONG_LENGHT, long_result), "FastConvValid failed");
+    error = Error(long_result, long_expected, LONG_LENGHT - LONG_KERNEL + 1);
+    TEST_CHECK(error < MAX_ERROR, "correlation error %g with %i samples", error, LONG_LENGHT);
+
+    /* Short kernels are filtered directly, long ones with the FFT (make bench prints the crossover) */
+    TEST_CHECK(FastConvInit(&conv, work, kernel, 4, MAX_BLOCK, FAST_CONV_CONVOLUTION, FAST_CONV_AUTO) && (conv.fft_lenght == 0), "auto method is not direct for 4 values");
+    TEST_CHECK(FastConvInit(&conv, work, kernel, MAX_KERNEL, MAX_BLOCK, FAST_CONV_CONVOLUTION, FAST_CONV_AUTO) && (conv.fft_lenght != 0), "auto method is not FFT for %i values", MAX_KERNEL);
+    printf("\nFast convolution: direct and FFT methods match dsps_conv, dsps_corr and dsps_ccorr (max error %g)\n", MAX_ERROR);
+    return true;
+}
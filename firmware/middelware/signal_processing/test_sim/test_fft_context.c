@@ -0,0 +1,119 @@
+/* FFT contexts: same result as FFTMagnitude(), in place, and from several threads at the same time */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "esp_dsp.h"
+#include "fft.h"
+#include "test_sim.h"
+
+#define THREAD_ITERATIONS   300
+
+typedef struct {
+    uint16_t lenght;
+    bool q15;
+    float signal[MAX_SIGNAL_LENGHT];
+    uint16_t signal_q15[MAX_SIGNAL_LENGHT];
+    float reference[MAX_SIGNAL_LENGHT / 2];
+    uint16_t reference_q15[MAX_SIGNAL_LENGHT / 2];
+    float work[FFT_CONTEXT_LENGHT(MAX_SIGNAL_LENGHT)];
+    int16_t work_q15[FFT_CONTEXT_LENGHT(MAX_SIGNAL_LENGHT)];
+    fft_context_t ctx;
+    fft_context_q15_t ctx_q15;
+    int errors;
+} fft_thread_t;
+
+static float signal[MAX_SIGNAL_LENGHT];
+static uint16_t signal_q15[MAX_SIGNAL_LENGHT];
+static float fft[MAX_SIGNAL_LENGHT / 2];
+static uint16_t fft_q15[MAX_SIGNAL_LENGHT / 2];
+static float work[FFT_CONTEXT_LENGHT(MAX_SIGNAL_LENGHT)];
+static int16_t work_q15[FFT_CONTEXT_LENGHT(MAX_SIGNAL_LENGHT)];
+static fft_thread_t threads[3];
+
+static void FillSignal(float * values, uint16_t * values_q15, uint16_t lenght)
+{
+    for (int i = 0; i < lenght; i++) {
+        values_q15[i] = (uint16_t)(rand() % (MAX_Q15_INPUT + 1));
+        values[i] = values_q15[i];
+    }
+}
+
+static void * FFTThread(void * arg)
+{
+    fft_thread_t * thread = (fft_thread_t *)arg;
+    float out[MAX_SIGNAL_LENGHT / 2];
+    uint16_t out_q15[MAX_SIGNAL_LENGHT / 2];
+
+    for (int i = 0; i < THREAD_ITERATIONS; i++) {
+        if (thread->q15) {
+            FFTContextMagnitudeQ15(&thread->ctx_q15, thread->signal_q15, out_q15);
+            thread->errors += memcmp(out_q15, thread->reference_q15, thread->lenght / 2 * sizeof(uint16_t)) != 0;
+        } else {
+            FFTContextMagnitude(&thread->ctx, thread->signal, out);
+            thread->errors += memcmp(out, thread->reference, thread->lenght / 2 * sizeof(float)) != 0;
+        }
+    }
+    return NULL;
+}
+
+bool test_fft_context(void)
+{
+    fft_context_t ctx;
+    fft_context_q15_t ctx_q15;
+
+    TEST_CHECK(FFTInit(), "FFTInit failed");
+    TEST_CHECK(!FFTContextInit(&ctx, work, 3), "FFTContextInit accepted a lenght of 3");
+    TEST_CHECK(!FFTContextInit(&ctx, work, 2 * MAX_SIGNAL_LENGHT), "FFTContextInit accepted a lenght of %i", 2 * MAX_SIGNAL_LENGHT);
+    TEST_CHECK(!FFTContextInit(&ctx, NULL, 256), "FFTContextInit accepted a NULL workspace");
+    TEST_CHECK(!FFTContextInitQ15(&ctx_q15, NULL, 256), "FFTContextInitQ15 accepted a NULL workspace");
+
+    srand(15);
+    for (int n = 4; n <= MAX_SIGNAL_LENGHT; n <<= 1) {
+        FillSignal(signal, signal_q15, n);
+        TEST_CHECK(FFTContextInit(&ctx, work, n), "FFTContextInit (%i) failed", n);
+        TEST_CHECK(FFTContextInitQ15(&ctx_q15, work_q15, n), "FFTContextInitQ15 (%i) failed", n);
+
+        /* Separate workspace */
+        FFTMagnitude(signal, fft, n);
+        FFTContextMagnitude(&ctx, signal, work);
+        TEST_CHECK(memcmp(work, fft, n / 2 * sizeof(float)) == 0, "FFTContextMagnitude (%i) differs from FFTMagnitude", n);
+        FFTMagnitudeQ15(signal_q15, fft_q15, n);
+        FFTContextMagnitudeQ15(&ctx_q15, signal_q15, (uint16_t *)work_q15);
+        TEST_CHECK(memcmp(work_q15, fft_q15, n / 2 * sizeof(uint16_t)) == 0, "FFTContextMagnitudeQ15 (%i) differs from FFTMagnitudeQ15", n);
+
+        /* Fully in place: the signal array is the workspace and receives the magnitudes */
+        TEST_CHECK(FFTContextInit(&ctx, signal, n), "FFTContextInit (%i) failed", n);
+        FFTContextMagnitude(&ctx, signal, signal);
+        TEST_CHECK(memcmp(signal, fft, n / 2 * sizeof(float)) == 0, "in place FFTContextMagnitude (%i) differs from FFTMagnitude", n);
+        TEST_CHECK(FFTContextInitQ15(&ctx_q15, (int16_t *)signal_q15, n), "FFTContextInitQ15 (%i) failed", n);
+        FFTContextMagnitudeQ15(&ctx_q15, signal_q15, signal_q15);
+        TEST_CHECK(memcmp(signal_q15, fft_q15, n / 2 * sizeof(uint16_t)) == 0, "in place FFTContextMagnitudeQ15 (%i) differs from FFTMagnitudeQ15", n);
+    }
+
+    /* Independent contexts computed at the same time */
+    static const uint16_t lenghts[] = {2048, 512, 1024};
+    static const bool q15[] = {false, true, false};
+    pthread_t ids[3];
+    for (int t = 0; t < 3; t++) {
+        threads[t].lenght = lenghts[t];
+        threads[t].q15 = q15[t];
+        threads[t].errors = 0;
+        FillSignal(threads[t].signal, threads[t].signal_q15, lenghts[t]);
+        FFTMagnitude(threads[t].signal, threads[t].reference, lenghts[t]);
+        FFTMagnitudeQ15(threads[t].signal_q15, threads[t].reference_q15, lenghts[t]);
+        TEST_CHECK(FFTContextInit(&threads[t].ctx, threads[t].work, lenghts[t]), "FFTContextInit (%i) failed", lenghts[t]);
+        TEST_CHECK(FFTContextInitQ15(&threads[t].ctx_q15, threads[t].work_q15, lenghts[t]), "FFTContextInitQ15 (%i) failed", lenghts[t]);
+    }
+    for (int t = 0; t < 3; t++) {
+        TEST_CHECK(pthread_create(&ids[t], NULL, FFTThread, &threads[t]) == 0, "pthread_create failed");
+    }
+    for (int t = 0; t < 3; t++) {
+        pthread_join(ids[t], NULL);
+        TEST_CHECK(threads[t].errors == 0, "thread %i (%i samples): %i wrong spectra", t, threads[t].lenght, threads[t].errors);
+    }
+
+    printf("FFT contexts: same spectra as FFTMagnitude, in place and from 3 threads\n");
+    return true;
+}
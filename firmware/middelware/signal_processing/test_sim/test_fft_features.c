@@ -0,0 +1,137 @@
+/* Spectral features against the same values computed from FFTMagnitude() and FFTFrequency(), and their cost */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "esp_dsp.h"
+#include "fft.h"
+#include "test_sim.h"
+
+#define BENCH_ITERATIONS    200
+#define SAMPLE_FREQ         1000.0f
+#define TONE_FREQ           53.7f
+#define TONE_AMPLITUDE      1000.0f
+#define MIN_FREQ            10.0f
+#define N_BANDS             4
+#define MAX_POWER_ERROR     1e-4f   /* Relative */
+#define MAX_PEAK_ERROR      0.05f   /* Bins */
+#define MAX_AMPLITUDE_ERROR 0.005f  /* Relative */
+
+static const float bands[2 * N_BANDS] = {0, 50, 40, 100, 100, 500, 300, 320};
+
+static float signal[MAX_SIGNAL_LENGHT];
+static float fft[MAX_SIGNAL_LENGHT / 2];
+static float f[MAX_SIGNAL_LENGHT / 2];
+static float work[FFT_CONTEXT_LENGHT(MAX_SIGNAL_LENGHT)];
+
+/* What the applications did before: magnitudes, frequency axis and a loop for each feature */
+static void ReferenceFeatures(uint16_t n, fft_features_t * features)
+{
+    int half = n / 2;
+    FFTMagnitude(signal, fft, n);
+    FFTFrequency(SAMPLE_FREQ, n, f);
+
+    int peak = 0;
+    float peak_value = -1;
+    for (int k = 0; k < half; k++) {
+        if ((f[k] >= MIN_FREQ) && (fft[k] > peak_value)) {
+            peak_value = fft[k];
+            peak = k;
+        }
+    }
+    float total = 0, sum = 0, weighted = 0;
+    for (int k = 0; k < half; k++) {
+        if (f[k] >= MIN_FREQ) {
+            total += fft[k] * fft[k];
+            sum += fft[k];
+            weighted += fft[k] * f[k];
+        }
+    }
+    float signal_power = 0;
+    for (int k = peak - 2; k <= peak + 2; k++) {
+        signal_power += fft[k] * fft[k];
+    }
+    for (int b = 0; b < N_BANDS; b++) {
+        features->band_power[b] = 0;
+        for (int k = 0; k < half; k++) {
+            if ((f[k] >= bands[2 * b]) && (f[k] < bands[2 * b + 1])) {
+                features->band_power[b] += fft[k] * fft[k];
+            }
+        }
+    }
+    features->peak_frequency = f[peak];
+    features->peak_magnitude = peak_value;
+    features->total_power = total;
+    features->centroid = weighted / sum;
+    features->snr = 10 * log10f(signal_power / (total - signal_power));
+}
+
+static bool Close(float value, float reference)
+{
+    return fabsf(value - reference) <= MAX_POWER_ERROR * fabsf(reference) + 1e-6f;
+}
+
+bool test_fft_features(void)
+{
+    fft_features_config_t config;
+    fft_features_t features, reference, features_ctx;
+    fft_context_t ctx;
+
+    TEST_CHECK(FFTInit(), "FFTInit failed");
+    TEST_CHECK(!FFTFeaturesInit(&config, SAMPLE_FREQ, 100, MIN_FREQ, bands, N_BANDS), "FFTFeaturesInit accepted a lenght of 100");
+    TEST_CHECK(!FFTFeaturesInit(&config, SAMPLE_FREQ, 256, SAMPLE_FREQ / 2, bands, N_BANDS), "FFTFeaturesInit accepted min_freq = sample_freq / 2");
+    TEST_CHECK(!FFTFeaturesInit(&config, SAMPLE_FREQ, 256, MIN_FREQ, bands, FFT_MAX_BANDS + 1), "FFTFeaturesInit accepted %i bands", FFT_MAX_BANDS + 1);
+    static const float inverted[2] = {100, 50};
+    TEST_CHECK(!FFTFeaturesInit(&config, SAMPLE_FREQ, 256, MIN_FREQ, inverted, 1), "FFTFeaturesInit accepted an inverted band");
+
+    printf("\nFFTFeatures vs FFTMagnitude + FFTFrequency + loops (tone of %.1f Hz, fs = %.0f Hz)\n", TONE_FREQ, SAMPLE_FREQ);
+    printf("%6s %12s %12s %10s %14s %14s\n", "N", "peak error", "amp error", "SNR", "loops " TICKS_UNIT, "fused " TICKS_UNIT);
+    srand(16);
+    for (int n = 256; n <= MAX_SIGNAL_LENGHT; n <<= 1) {
+        for (int i = 0; i < n; i++) {
+            signal[i] = 1650.0f + TONE_AMPLITUDE * sinf(2 * M_PI * TONE_FREQ / SAMPLE_FREQ * i)
+                        + 200.0f * sinf(2 * M_PI * 0.31f * i) + 20.0f * ((float)rand() / RAND_MAX - 0.5f);
+        }
+        TEST_CHECK(FFTFeaturesInit(&config, SAMPLE_FREQ, n, MIN_FREQ, bands, N_BANDS), "FFTFeaturesInit (%i) failed", n);
+        TEST_CHECK(FFTFeatures(&config, signal, &features), "FFTFeatures (%i) failed", n);
+        ReferenceFeatures(n, &reference);
+
+        float bin_width = SAMPLE_FREQ / n;
+        float peak_error = fabsf(features.peak_frequency - TONE_FREQ) / bin_width;
+        float amplitude_error = fabsf(features.peak_magnitude - TONE_AMPLITUDE) / TONE_AMPLITUDE;
+        TEST_CHECK(peak_error < MAX_PEAK_ERROR, "N = %i, peak at %f Hz", n, features.peak_frequency);
+        TEST_CHECK(fabsf(features.peak_frequency - reference.peak_frequency) < bin_width, "N = %i, peak at %f Hz, reference %f Hz", n, features.peak_frequency, reference.peak_frequency);
+        TEST_CHECK(amplitude_error < MAX_AMPLITUDE_ERROR, "N = %i, peak magnitude %f", n, features.peak_magnitude);
+        TEST_CHECK(Close(features.total_power, reference.total_power), "N = %i, total power %f, reference %f", n, features.total_power, reference.total_power);
+        TEST_CHECK(Close(features.centroid, reference.centroid), "N = %i, centroid %f, reference %f", n, features.centroid, reference.centroid);
+        TEST_CHECK(fabsf(features.snr - reference.snr) < 0.01f, "N = %i, SNR %f, reference %f", n, features.snr, reference.snr);
+        for (int b = 0; b < N_BANDS; b++) {
+            TEST_CHECK(Close(features.band_power[b], reference.band_power[b]), "N = %i, band %i power %f, reference %f", n, b, features.band_power[b], reference.band_power[b]);
+        }
+
+        /* Context version, in place in a copy of the signal */
+        memcpy(work, signal, n * sizeof(float));
+        TEST_CHECK(FFTContextInit(&ctx, work, n), "FFTContextInit (%i) failed", n);
+        TEST_CHECK(FFTContextFeatures(&ctx, &config, work, &features_ctx), "FFTContextFeatures (%i) failed", n);
+        TEST_CHECK(memcmp(&features_ctx, &features, sizeof(features)) == 0, "N = %i, FFTContextFeatures differs from FFTFeatures", n);
+
+        uint32_t start = dsp_get_cpu_cycle_count();
+        for (int i = 0; i < BENCH_ITERATIONS; i++) {
+            ReferenceFeatures(n, &reference);
+        }
+        uint32_t loops_ticks = (dsp_get_cpu_cycle_count() - start) / BENCH_ITERATIONS;
+        start = dsp_get_cpu_cycle_count();
+        for (int i = 0; i < BENCH_ITERATIONS; i++) {
+            FFTFeatures(&config, signal, &features);
+        }
+        uint32_t fused_ticks = (dsp_get_cpu_cycle_count() - start) / BENCH_ITERATIONS;
+        printf("%6i %12.4f %12.4f %10.1f %14u %14u\n", n, peak_error, amplitude_error, features.snr, (unsigned)loops_ticks, (unsigned)fused_ticks);
+    }
+
+    /* Context and configuration of different lenghts */
+    TEST_CHECK(FFTContextInit(&ctx, work, 512), "FFTContextInit failed");
+    TEST_CHECK(FFTFeaturesInit(&config, SAMPLE_FREQ, 1024, MIN_FREQ, bands, N_BANDS), "FFTFeaturesInit failed");
+    TEST_CHECK(!FFTContextFeatures(&ctx, &config, signal, &features), "FFTContextFeatures accepted different lenghts");
+    return true;
+}
@@ -0,0 +1,125 @@
+/* Goertzel bank magnitudes against FFTMagnitude() / FFTMagnitudeQ15(), and cost of both approaches */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "esp_dsp.h"
+#include "fft.h"
+#include "test_sim.h"
+
+#define SAMPLE_FREQ     1000.0f
+#define N_BINS          4
+#define BENCH_ITERATIONS    200
+#define MAX_ERROR       0.01f   /* relative to the FFT peak */
+#define MAX_ERROR_Q15   4.0f    /* in input units (mV) */
+
+static uint16_t signal_q15[MAX_SIGNAL_LENGHT];
+static float signal[MAX_SIGNAL_LENGHT];
+static uint16_t fft_q15[MAX_SIGNAL_LENGHT / 2];
+static float fft[MAX_SIGNAL_LENGHT / 2];
+static float goertzel_buffer[FFT_GOERTZEL_LENGHT(N_BINS)];
+static int32_t goertzel_buffer_q15[FFT_GOERTZEL_LENGHT(N_BINS)];
+
+bool test_fft_goertzel(void)
+{
+    fft_goertzel_t goertzel;
+    fft_goertzel_q15_t goertzel_q15;
+    float magnitude[N_BINS];
+    uint16_t magnitude_q15[N_BINS];
+
+    TEST_CHECK(FFTInit(), "FFTInit failed");
+
+    printf("\nGoertzel bank (%i bins) vs FFTMagnitude (input in mV, 0 to %i)\n", N_BINS, MAX_Q15_INPUT);
+    printf("%6s %12s %12s %12s %14s %14s %14s\n", "N", "max error", "Q15 error", "peak",
+           "FFT " TICKS_UNIT, "Goertzel " TICKS_UNIT, "Q15 " TICKS_UNIT);
+    srand(3);
+    for (int n = 64; n <= MAX_SIGNAL_LENGHT; n <<= 1) {
+        float step = SAMPLE_FREQ / n;
+        int bins[N_BINS] = {1, n / 20, n / 20 + 3, n / 2 - 1};
+        float frequencies[N_BINS];
+        for (int k = 0; k < N_BINS; k++) {
+            frequencies[k] = bins[k] * step;
+        }
+        for (int i = 0; i < n; i++) {
+            float value = 1650.0f + 1200.0f * sinf(2 * M_PI * 0.05f * i) + 300.0f * sinf(2 * M_PI * 0.47f * i)
+                          + 20.0f * ((float)rand() / RAND_MAX - 0.5f);
+            signal_q15[i] = (uint16_t)value;
+            signal[i] = signal_q15[i];
+        }
+        FFTMagnitude(signal, fft, n);
+        FFTMagnitudeQ15(signal_q15, fft_q15, n);
+
+        TEST_CHECK(FFTGoertzelInit(&goertzel, goertzel_buffer, frequencies, N_BINS, SAMPLE_FREQ, n), "FFTGoertzelInit failed");
+        TEST_CHECK(FFTGoertzelInitQ15(&goertzel_q15, goertzel_buffer_q15, frequencies, N_BINS, SAMPLE_FREQ, n), "FFTGoertzelInitQ15 failed");
+        for (int i = 0; i < n; i++) {
+            bool done = FFTGoertzelUpdate(&goertzel, signal[i]);
+            bool done_q15 = FFTGoertzelUpdateQ15(&goertzel_q15, signal_q15[i]);
+            TEST_CHECK(done == (i == n - 1), "N = %i, block completed at sample %i", n, i);
+            TEST_CHECK(done_q15 == done, "N = %i, Q15 block completed at sample %i", n, i);
+        }
+        TEST_CHECK(FFTGoertzelGetMagnitude(&goertzel, magnitude), "N = %i, no magnitudes", n);
+        TEST_CHECK(!FFTGoertzelGetMagnitude(&goertzel, magnitude), "N = %i, magnitudes read twice", n);
+        TEST_CHECK(FFTGoertzelGetMagnitudeQ15(&goertzel_q15, magnitude_q15), "N = %i, no Q15 magnitudes", n);
+
+        float peak = 0;
+        for (int k = 0; k < n / 2; k++) {
+            peak = fmaxf(peak, fft[k]);
+        }
+        float max_error = 0;
+        float max_error_q15 = 0;
+        for (int k = 0; k < N_BINS; k++) {
+            max_error = fmaxf(max_error, fabsf(magnitude[k] - fft[bins[k]]) / peak);
+            max_error_q15 = fmaxf(max_error_q15, fabsf((float)magnitude_q15[k] - fft_q15[bins[k]]));
+        }
+
+        uint32_t start = dsp_get_cpu_cycle_count();
+        for (int i = 0; i < BENCH_ITERATIONS; i++) {
+            FFTMagnitude(signal, fft, n);
+        }
+        uint32_t fft_ticks = (dsp_get_cpu_cycle_count() - start) / BENCH_ITERATIONS;
+        start = dsp_get_cpu_cycle_count();
+        for (int i = 0; i < BENCH_ITERATIONS; i++) {
+            for (int j = 0; j < n; j++) {
+                FFTGoertzelUpdate(&goertzel, signal[j]);
+            }
+        }
+        uint32_t goertzel_ticks = (dsp_get_cpu_cycle_count() - start) / BENCH_ITERATIONS;
+        start = dsp_get_cpu_cycle_count();
+        for (int i = 0; i < BENCH_ITERATIONS; i++) {
+            for (int j = 0; j < n; j++) {
+                FFTGoertzelUpdateQ15(&goertzel_q15, signal_q15[j]);
+            }
+        }
+        uint32_t q15_ticks = (dsp_get_cpu_cycle_count() - start) / BENCH_ITERATIONS;
+
+        printf("%6i %12.6f %12.2f %12.2f %14u %14u %14u\n", n, max_error, max_error_q15, peak,
+               (unsigned)fft_ticks, (unsigned)goertzel_ticks, (unsigned)q15_ticks);
+        TEST_CHECK(max_error < MAX_ERROR, "N = %i, error %f", n, max_error);
+        TEST_CHECK(max_error_q15 < MAX_ERROR_Q15, "N = %i, Q15 error %f", n, max_error_q15);
+    }
+
+    /* DC is only available in the float version, and is halved as in FFTMagnitude() */
+    float dc = 0;
+    TEST_CHECK(FFTGoertzelInit(&goertzel, goertzel_buffer, &dc, 1, SAMPLE_FREQ, 256), "DC init failed");
+    TEST_CHECK(!FFTGoertzelInitQ15(&goertzel_q15, goertzel_buffer_q15, &dc, 1, SAMPLE_FREQ, 256), "Q15 must reject DC");
+    for (int i = 0; i < 256; i++) {
+        signal[i] = 1000.0f;
+        FFTGoertzelUpdate(&goertzel, signal[i]);
+    }
+    FFTMagnitude(signal, fft, 256);
+    FFTGoertzelGetMagnitude(&goertzel, magnitude);
+    TEST_CHECK(fabsf(magnitude[0] - fft[0]) < 1e-3f * fft[0], "DC: %f vs %f", magnitude[0], fft[0]);
+
+    /* Full scale input must not overflow, even at the lowest frequency */
+    float lowest = SAMPLE_FREQ / MAX_SIGNAL_LENGHT;
+    TEST_CHECK(FFTGoertzelInitQ15(&goertzel_q15, goertzel_buffer_q15, &lowest, 1, SAMPLE_FREQ, MAX_SIGNAL_LENGHT), "Q15 init failed");
+    for (int i = 0; i < MAX_SIGNAL_LENGHT; i++) {
+        signal_q15[i] = (sinf(2 * M_PI * i / MAX_SIGNAL_LENGHT) > 0) ? MAX_Q15_INPUT : 0;
+        signal[i] = signal_q15[i];
+        FFTGoertzelUpdateQ15(&goertzel_q15, signal_q15[i]);
+    }
+    FFTMagnitude(signal, fft, MAX_SIGNAL_LENGHT);
+    FFTGoertzelGetMagnitudeQ15(&goertzel_q15, magnitude_q15);
+    TEST_CHECK(fabsf(fft[1] - magnitude_q15[0]) < MAX_ERROR_Q15, "full scale: %f vs %i", fft[1], magnitude_q15[0]);
+    return true;
+}
@@ -0,0 +1,68 @@
+/* Accuracy and speed of FFTMagnitudeQ15() against the floating point FFTMagnitude() */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "esp_dsp.h"
+#include "fft.h"
+#include "test_sim.h"
+
+#define BENCH_ITERATIONS    200
+#define MAX_ERROR           4.0f    /* in input units (mV) */
+
+static uint16_t signal_q15[MAX_SIGNAL_LENGHT];
+static float signal[MAX_SIGNAL_LENGHT];
+static uint16_t fft_q15[MAX_SIGNAL_LENGHT / 2];
+static float fft[MAX_SIGNAL_LENGHT / 2];
+
+bool test_fft_q15(void)
+{
+    TEST_CHECK(FFTInit(), "FFTInit failed");
+
+    printf("\nFFTMagnitudeQ15 vs FFTMagnitude (input in mV, 0 to %i)\n", MAX_Q15_INPUT);
+    printf("%6s %12s %12s %14s %14s\n", "N", "max error", "peak", "float " TICKS_UNIT, "Q15 " TICKS_UNIT);
+    srand(2);
+    for (int n = 64; n <= MAX_SIGNAL_LENGHT; n <<= 1) {
+        for (int i = 0; i < n; i++) {
+            float value = 1650.0f + 1200.0f * sinf(2 * M_PI * 0.05f * i) + 300.0f * sinf(2 * M_PI * 0.31f * i)
+                          + 20.0f * ((float)rand() / RAND_MAX - 0.5f);
+            signal_q15[i] = (uint16_t)value;
+            signal[i] = signal_q15[i];
+        }
+        FFTMagnitude(signal, fft, n);
+        FFTMagnitudeQ15(signal_q15, fft_q15, n);
+
+        float max_error = 0;
+        float peak = 0;
+        for (int k = 0; k < n / 2; k++) {
+            max_error = fmaxf(max_error, fabsf(fft[k] - fft_q15[k]));
+            peak = fmaxf(peak, fft[k]);
+        }
+
+        uint32_t start = dsp_get_cpu_cycle_count();
+        for (int i = 0; i < BENCH_ITERATIONS; i++) {
+            FFTMagnitude(signal, fft, n);
+        }
+        uint32_t float_ticks = (dsp_get_cpu_cycle_count() - start) / BENCH_ITERATIONS;
+        start = dsp_get_cpu_cycle_count();
+        for (int i = 0; i < BENCH_ITERATIONS; i++) {
+            FFTMagnitudeQ15(signal_q15, fft_q15, n);
+        }
+        uint32_t q15_ticks = (dsp_get_cpu_cycle_count() - start) / BENCH_ITERATIONS;
+
+        printf("%6i %12.2f %12.2f %14u %14u\n", n, max_error, peak, (unsigned)float_ticks, (unsigned)q15_ticks);
+        TEST_CHECK(max_error < MAX_ERROR, "N = %i, error %f", n, max_error);
+    }
+
+    /* Full scale input must not overflow */
+    for (int i = 0; i < MAX_SIGNAL_LENGHT; i++) {
+        signal_q15[i] = (i & 0x01) ? MAX_Q15_INPUT : 0;
+        signal[i] = signal_q15[i];
+    }
+    FFTMagnitude(signal, fft, MAX_SIGNAL_LENGHT);
+    FFTMagnitudeQ15(signal_q15, fft_q15, MAX_SIGNAL_LENGHT);
+    for (int k = 0; k < MAX_SIGNAL_LENGHT / 2; k++) {
+        TEST_CHECK(fabsf(fft[k] - fft_q15[k]) < MAX_ERROR, "full scale, bin %i: %f vs %i", k, fft[k], fft_q15[k]);
+    }
+    return true;
+}
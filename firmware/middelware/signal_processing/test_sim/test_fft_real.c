@@ -0,0 +1,88 @@
+/* Accuracy and speed of the real-input FFTMagnitude() against the previous
+ * complex-input implementation (N-point complex FFT with zero imaginary part). */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "esp_dsp.h"
+#include "fft.h"
+#include "test_sim.h"
+
+#define BENCH_ITERATIONS    200
+#define MAX_ERROR           1e-4f   /* relative to the largest magnitude */
+
+static float signal[MAX_SIGNAL_LENGHT];
+static float window[MAX_SIGNAL_LENGHT];
+static float ref_complex[2 * MAX_SIGNAL_LENGHT];
+static float ref_fft[MAX_SIGNAL_LENGHT / 2];
+static float fft[MAX_SIGNAL_LENGHT / 2];
+
+/* Previous FFTMagnitude() implementation */
+static void FFTMagnitudeComplex(float *signal, float *fft, uint16_t signal_lenght)
+{
+    dsps_wind_hann_f32(window, signal_lenght);
+    memset(ref_complex, 0, 2 * MAX_SIGNAL_LENGHT * sizeof(float));
+    dsps_mul_f32(signal, window, ref_complex, signal_lenght, 1, 1, 2);
+    dsps_fft2r_fc32(ref_complex, signal_lenght);
+    dsps_bit_rev_fc32(ref_complex, signal_lenght);
+    dsps_cplx2reC_fc32(ref_complex, signal_lenght);
+    for (int j = 0; j < signal_lenght; j++) {
+        ref_complex[j] = 2 * (sqrt(ref_complex[j * 2 + 0] * ref_complex[j * 2 + 0] + ref_complex[j * 2 + 1] * ref_complex[j * 2 + 1])) / (signal_lenght / 2);
+    }
+    ref_complex[0] = ref_complex[0] / 2;
+    memcpy(fft, ref_complex, (signal_lenght / 2) * sizeof(float));
+}
+
+bool test_fft_real(void)
+{
+    TEST_CHECK(FFTInit(), "FFTInit failed");
+
+    printf("\nReal-input FFTMagnitude vs complex-input implementation\n");
+    printf("%6s %12s %14s %14s %8s\n", "N", "max error", "complex " TICKS_UNIT, "real " TICKS_UNIT, "speedup");
+    srand(1);
+    for (int n = 64; n <= MAX_SIGNAL_LENGHT; n <<= 1) {
+        for (int i = 0; i < n; i++) {
+            signal[i] = 1.5f + 3.0f * sinf(2 * M_PI * 0.1f * i) + 0.7f * cosf(2 * M_PI * 0.37f * i)
+                        + 0.1f * ((float)rand() / RAND_MAX - 0.5f);
+        }
+        FFTMagnitudeComplex(signal, ref_fft, n);
+        FFTMagnitude(signal, fft, n);
+
+        /* The complex implementation doubles every bin but DC (dsps_cplx2reC_fc32
+         * returns X[k] + conj(X[N-k])), the real one returns the sine amplitude */
+        float max_mag = 0;
+        float max_error = 0;
+        for (int k = 0; k < n / 2; k++) {
+            float ref = (k == 0) ? ref_fft[k] : ref_fft[k] / 2;
+            max_mag = fmaxf(max_mag, ref);
+            max_error = fmaxf(max_error, fabsf(fft[k] - ref));
+        }
+        max_error /= max_mag;
+
+        uint32_t start = dsp_get_cpu_cycle_count();
+        for (int i = 0; i < BENCH_ITERATIONS; i++) {
+            FFTMagnitudeComplex(signal, ref_fft, n);
+        }
+        uint32_t complex_ticks = (dsp_get_cpu_cycle_count() - start) / BENCH_ITERATIONS;
+        start = dsp_get_cpu_cycle_count();
+        for (int i = 0; i < BENCH_ITERATIONS; i++) {
+            FFTMagnitude(signal, fft, n);
+        }
+        uint32_t real_ticks = (dsp_get_cpu_cycle_count() - start) / BENCH_ITERATIONS;
+
+        printf("%6i %12.2e %14u %14u %7.2fx\n", n, max_error, (unsigned)complex_ticks, (unsigned)real_ticks,
+               (float)complex_ticks / real_ticks);
+        TEST_CHECK(max_error < MAX_ERROR, "N = %i, error %e", n, max_error);
+    }
+    /* Documented scale: amplitude of a sine centered on a bin, and the constant value at DC */
+    for (int i = 0; i < 256; i++) {
+        signal[i] = 1.5f + 3.0f * sinf(2 * M_PI * 16 * i / 256);
+    }
+    FFTMagnitude(signal, fft, 256);
+    float gain = 255.0f / 256;
+    TEST_CHECK((fabsf(fft[16] - 3.0f * gain) < 1e-3f) && (fabsf(fft[0] - 1.5f * gain) < 1e-3f), "FFTMagnitude scale: sine %f, DC %f", fft[16], fft[0]);
+    printf("Working buffer: complex %u bytes, real %u bytes\n",
+           (unsigned)(2 * MAX_SIGNAL_LENGHT * sizeof(float)), (unsigned)(MAX_SIGNAL_LENGHT * sizeof(float)));
+    return true;
+}
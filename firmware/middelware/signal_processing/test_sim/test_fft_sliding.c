@@ -0,0 +1,101 @@
+/* Sliding DFT magnitudes against FFTMagnitude() of the same window, drift over long runs and update cost */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "esp_dsp.h"
+#include "fft.h"
+#include "test_sim.h"
+
+#define N_BINS          4
+#define N_BLOCKS        50      /* blocks of samples processed for each lenght */
+#define BENCH_ITERATIONS    200
+/* FFTMagnitude() uses a symmetric Hann window, the sliding DFT a periodic one: difference is ~1/N of the peak */
+#define MAX_ERROR(n)    (1.5f / (n) + 1e-4f)
+
+static float signal[MAX_SIGNAL_LENGHT];
+static float fft[MAX_SIGNAL_LENGHT / 2];
+static float sliding_buffer[MAX_SIGNAL_LENGHT];
+static float sliding_state[FFT_SLIDING_LENGHT(N_BINS)];
+
+static float TestSample(uint32_t i)
+{
+    return 1650.0f + 1200.0f * sinf(2 * M_PI * 0.05f * i) + 300.0f * sinf(2 * M_PI * 0.31f * i)
+           + 20.0f * ((float)rand() / RAND_MAX - 0.5f);
+}
+
+bool test_fft_sliding(void)
+{
+    fft_sliding_t sliding;
+    float magnitude[N_BINS];
+
+    TEST_CHECK(FFTInit(), "FFTInit failed");
+
+    printf("\nSliding DFT (%i bins) vs FFTMagnitude of the last N samples\n", N_BINS);
+    printf("%6s %12s %12s %18s %18s\n", "N", "max error", "peak", "FFT " TICKS_UNIT "/sample", "SDFT " TICKS_UNIT "/sample");
+    srand(4);
+    for (int n = 64; n <= MAX_SIGNAL_LENGHT; n <<= 1) {
+        uint16_t bins[N_BINS] = {0, 1, n / 20, n / 2 - 1};
+        TEST_CHECK(FFTSlidingInit(&sliding, sliding_buffer, sliding_state, bins, N_BINS, n), "FFTSlidingInit failed");
+
+        /* Compare at several (not block aligned) positions of a long run */
+        float max_error = 0;
+        float peak = 0;
+        uint32_t total = N_BLOCKS * n;
+        for (uint32_t i = 0; i < total; i++) {
+            signal[i % n] = TestSample(i);
+            FFTSlidingUpdate(&sliding, signal[i % n]);
+            bool ready = FFTSlidingGetMagnitude(&sliding, magnitude);
+            TEST_CHECK(ready == (i >= n - 1), "N = %i, ready at sample %u", n, (unsigned)i);
+            if ((i % (n + 7) == n - 1) || (i == total - 1)) {
+                /* Last n samples, oldest first */
+                static float window[MAX_SIGNAL_LENGHT];
+                for (int j = 0; j < n; j++) {
+                    window[j] = signal[(i + 1 + j) % n];
+                }
+                FFTMagnitude(window, fft, n);
+                float block_peak = 0;
+                for (int k = 0; k < n / 2; k++) {
+                    block_peak = fmaxf(block_peak, fft[k]);
+                }
+                for (int k = 0; k < N_BINS; k++) {
+                    max_error = fmaxf(max_error, fabsf(magnitude[k] - fft[bins[k]]) / block_peak);
+                }
+                peak = block_peak;
+            }
+        }
+
+        uint32_t start = dsp_get_cpu_cycle_count();
+        for (int i = 0; i < BENCH_ITERATIONS; i++) {
+            FFTMagnitude(signal, fft, n);
+        }
+        uint32_t fft_ticks = (dsp_get_cpu_cycle_count() - start) / BENCH_ITERATIONS;
+        start = dsp_get_cpu_cycle_count();
+        for (int i = 0; i < BENCH_ITERATIONS; i++) {
+            for (int j = 0; j < n; j++) {
+                FFTSlidingUpdate(&sliding, signal[j]);
+            }
+        }
+        float sliding_ticks = (float)(dsp_get_cpu_cycle_count() - start) / (BENCH_ITERATIONS * n);
+
+        printf("%6i %12.6f %12.2f %18u %18.2f\n", n, max_error, peak, (unsigned)fft_ticks, sliding_ticks);
+        TEST_CHECK(max_error < MAX_ERROR(n), "N = %i, error %f", n, max_error);
+    }
+
+    /* A tone that appears is seen on the very next sample */
+    uint16_t bin = 8;
+    TEST_CHECK(FFTSlidingInit(&sliding, sliding_buffer, sliding_state, &bin, 1, 256), "FFTSlidingInit failed");
+    for (int i = 0; i < 256; i++) {
+        FFTSlidingUpdate(&sliding, 0);
+    }
+    FFTSlidingGetMagnitude(&sliding, magnitude);
+    TEST_CHECK(magnitude[0] < 1e-6f, "silence: %f", magnitude[0]);
+    FFTSlidingUpdate(&sliding, 1000.0f);
+    FFTSlidingGetMagnitude(&sliding, magnitude);
+    TEST_CHECK(magnitude[0] > 1e-3f, "impulse not detected: %f", magnitude[0]);
+
+    /* Invalid bins */
+    bin = 128;
+    TEST_CHECK(!FFTSlidingInit(&sliding, sliding_buffer, sliding_state, &bin, 1, 256), "bin N/2 accepted");
+    return true;
+}
@@ -0,0 +1,79 @@
+/* Const FFT tables: same values as the tables built at run time, FFTInit() only points to them */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "esp_dsp.h"
+#include "fft.h"
+#include "test_sim.h"
+
+#define MAX_FC32_ERROR  2e-6f   /* Error of the run time tables (float angles) */
+#define MAX_SC16_ERROR  1       /* LSB */
+
+static float table_fc32[2 * CONFIG_DSP_MAX_FFT_SIZE];
+static int16_t table_sc16[CONFIG_DSP_MAX_FFT_SIZE];
+
+bool test_fft_tables(void)
+{
+    /* Start from uninitialized tables, as at boot */
+    dsps_fft2r_deinit_fc32();
+    dsps_fft4r_deinit_fc32();
+    dsps_fft2r_deinit_sc16();
+    uint32_t start = dsp_get_cpu_cycle_count();
+    TEST_CHECK(FFTInit(), "FFTInit failed");
+    uint32_t init_ticks = dsp_get_cpu_cycle_count() - start;
+    TEST_CHECK(dsps_fft_w_table_fc32 == dsps_fft2r_w_table_fc32_const, "radix 2 table is not the const table");
+    TEST_CHECK(dsps_fft4r_w_table_fc32 == dsps_fft4r_w_table_fc32_const, "radix 4 table is not the const table");
+    TEST_CHECK(dsps_fft_w_table_sc16 == dsps_fft2r_w_table_sc16_const, "sc16 table is not the const table");
+
+    /* Radix 2: what dsps_fft2r_init_fc32() computes without const tables */
+    start = dsp_get_cpu_cycle_count();
+    dsps_gen_w_r2_fc32(table_fc32, CONFIG_DSP_MAX_FFT_SIZE);
+    dsps_bit_rev_fc32_ansi(table_fc32, CONFIG_DSP_MAX_FFT_SIZE / 2);
+    uint32_t runtime_ticks = dsp_get_cpu_cycle_count() - start;
+    for (int i = 0; i < CONFIG_DSP_MAX_FFT_SIZE; i++) {
+        TEST_CHECK(fabsf(dsps_fft2r_w_table_fc32_const[i] - table_fc32[i]) < MAX_FC32_ERROR, "radix 2 table differs at %i: %f %f", i, dsps_fft2r_w_table_fc32_const[i], table_fc32[i]);
+    }
+
+    /* Radix 4: CONFIG_DSP_MAX_FFT_SIZE complex values on the unit circle */
+    start = dsp_get_cpu_cycle_count();
+    for (int i = 0; i < CONFIG_DSP_MAX_FFT_SIZE; i++) {
+        float angle = 2 * M_PI * i / (float)CONFIG_DSP_MAX_FFT_SIZE;
+        table_fc32[2 * i + 0] = cosf(angle);
+        table_fc32[2 * i + 1] = sinf(angle);
+    }
+    runtime_ticks += dsp_get_cpu_cycle_count() - start;
+    TEST_CHECK(dsps_fft4r_w_table_size == CONFIG_DSP_MAX_FFT_SIZE, "radix 4 table size %i", dsps_fft4r_w_table_size);
+    for (int i = 0; i < 2 * CONFIG_DSP_MAX_FFT_SIZE; i++) {
+        TEST_CHECK(fabsf(dsps_fft4r_w_table_fc32_const[i] - table_fc32[i]) < MAX_FC32_ERROR, "radix 4 table differs at %i: %f %f", i, dsps_fft4r_w_table_fc32_const[i], table_fc32[i]);
+    }
+
+    /* sc16 */
+    start = dsp_get_cpu_cycle_count();
+    dsps_gen_w_r2_sc16(table_sc16, CONFIG_DSP_MAX_FFT_SIZE);
+    dsps_bit_rev_sc16_ansi(table_sc16, CONFIG_DSP_MAX_FFT_SIZE / 2);
+    runtime_ticks += dsp_get_cpu_cycle_count() - start;
+    for (int i = 0; i < CONFIG_DSP_MAX_FFT_SIZE; i++) {
+        TEST_CHECK(abs(dsps_fft2r_w_table_sc16_const[i] - table_sc16[i]) <= MAX_SC16_ERROR, "sc16 table differs at %i: %i %i", i, dsps_fft2r_w_table_sc16_const[i], table_sc16[i]);
+    }
+
+    /* sc16 bit reversal through the fc32 lookup tables, and with the direct loop above them */
+    for (int n = 4; n <= CONFIG_DSP_MAX_FFT_SIZE / 2; n *= 2) {
+        int bits = dsp_power_of_two(n);
+        for (int i = 0; i < n; i++) {
+            table_sc16[2 * i] = i;
+            table_sc16[2 * i + 1] = -i;
+        }
+        dsps_bit_rev_sc16_ansi(table_sc16, n);
+        for (int i = 0; i < n; i++) {
+            int reversed = 0;
+            for (int b = 0; b < bits; b++) {
+                reversed |= ((i >> b) & 1) << (bits - 1 - b);
+            }
+            TEST_CHECK((table_sc16[2 * i] == reversed) && (table_sc16[2 * i + 1] == -reversed), "sc16 bit reversal (%i) differs at %i", n, i);
+        }
+    }
+
+    printf("FFT tables for %i points: %lu " TICKS_UNIT " to compute, FFTInit %lu " TICKS_UNIT "\n", CONFIG_DSP_MAX_FFT_SIZE, (unsigned long)runtime_ticks, (unsigned long)init_ticks);
+    return true;
+}
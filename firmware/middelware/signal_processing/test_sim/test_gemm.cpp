@@ -0,0 +1,107 @@
+/* General matrix multiplication: dspm_gemm_f32 against a reference product, with transposed
+ * operands, strides, sizes across the cache blocks, and Mat::gemm on ROI sub-matrices */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "esp_dsp.h"
+#include "test_sim.h"
+
+#define MAX_DIM         140
+#define PADDING         3
+#define STRIDE          (MAX_DIM + PADDING)
+#define GUARD           -12345.0f
+#define MAX_ERROR       1e-5f   /* Relative to the sum of the absolute products */
+
+static const int dims[][3] = {{1, 1, 1}, {4, 4, 4}, {3, 5, 7}, {13, 6, 18}, {17, 130, 9}, {8, 33, 70}, {64, 64, 64}, {67, 140, 131}};
+
+static float A[MAX_DIM * STRIDE];
+static float B[MAX_DIM * STRIDE];
+static float C[MAX_DIM * STRIDE];
+static float C0[MAX_DIM * STRIDE];
+
+/* C0 = beta*C0 + alpha*op(A)*op(B) in double, and largest difference with C relative to the sum of |products| */
+static float Error(int m, int n, int k, float alpha, float beta, int A_trans, int B_trans)
+{
+    float max_error = 0;
+    for (int i = 0; i < m; i++) {
+        for (int j = 0; j < k; j++) {
+            double sum = 0, scale = fabsf(beta * C0[i * STRIDE + j]);
+            for (int s = 0; s < n; s++) {
+                double a = A_trans ? A[s * STRIDE + i] : A[i * STRIDE + s];
+                double b = B_trans ? B[j * STRIDE + s] : B[s * STRIDE + j];
+                sum += a * b;
+                scale += fabs(alpha * a * b);
+            }
+            double expected = ((beta == 0) ? 0 : beta * C0[i * STRIDE + j]) + alpha * sum;
+            max_error = fmaxf(max_error, fabs(C[i * STRIDE + j] - expected) / (scale + 1e-30));
+        }
+    }
+    return max_error;
+}
+
+extern "C" bool test_gemm(void)
+{
+    static const float alphas[] = {1, -0.5f};
+    static const float betas[] = {0, 1, 2};
+
+    srand(25);
+    for (int i = 0; i < MAX_DIM * STRIDE; i++) {
+        A[i] = (float)rand() / RAND_MAX - 0.5f;
+        B[i] = (float)rand() / RAND_MAX - 0.5f;
+        C0[i] = (float)rand() / RAND_MAX - 0.5f;
+    }
+
+    for (int d = 0; d < (int)(sizeof(dims) / sizeof(dims[0])); d++) {
+        int m = dims[d][0], n = dims[d][1], k = dims[d][2];
+        for (int t = 0; t < 4; t++) {
+            int A_trans = t & 1, B_trans = (t >> 1) & 1;
+            for (int a = 0; a < (int)(sizeof(alphas) / sizeof(alphas[0])); a++) {
+                for (int b = 0; b < (int)(sizeof(betas) / sizeof(betas[0])); b++) {
+                    /* C is a sub-matrix: guard values after each row, and NaN where beta is 0 */
+                    for (int i = 0; i < m; i++) {
+                        for (int j = 0; j < STRIDE; j++) {
+                            C[i * STRIDE + j] = (j >= k) ? GUARD : (betas[b] == 0) ? NAN : C0[i * STRIDE + j];
+                        }
+                    }
+                    TEST_CHECK(dspm_gemm_f32(A, B, C, m, n, k, alphas[a], betas[b], STRIDE, STRIDE, STRIDE, A_trans, B_trans) == ESP_OK,
+                               "dspm_gemm_f32 failed");
+                    float error = Error(m, n, k, alphas[a], betas[b], A_trans, B_trans);
+                    TEST_CHECK(error < MAX_ERROR, "dspm_gemm_f32 %ix%ix%i (trans %i %i, alpha %g, beta %g) error %g",
+                               m, n, k, A_trans, B_trans, alphas[a], betas[b], error);
+                    for (int i = 0; i < m; i++) {
+                        for (int j = k; j < STRIDE; j++) {
+                            TEST_CHECK(C[i * STRIDE + j] == GUARD, "dspm_gemm_f32 %ix%ix%i wrote outside of C", m, n, k);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    TEST_CHECK(dspm_gemm_f32(A, B, C, 0, 4, 4, 1, 0, 4, 4, 4, 0, 0) == ESP_ERR_DSP_INVALID_LENGTH, "dspm_gemm_f32 accepted 0 rows");
+    TEST_CHECK(dspm_gemm_f32(A, B, C, 4, 4, 4, 1, 0, 4, 4, 2, 0, 0) == ESP_ERR_DSP_INVALID_PARAM, "dspm_gemm_f32 accepted a short C stride");
+    TEST_CHECK(dspm_gemm_f32(A, B, C, 4, 6, 5, 1, 0, 5, 5, 5, 0, 0) == ESP_ERR_DSP_INVALID_PARAM, "dspm_gemm_f32 accepted a short A stride");
+    TEST_CHECK(dspm_gemm_f32(A, B, C, 4, 6, 5, 1, 0, 3, 6, 5, 1, 0) == ESP_ERR_DSP_INVALID_PARAM, "dspm_gemm_f32 accepted a short A' stride");
+    TEST_CHECK(dspm_gemm_f32(A, B, C, 4, 6, 5, 1, 0, 6, 4, 5, 0, 0) == ESP_ERR_DSP_INVALID_PARAM, "dspm_gemm_f32 accepted a short B stride");
+    TEST_CHECK(dspm_gemm_f32(A, B, C, 4, 6, 5, 1, 0, 6, 5, 5, 0, 1) == ESP_ERR_DSP_INVALID_PARAM, "dspm_gemm_f32 accepted a short B' stride");
+    TEST_CHECK(dspm_gemm_f32(A, B, C, 4, 6, 5, 1, 0, 4, 6, 5, 1, 1) == ESP_OK, "dspm_gemm_f32 rejected the smallest transposed strides");
+
+    /* Mat::gemm on ROI sub-matrices: same as the product of the copies */
+    dspm::Mat big_a(A, 20, 30), big_b(B, 30, 20), big_c(12, 15);
+    dspm::Mat a = big_a.getROI(2, 3, 9, 7);     // 9x7, used transposed
+    dspm::Mat b = big_b.getROI(5, 1, 9, 6);     // 9x6
+    dspm::Mat c = big_c.getROI(1, 2, 7, 6);     // 7x6
+    TEST_CHECK(dspm::Mat::gemm(2, a, true, b, false, 0, c) == ESP_OK, "Mat::gemm failed");
+    dspm::Mat expected = a.t() * b * 2;
+    for (int i = 0; i < 7; i++) {
+        for (int j = 0; j < 6; j++) {
+            TEST_CHECK(fabsf(c(i, j) - expected(i, j)) < MAX_ERROR * 10, "Mat::gemm ROI error at %i, %i", i, j);
+        }
+    }
+    TEST_CHECK((big_c(0, 2) == 0) && (big_c(1, 1) == 0) && (big_c(1, 8) == 0) && (big_c(8, 2) == 0), "Mat::gemm wrote outside of the ROI");
+    TEST_CHECK(dspm::Mat::gemm(1, a, false, b, false, 0, c) == ESP_ERR_DSP_INVALID_LENGTH, "Mat::gemm accepted wrong dimensions");
+
+    printf("\nGEMM: dspm_gemm_f32 and Mat::gemm match the reference product with transposes and strides (max error %g)\n", MAX_ERROR);
+    return true;
+}
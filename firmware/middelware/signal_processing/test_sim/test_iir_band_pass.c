@@ -0,0 +1,98 @@
+/* Fused band pass + mains notch cascade against the separate HiPassFilter() / LowPassFilter() / notch passes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "esp_dsp.h"
+#include "iir_filter.h"
+#include "test_sim.h"
+
+#define SAMPLE_FREC         500.0f  /* guia2_ej4 ECG playback rate */
+#define LOW_CUT_FREC        0.5f
+#define HIGH_CUT_FREC       40.0f
+#define SIGNAL_LENGHT       2000
+#define N_SECTIONS          IIR_BAND_PASS_SECTIONS(ORDER_2, ORDER_4, true)
+#define BENCH_ITERATIONS    50
+#define MAX_ERROR           1e-4f
+
+static float signal[SIGNAL_LENGHT];
+static float output[SIGNAL_LENGHT];
+static float reference[SIGNAL_LENGHT];
+static float coeffs[IIR_COEFFS_LENGHT(N_SECTIONS)];
+static float delay[IIR_DELAY_LENGHT(N_SECTIONS, 1)];
+
+/* Amplitude of a tone at the end of the filtered block */
+static float ToneGain(iir_filter_t * filter, float frec)
+{
+    float peak = 0;
+    for (int i = 0; i < SIGNAL_LENGHT; i++) {
+        signal[i] = sinf(2 * M_PI * frec * i / SAMPLE_FREC);
+    }
+    IIRFilterReset(filter);
+    IIRFilterProcess(filter, signal, output, SIGNAL_LENGHT);
+    for (int i = SIGNAL_LENGHT / 2; i < SIGNAL_LENGHT; i++) {
+        peak = fmaxf(peak, fabsf(output[i]));
+    }
+    return peak;
+}
+
+bool test_iir_band_pass(void)
+{
+    iir_filter_t filter;
+    float notch_coeffs[IIR_SOS_COEFFS];
+    float notch_delay[IIR_SOS_DELAY] = {0};
+
+    TEST_CHECK(IIRFilterInit(&filter, coeffs, delay, N_SECTIONS - 1, 1), "IIRFilterInit failed");
+    TEST_CHECK(!IIRFilterDesignBandPass(&filter, SAMPLE_FREC, LOW_CUT_FREC, ORDER_2, HIGH_CUT_FREC, ORDER_4, MAINS_50HZ),
+               "IIRFilterDesignBandPass accepted a wrong number of sections");
+    TEST_CHECK(IIRFilterInit(&filter, coeffs, delay, N_SECTIONS, 1), "IIRFilterInit failed");
+    TEST_CHECK(IIRFilterDesignBandPass(&filter, SAMPLE_FREC, LOW_CUT_FREC, ORDER_2, HIGH_CUT_FREC, ORDER_4, MAINS_50HZ),
+               "IIRFilterDesignBandPass failed");
+
+    /* ECG-like signal: pulses, baseline wander and mains interference */
+    srand(7);
+    for (int i = 0; i < SIGNAL_LENGHT; i++) {
+        signal[i] = ((i % 400) < 10 ? 1.0f : 0.0f) + 0.5f * sinf(2 * M_PI * 0.2f * i / SAMPLE_FREC)
+                    + 0.2f * sinf(2 * M_PI * MAINS_50HZ * i / SAMPLE_FREC) + 0.01f * ((float)rand() / RAND_MAX - 0.5f);
+    }
+    IIRFilterProcess(&filter, signal, output, SIGNAL_LENGHT);
+
+    /* Same chain as three passes over the data */
+    HiPassInit(SAMPLE_FREC, LOW_CUT_FREC, ORDER_2);
+    LowPassInit(SAMPLE_FREC, HIGH_CUT_FREC, ORDER_4);
+    memcpy(&notch_coeffs, &coeffs[IIR_COEFFS_LENGHT(N_SECTIONS - 1)], sizeof(notch_coeffs));
+    HiPassFilter(signal, reference, SIGNAL_LENGHT);
+    LowPassFilter(reference, reference, SIGNAL_LENGHT);
+    dsps_biquad_f32(reference, reference, SIGNAL_LENGHT, notch_coeffs, notch_delay);
+    float max_error = 0;
+    for (int i = 0; i < SIGNAL_LENGHT; i++) {
+        max_error = fmaxf(max_error, fabsf(output[i] - reference[i]));
+    }
+
+    uint32_t start = dsp_get_cpu_cycle_count();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        IIRFilterProcess(&filter, signal, output, SIGNAL_LENGHT);
+    }
+    float fused_ticks = (float)(dsp_get_cpu_cycle_count() - start) / (BENCH_ITERATIONS * SIGNAL_LENGHT);
+    start = dsp_get_cpu_cycle_count();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        HiPassFilter(signal, reference, SIGNAL_LENGHT);
+        LowPassFilter(reference, reference, SIGNAL_LENGHT);
+        dsps_biquad_f32(reference, reference, SIGNAL_LENGHT, notch_coeffs, notch_delay);
+    }
+    float passes_ticks = (float)(dsp_get_cpu_cycle_count() - start) / (BENCH_ITERATIONS * SIGNAL_LENGHT);
+
+    printf("\nBand pass %.1f-%.0f Hz + %.0f Hz notch at %.0f Hz (%i sections)\n", LOW_CUT_FREC, HIGH_CUT_FREC, MAINS_50HZ, SAMPLE_FREC, N_SECTIONS);
+    printf("max error against separate passes: %.2e\n", max_error);
+    printf("single pass: %.2f %s/sample, separate passes: %.2f %s/sample\n", fused_ticks, TICKS_UNIT, passes_ticks, TICKS_UNIT);
+    TEST_CHECK(max_error < MAX_ERROR, "error %e", max_error);
+
+    float pass_gain = ToneGain(&filter, 10.0f);
+    float mains_gain = ToneGain(&filter, MAINS_50HZ);
+    float wander_gain = ToneGain(&filter, 0.05f);
+    printf("gain at 10 Hz: %.3f, at %.0f Hz: %.1f dB, at 0.05 Hz: %.1f dB\n", pass_gain, MAINS_50HZ, 20 * log10f(mains_gain), 20 * log10f(wander_gain));
+    TEST_CHECK(fabsf(pass_gain - 1) < 0.05f, "pass band gain %f", pass_gain);
+    TEST_CHECK(mains_gain < 0.01f, "mains gain %f", mains_gain);
+    return true;
+}
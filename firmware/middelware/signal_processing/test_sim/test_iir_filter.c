@@ -0,0 +1,166 @@
+/* Filter objects (iir_filter_t) against the dsps_biquad_f32() cascade used before */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "esp_dsp.h"
+#include "iir_filter.h"
+#include "test_sim.h"
+
+#define SAMPLE_FREC         1000.0f
+#define CUT_FREC            40.0f
+#define SIGNAL_LENGHT       512
+#define N_CHANNELS          3
+#define MAX_SECTIONS        4
+#define MAX_ERROR           1e-4f
+#define BENCH_ITERATIONS    200
+
+static float signal[SIGNAL_LENGHT * N_CHANNELS];
+static float output[SIGNAL_LENGHT * N_CHANNELS];
+static float reference[SIGNAL_LENGHT];
+static float coeffs[IIR_COEFFS_LENGHT(MAX_SECTIONS)];
+static float delay[IIR_DELAY_LENGHT(MAX_SECTIONS, N_CHANNELS)];
+
+/* One dsps_biquad_f32() pass per section, as the original LowPassFilter() did */
+static void ReferenceCascade(const float * coeffs, int n_sections, const float * input, float * out, int ch)
+{
+    float w[MAX_SECTIONS][2] = {0};
+    for (int i = 0; i < SIGNAL_LENGHT; i++) {
+        out[i] = input[i * N_CHANNELS + ch];
+    }
+    for (int s = 0; s < n_sections; s++) {
+        dsps_biquad_f32(out, out, SIGNAL_LENGHT, (float *)&coeffs[s * IIR_SOS_COEFFS], w[s]);
+    }
+}
+
+bool test_iir_filter(void)
+{
+    iir_filter_t filter;
+
+    srand(4);
+    for (int i = 0; i < SIGNAL_LENGHT; i++) {
+        signal[i * N_CHANNELS + 0] = sinf(2 * M_PI * 10 * i / SAMPLE_FREC) + 0.5f * sinf(2 * M_PI * 120 * i / SAMPLE_FREC);
+        signal[i * N_CHANNELS + 1] = (i == 0) ? 1 : 0;
+        signal[i * N_CHANNELS + 2] = (float)rand() / RAND_MAX - 0.5f;
+    }
+
+    TEST_CHECK(!IIRFilterInit(&filter, coeffs, delay, 0, 1), "IIRFilterInit accepted 0 sections");
+    TEST_CHECK(!IIRFilterInit(&filter, coeffs, delay, 1, 0), "IIRFilterInit accepted 0 channels");
+
+    printf("\nIIRFilterProcess vs dsps_biquad_f32 cascade (%i channels, %i samples)\n", N_CHANNELS, SIGNAL_LENGHT);
+    printf("%6s %6s %12s %16s %16s\n", "type", "order", "max error", "process " TICKS_UNIT, "biquad " TICKS_UNIT);
+    for (int hp = 0; hp <= 1; hp++) {
+        for (int n_sections = 1; n_sections <= MAX_SECTIONS; n_sections++) {
+            TEST_CHECK(IIRFilterInit(&filter, coeffs, delay, n_sections, N_CHANNELS), "IIRFilterInit failed");
+            if (hp) {
+                IIRFilterDesignHiPass(&filter, SAMPLE_FREC, CUT_FREC);
+            } else {
+                IIRFilterDesignLowPass(&filter, SAMPLE_FREC, CUT_FREC);
+            }
+            /* Two halves, to check that the state is kept between calls, in place */
+            memcpy(output, signal, sizeof(signal));
+            IIRFilterProcess(&filter, output, output, SIGNAL_LENGHT / 2);
+            IIRFilterProcess(&filter, &output[SIGNAL_LENGHT / 2 * N_CHANNELS], &output[SIGNAL_LENGHT / 2 * N_CHANNELS], SIGNAL_LENGHT / 2);
+
+            float max_error = 0;
+            for (int ch = 0; ch < N_CHANNELS; ch++) {
+                ReferenceCascade(coeffs, n_sections, signal, reference, ch);
+                for (int i = 0; i < SIGNAL_LENGHT; i++) {
+                    max_error = fmaxf(max_error, fabsf(output[i * N_CHANNELS + ch] - reference[i]));
+                }
+            }
+
+            /* Legacy API must give the same result as the filter object (channel 0) */
+            for (int i = 0; i < SIGNAL_LENGHT; i++) {
+                reference[i] = signal[i * N_CHANNELS];
+            }
+            if (hp) {
+                HiPassInit(SAMPLE_FREC, CUT_FREC, n_sections * 2);
+                HiPassFilter(reference, reference, SIGNAL_LENGHT);
+            } else {
+                LowPassInit(SAMPLE_FREC, CUT_FREC, n_sections * 2);
+                LowPassFilter(reference, reference, SIGNAL_LENGHT);
+            }
+            for (int i = 0; i < SIGNAL_LENGHT; i++) {
+                TEST_CHECK(reference[i] == output[i * N_CHANNELS], "legacy API differs at sample %i", i);
+            }
+
+            uint32_t start = dsp_get_cpu_cycle_count();
+            for (int i = 0; i < BENCH_ITERATIONS; i++) {
+                IIRFilterProcess(&filter, signal, output, SIGNAL_LENGHT);
+            }
+            uint32_t process_ticks = (dsp_get_cpu_cycle_count() - start) / BENCH_ITERATIONS;
+            start = dsp_get_cpu_cycle_count();
+            for (int i = 0; i < BENCH_ITERATIONS; i++) {
+                for (int ch = 0; ch < N_CHANNELS; ch++) {
+                    ReferenceCascade(coeffs, n_sections, signal, reference, ch);
+                }
+            }
+            uint32_t biquad_ticks = (dsp_get_cpu_cycle_count() - start) / BENCH_ITERATIONS;
+
+            /* Sample by sample filtering must match block filtering exactly */
+            IIRFilterReset(&filter);
+            IIRFilterProcess(&filter, signal, output, SIGNAL_LENGHT);
+            IIRFilterReset(&filter);
+            for (int i = 0; i < SIGNAL_LENGHT; i++) {
+                for (int ch = 0; ch < N_CHANNELS; ch++) {
+                    float y = IIRFilterSample(&filter, ch, signal[i * N_CHANNELS + ch]);
+                    TEST_CHECK(y == output[i * N_CHANNELS + ch], "IIRFilterSample differs at sample %i, channel %i", i, ch);
+                }
+            }
+
+            printf("%6s %6i %12.2e %16u %16u\n", hp ? "HP" : "LP", n_sections * 2, max_error, (unsigned)process_ticks, (unsigned)biquad_ticks);
+            TEST_CHECK(max_error < MAX_ERROR, "order %i, error %e", n_sections * 2, max_error);
+        }
+    }
+    /* Legacy API: unsupported orders keep the previous filter, lengths below 1 do nothing */
+    for (int i = 0; i < SIGNAL_LENGHT; i++) {
+        output[i] = signal[i * N_CHANNELS];
+    }
+    LowPassInit(SAMPLE_FREC, CUT_FREC, ORDER_2);
+    HiPassInit(SAMPLE_FREC, CUT_FREC, ORDER_2);
+    LowPassInit(SAMPLE_FREC, CUT_FREC, ORDER_8 + 2);
+    HiPassInit(SAMPLE_FREC, CUT_FREC, 1);
+    LowPassFilter(output, reference, SIGNAL_LENGHT);
+    TEST_CHECK(IIRFilterInit(&filter, coeffs, delay, 1, 1), "IIRFilterInit failed");
+    IIRFilterDesignLowPass(&filter, SAMPLE_FREC, CUT_FREC);
+    IIRFilterProcess(&filter, output, output, SIGNAL_LENGHT);
+    for (int i = 0; i < SIGNAL_LENGHT; i++) {
+        TEST_CHECK(reference[i] == output[i], "LowPassInit with order %i changed the filter at sample %i", ORDER_8 + 2, i);
+    }
+    HiPassFilter(signal, reference, SIGNAL_LENGHT);
+    IIRFilterDesignHiPass(&filter, SAMPLE_FREC, CUT_FREC);
+    IIRFilterReset(&filter);
+    IIRFilterProcess(&filter, signal, output, SIGNAL_LENGHT);
+    for (int i = 0; i < SIGNAL_LENGHT; i++) {
+        TEST_CHECK(reference[i] == output[i], "HiPassInit with order 1 changed the filter at sample %i", i);
+    }
+    output[0] = reference[0] = 1234;
+    LowPassFilter(output, reference, -1);
+    HiPassFilter(output, reference, 0);
+    TEST_CHECK(reference[0] == 1234, "a length below 1 was filtered");
+
+    /* 16 bits samples through a floating point filter, one ISR-like call per sample */
+    static int16_t samples[SIGNAL_LENGHT];
+    TEST_CHECK(IIRFilterInit(&filter, coeffs, delay, MAX_SECTIONS, 1), "IIRFilterInit failed");
+    IIRFilterDesignLowPass(&filter, SAMPLE_FREC, CUT_FREC);
+    TEST_CHECK(IIRFilterSampleInt16(&filter, 1, 1234) == 1234, "invalid channel must return the input");
+    for (int i = 0; i < SIGNAL_LENGHT; i++) {
+        samples[i] = (int16_t)lrintf(16000 * signal[i * N_CHANNELS]);
+        output[i] = samples[i];
+    }
+    IIRFilterProcess(&filter, output, reference, SIGNAL_LENGHT);
+    IIRFilterReset(&filter);
+    for (int i = 0; i < SIGNAL_LENGHT; i++) {
+        int16_t y = IIRFilterSampleInt16(&filter, 0, samples[i]);
+        TEST_CHECK(fabsf(y - reference[i]) <= 0.5f, "IIRFilterSampleInt16 differs at sample %i", i);
+    }
+    uint32_t start = dsp_get_cpu_cycle_count();
+    for (int i = 0; i < SIGNAL_LENGHT; i++) {
+        samples[i] = IIRFilterSampleInt16(&filter, 0, samples[i]);
+    }
+    printf("\nIIRFilterSampleInt16, order %i float filter: %.2f %s per sample\n", MAX_SECTIONS * 2,
+           (float)(dsp_get_cpu_cycle_count() - start) / SIGNAL_LENGHT, TICKS_UNIT);
+    return true;
+}
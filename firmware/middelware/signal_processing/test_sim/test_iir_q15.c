@@ -0,0 +1,108 @@
+/* Golden model test of the fixed point (IIR_Q15) filters against the floating point cascade */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "esp_dsp.h"
+#include "iir_filter.h"
+#include "test_sim.h"
+
+#define SAMPLE_FREC         1000.0f
+#define SIGNAL_LENGHT       1024
+#define MAX_SECTIONS        4
+#define BENCH_ITERATIONS    200
+#define MIN_SNR             60.0f   /* dB, fixed point output against floating point output */
+
+static const float cut_frec[] = {5.0f, 40.0f, 200.0f};
+
+static int16_t signal_q15[SIGNAL_LENGHT];
+static int16_t output_q15[SIGNAL_LENGHT];
+static float signal[SIGNAL_LENGHT];
+static float output[SIGNAL_LENGHT];
+static float coeffs[IIR_COEFFS_LENGHT(MAX_SECTIONS)];
+static float delay[IIR_DELAY_LENGHT(MAX_SECTIONS, 1)];
+static float coeffs_design[IIR_COEFFS_LENGHT(MAX_SECTIONS)];
+static int32_t coeffs_q[IIR_COEFFS_LENGHT(MAX_SECTIONS)];
+static int16_t delay_q15[IIR_DELAY_Q15_LENGHT(MAX_SECTIONS, 1)];
+
+bool test_iir_q15(void)
+{
+    iir_filter_t filter, filter_q15;
+
+    /* Half scale multitone plus noise */
+    srand(5);
+    for (int i = 0; i < SIGNAL_LENGHT; i++) {
+        float value = 0.25f * sinf(2 * M_PI * 3 * i / SAMPLE_FREC) + 0.15f * sinf(2 * M_PI * 60 * i / SAMPLE_FREC)
+                      + 0.05f * sinf(2 * M_PI * 310 * i / SAMPLE_FREC) + 0.05f * ((float)rand() / RAND_MAX - 0.5f);
+        signal_q15[i] = (int16_t)lrintf(value * 32768);
+        signal[i] = signal_q15[i] / 32768.0f;
+    }
+
+    TEST_CHECK(!IIRFilterInitQ15(&filter_q15, coeffs_design, NULL, delay_q15, 1, 1), "IIRFilterInitQ15 accepted NULL coefficients");
+
+    printf("\nIIRFilterProcessQ15 vs IIRFilterProcess (%i samples at %.0f Hz)\n", SIGNAL_LENGHT, SAMPLE_FREC);
+    printf("%6s %6s %8s %10s %10s %16s %16s\n", "type", "order", "cut Hz", "max LSB", "SNR dB",
+           "float " TICKS_UNIT "/sample", "Q15 " TICKS_UNIT "/sample");
+    for (int hp = 0; hp <= 1; hp++) {
+        for (int f = 0; f < sizeof(cut_frec) / sizeof(cut_frec[0]); f++) {
+            for (int n_sections = 1; n_sections <= MAX_SECTIONS; n_sections++) {
+                TEST_CHECK(IIRFilterInit(&filter, coeffs, delay, n_sections, 1), "IIRFilterInit failed");
+                TEST_CHECK(IIRFilterInitQ15(&filter_q15, coeffs_design, coeffs_q, delay_q15, n_sections, 1), "IIRFilterInitQ15 failed");
+                if (hp) {
+                    IIRFilterDesignHiPass(&filter, SAMPLE_FREC, cut_frec[f]);
+                    IIRFilterDesignHiPass(&filter_q15, SAMPLE_FREC, cut_frec[f]);
+                } else {
+                    IIRFilterDesignLowPass(&filter, SAMPLE_FREC, cut_frec[f]);
+                    IIRFilterDesignLowPass(&filter_q15, SAMPLE_FREC, cut_frec[f]);
+                }
+                IIRFilterProcess(&filter, signal, output, SIGNAL_LENGHT);
+                IIRFilterProcessQ15(&filter_q15, signal_q15, output_q15, SIGNAL_LENGHT);
+
+                float max_error = 0;
+                double signal_power = 0, noise_power = 0;
+                for (int i = 0; i < SIGNAL_LENGHT; i++) {
+                    float error = output_q15[i] - output[i] * 32768;
+                    max_error = fmaxf(max_error, fabsf(error));
+                    signal_power += (double)output[i] * output[i] * 32768 * 32768;
+                    noise_power += (double)error * error;
+                }
+                float snr = 10 * log10(signal_power / (noise_power + 1e-12));
+
+                /* Sample by sample filtering must match block filtering exactly */
+                IIRFilterReset(&filter_q15);
+                for (int i = 0; i < SIGNAL_LENGHT; i++) {
+                    TEST_CHECK(IIRFilterSampleInt16(&filter_q15, 0, signal_q15[i]) == output_q15[i], "IIRFilterSampleInt16 differs at sample %i", i);
+                }
+
+                IIRFilterReset(&filter);
+                uint32_t start = dsp_get_cpu_cycle_count();
+                for (int i = 0; i < BENCH_ITERATIONS; i++) {
+                    IIRFilterProcess(&filter, signal, output, SIGNAL_LENGHT);
+                }
+                float float_ticks = (float)(dsp_get_cpu_cycle_count() - start) / (BENCH_ITERATIONS * SIGNAL_LENGHT);
+                IIRFilterReset(&filter_q15);
+                start = dsp_get_cpu_cycle_count();
+                for (int i = 0; i < BENCH_ITERATIONS; i++) {
+                    IIRFilterProcessQ15(&filter_q15, signal_q15, output_q15, SIGNAL_LENGHT);
+                }
+                float q15_ticks = (float)(dsp_get_cpu_cycle_count() - start) / (BENCH_ITERATIONS * SIGNAL_LENGHT);
+
+                printf("%6s %6i %8.0f %10.1f %10.1f %16.2f %16.2f\n", hp ? "HP" : "LP", n_sections * 2, cut_frec[f],
+                       max_error, snr, float_ticks, q15_ticks);
+                TEST_CHECK(snr > MIN_SNR, "order %i, cut %f Hz: SNR %f dB", n_sections * 2, cut_frec[f], snr);
+            }
+        }
+    }
+
+    /* Full scale square wave through an 8th order low pass overshoots: output must saturate instead of wrapping */
+    TEST_CHECK(IIRFilterInitQ15(&filter_q15, coeffs_design, coeffs_q, delay_q15, MAX_SECTIONS, 1), "IIRFilterInitQ15 failed");
+    IIRFilterDesignLowPass(&filter_q15, SAMPLE_FREC, 50.0f);
+    for (int i = 0; i < SIGNAL_LENGHT; i++) {
+        signal_q15[i] = ((i / 20) & 0x01) ? INT16_MAX : INT16_MIN;
+    }
+    IIRFilterProcessQ15(&filter_q15, signal_q15, output_q15, SIGNAL_LENGHT);
+    for (int i = 1; i < SIGNAL_LENGHT; i++) {
+        TEST_CHECK(abs(output_q15[i] - output_q15[i - 1]) < 16384, "output wrapped around at sample %i", i);
+    }
+    return true;
+}
@@ -0,0 +1,233 @@
+/* Level detectors: RMS, envelope and crest factor against their expected values, samples vs blocks, and their cost */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "esp_dsp.h"
+#include "level_detector.h"
+#include "test_sim.h"
+
+#define SAMPLE_FREQ         1000.0f
+#define SIGNAL_LENGHT       2000
+#define TONE_FREQ           50.0f
+#define AMPLITUDE           1000.0f
+#define BLOCK_LENGHT        100     /* 5 periods of the tone */
+#define RMS_TIME_MS         200.0f
+#define ATTACK_MS           10.0f
+#define HOLD_MS             50.0f
+#define RELEASE_MS          100.0f
+#define MAX_ERROR           0.01f   /* Relative */
+
+static float signal[SIGNAL_LENGHT];
+static int16_t signal_q15[SIGNAL_LENGHT];
+
+static bool Close(float value, float reference)
+{
+    return fabsf(value - reference) <= MAX_ERROR * fabsf(reference);
+}
+
+static void Tone(void)
+{
+    for (int i = 0; i < SIGNAL_LENGHT; i++) {
+        signal[i] = AMPLITUDE * sinf(2 * M_PI * TONE_FREQ / SAMPLE_FREQ * i);
+        signal_q15[i] = (int16_t)lrintf(signal[i]);
+    }
+}
+
+/* Same state after processing the signal sample by sample and in blocks of random lenght */
+static bool SamplesVsBlocks(void)
+{
+    level_rms_t rms[2], rms_exp[2];
+    level_rms_q15_t rms_q15[2], rms_exp_q15[2];
+    level_envelope_t env[2];
+    level_envelope_q15_t env_q15[2];
+    level_crest_t crest[2];
+    level_crest_q15_t crest_q15[2];
+
+    srand(18);
+    for (int i = 0; i < SIGNAL_LENGHT; i++) {
+        signal[i] = AMPLITUDE * ((float)rand() / RAND_MAX - 0.5f) * ((i / 300) % 3);
+        signal_q15[i] = (int16_t)lrintf(signal[i]);
+    }
+    for (int k = 0; k < 2; k++) {
+        memset(&rms[k], 0, sizeof(rms[k]));
+        memset(&rms_exp[k], 0, sizeof(rms_exp[k]));
+        memset(&rms_q15[k], 0, sizeof(rms_q15[k]));
+        memset(&rms_exp_q15[k], 0, sizeof(rms_exp_q15[k]));
+        memset(&env[k], 0, sizeof(env[k]));
+        memset(&env_q15[k], 0, sizeof(env_q15[k]));
+        memset(&crest[k], 0, sizeof(crest[k]));
+        memset(&crest_q15[k], 0, sizeof(crest_q15[k]));
+        LevelRMSInit(&rms[k], BLOCK_LENGHT);
+        LevelRMSInitExp(&rms_exp[k], SAMPLE_FREQ, RMS_TIME_MS);
+        LevelRMSInitQ15(&rms_q15[k], BLOCK_LENGHT);
+        LevelRMSInitExpQ15(&rms_exp_q15[k], SAMPLE_FREQ, RMS_TIME_MS);
+        LevelEnvelopeInit(&env[k], SAMPLE_FREQ, ATTACK_MS, HOLD_MS, RELEASE_MS);
+        LevelEnvelopeInitQ15(&env_q15[k], SAMPLE_FREQ, ATTACK_MS, HOLD_MS, RELEASE_MS);
+        LevelCrestInit(&crest[k], BLOCK_LENGHT);
+        LevelCrestInitQ15(&crest_q15[k], BLOCK_LENGHT);
+    }
+    int updates = 0, block_updates = 0;
+    for (int i = 0; i < SIGNAL_LENGHT; i++) {
+        LevelRMSSample(&rms_exp[0], signal[i]);
+        LevelRMSSampleQ15(&rms_q15[0], signal_q15[i]);
+        LevelRMSSampleQ15(&rms_exp_q15[0], signal_q15[i]);
+        LevelEnvelopeSample(&env[0], signal[i]);
+        LevelEnvelopeSampleQ15(&env_q15[0], signal_q15[i]);
+        LevelCrestSample(&crest[0], signal[i]);
+        LevelCrestSampleQ15(&crest_q15[0], signal_q15[i]);
+        updates += LevelRMSSample(&rms[0], signal[i]);
+    }
+    for (int i = 0; i < SIGNAL_LENGHT;) {
+        int lenght = 1 + rand() % 150;
+        if (i + lenght > SIGNAL_LENGHT) {
+            lenght = SIGNAL_LENGHT - i;
+        }
+        LevelRMSBlock(&rms_exp[1], &signal[i], lenght);
+        LevelRMSBlockQ15(&rms_q15[1], &signal_q15[i], lenght);
+        LevelRMSBlockQ15(&rms_exp_q15[1], &signal_q15[i], lenght);
+        LevelEnvelopeBlock(&env[1], &signal[i], lenght);
+        LevelEnvelopeBlockQ15(&env_q15[1], &signal_q15[i], lenght);
+        LevelCrestBlock(&crest[1], &signal[i], lenght);
+        LevelCrestBlockQ15(&crest_q15[1], &signal_q15[i], lenght);
+        block_updates += LevelRMSBlock(&rms[1], &signal[i], lenght);
+        i += lenght;
+    }
+    TEST_CHECK(updates == SIGNAL_LENGHT / BLOCK_LENGHT, "%i block RMS values for %i blocks", updates, SIGNAL_LENGHT / BLOCK_LENGHT);
+    TEST_CHECK(block_updates > 0, "LevelRMSBlock never reported a new value");
+    TEST_CHECK(memcmp(&rms[0], &rms[1], sizeof(rms[0])) == 0, "LevelRMSBlock differs from LevelRMSSample");
+    TEST_CHECK(memcmp(&rms_exp[0], &rms_exp[1], sizeof(rms_exp[0])) == 0, "LevelRMSBlock (exponential) differs from LevelRMSSample");
+    TEST_CHECK(memcmp(&rms_q15[0], &rms_q15[1], sizeof(rms_q15[0])) == 0, "LevelRMSBlockQ15 differs from LevelRMSSampleQ15");
+    TEST_CHECK(memcmp(&rms_exp_q15[0], &rms_exp_q15[1], sizeof(rms_exp_q15[0])) == 0, "LevelRMSBlockQ15 (exponential) differs from LevelRMSSampleQ15");
+    TEST_CHECK(memcmp(&env[0], &env[1], sizeof(env[0])) == 0, "LevelEnvelopeBlock differs from LevelEnvelopeSample");
+    TEST_CHECK(memcmp(&env_q15[0], &env_q15[1], sizeof(env_q15[0])) == 0, "LevelEnvelopeBlockQ15 differs from LevelEnvelopeSampleQ15");
+    TEST_CHECK(memcmp(&crest[0], &crest[1], sizeof(crest[0])) == 0, "LevelCrestBlock differs from LevelCrestSample");
+    TEST_CHECK(memcmp(&crest_q15[0], &crest_q15[1], sizeof(crest_q15[0])) == 0, "LevelCrestBlockQ15 differs from LevelCrestSampleQ15");
+    return true;
+}
+
+/* Envelope of a step up at 0 and down at SIGNAL_LENGHT / 2: attack, hold and release times */
+static bool EnvelopeStep(float attack_ms)
+{
+    level_envelope_t env;
+    level_envelope_q15_t env_q15;
+    int attack = (int)(attack_ms * SAMPLE_FREQ / 1000);
+    int hold = (int)(HOLD_MS * SAMPLE_FREQ / 1000);
+    int release = (int)(RELEASE_MS * SAMPLE_FREQ / 1000);
+    int down = SIGNAL_LENGHT / 2;
+
+    TEST_CHECK(LevelEnvelopeInit(&env, SAMPLE_FREQ, attack_ms, HOLD_MS, RELEASE_MS), "LevelEnvelopeInit failed");
+    TEST_CHECK(LevelEnvelopeInitQ15(&env_q15, SAMPLE_FREQ, attack_ms, HOLD_MS, RELEASE_MS), "LevelEnvelopeInitQ15 failed");
+    for (int i = 0; i < SIGNAL_LENGHT; i++) {
+        /* Alternating sign: the envelope follows the magnitude */
+        float value = (i < down) ? ((i & 1) ? -AMPLITUDE : AMPLITUDE) : 0;
+        LevelEnvelopeSample(&env, value);
+        LevelEnvelopeSampleQ15(&env_q15, (int16_t)value);
+        float expected = -1;
+        if ((attack > 0) && (i == attack - 1)) {
+            expected = AMPLITUDE * (1 - expf(-1));
+        } else if ((attack == 0) && (i == 0)) {
+            expected = AMPLITUDE;
+        } else if (i == down + hold - 1) {
+            expected = AMPLITUDE;
+        } else if (i == down + hold + release - 1) {
+            expected = AMPLITUDE * expf(-1);
+        }
+        if (expected >= 0) {
+            TEST_CHECK(Close(LevelEnvelopeGet(&env), expected), "attack %.0f ms, sample %i: envelope %f, expected %f", attack_ms, i, LevelEnvelopeGet(&env), expected);
+            TEST_CHECK(Close(LevelEnvelopeGetQ15(&env_q15), expected), "attack %.0f ms, sample %i: envelope (Q15) %u, expected %f", attack_ms, i, LevelEnvelopeGetQ15(&env_q15), expected);
+        }
+    }
+    return true;
+}
+
+bool test_level_detector(void)
+{
+    level_rms_t rms, rms_exp;
+    level_rms_q15_t rms_q15, rms_exp_q15;
+    level_envelope_t env;
+    level_envelope_q15_t env_q15;
+    level_crest_t crest;
+    level_crest_q15_t crest_q15;
+
+    TEST_CHECK(!LevelRMSInit(&rms, 0), "LevelRMSInit accepted a block of 0 samples");
+    TEST_CHECK(!LevelRMSInitExp(&rms, SAMPLE_FREQ, 0), "LevelRMSInitExp accepted a time constant of 0");
+    TEST_CHECK(!LevelRMSInitExpQ15(&rms_q15, 0, RMS_TIME_MS), "LevelRMSInitExpQ15 accepted a sample frequency of 0");
+    TEST_CHECK(!LevelEnvelopeInit(&env, SAMPLE_FREQ, -1, HOLD_MS, RELEASE_MS), "LevelEnvelopeInit accepted a negative attack");
+    TEST_CHECK(!LevelEnvelopeInitQ15(&env_q15, SAMPLE_FREQ, ATTACK_MS, NAN, RELEASE_MS), "LevelEnvelopeInitQ15 accepted a NAN hold");
+    TEST_CHECK(!LevelCrestInitQ15(&crest_q15, 0), "LevelCrestInitQ15 accepted a block of 0 samples");
+
+    /* RMS and crest factor of a tone */
+    Tone();
+    TEST_CHECK(LevelRMSInit(&rms, BLOCK_LENGHT) && LevelRMSInitExp(&rms_exp, SAMPLE_FREQ, RMS_TIME_MS), "LevelRMSInit failed");
+    TEST_CHECK(LevelRMSInitQ15(&rms_q15, BLOCK_LENGHT) && LevelRMSInitExpQ15(&rms_exp_q15, SAMPLE_FREQ, RMS_TIME_MS), "LevelRMSInitQ15 failed");
+    TEST_CHECK(LevelCrestInit(&crest, BLOCK_LENGHT) && LevelCrestInitQ15(&crest_q15, BLOCK_LENGHT), "LevelCrestInit failed");
+    TEST_CHECK(LevelRMSBlock(&rms, signal, SIGNAL_LENGHT), "LevelRMSBlock gave no value");
+    TEST_CHECK(LevelRMSBlock(&rms_exp, signal, SIGNAL_LENGHT), "LevelRMSBlock (exponential) gave no value");
+    TEST_CHECK(LevelRMSBlockQ15(&rms_q15, signal_q15, SIGNAL_LENGHT), "LevelRMSBlockQ15 gave no value");
+    TEST_CHECK(LevelRMSBlockQ15(&rms_exp_q15, signal_q15, SIGNAL_LENGHT), "LevelRMSBlockQ15 (exponential) gave no value");
+    TEST_CHECK(LevelCrestBlock(&crest, signal, SIGNAL_LENGHT), "LevelCrestBlock gave no value");
+    TEST_CHECK(LevelCrestBlockQ15(&crest_q15, signal_q15, SIGNAL_LENGHT), "LevelCrestBlockQ15 gave no value");
+    float expected = AMPLITUDE / sqrtf(2);
+    TEST_CHECK(fabsf(LevelRMSGet(&rms) - expected) < 0.01f, "block RMS %f, expected %f", LevelRMSGet(&rms), expected);
+    TEST_CHECK(abs(LevelRMSGetQ15(&rms_q15) - (int)lrintf(expected)) <= 1, "block RMS (Q15) %u, expected %f", LevelRMSGetQ15(&rms_q15), expected);
+    TEST_CHECK(Close(LevelRMSGet(&rms_exp), expected), "exponential RMS %f, expected %f", LevelRMSGet(&rms_exp), expected);
+    TEST_CHECK(Close(LevelRMSGetQ15(&rms_exp_q15), expected), "exponential RMS (Q15) %u, expected %f", LevelRMSGetQ15(&rms_exp_q15), expected);
+    TEST_CHECK(Close(LevelCrestGet(&crest), sqrtf(2)), "crest factor %f, expected %f", LevelCrestGet(&crest), sqrtf(2));
+    TEST_CHECK(Close(LevelCrestGetQ15(&crest_q15), sqrtf(2)), "crest factor (Q15) %f, expected %f", LevelCrestGetQ15(&crest_q15), sqrtf(2));
+
+    /* Square wave: crest factor 1 */
+    for (int i = 0; i < BLOCK_LENGHT; i++) {
+        signal[i] = (signal[i] >= 0) ? AMPLITUDE : -AMPLITUDE;
+        signal_q15[i] = (int16_t)signal[i];
+    }
+    TEST_CHECK(LevelCrestBlock(&crest, signal, BLOCK_LENGHT) && Close(LevelCrestGet(&crest), 1), "crest factor %f, expected 1", LevelCrestGet(&crest));
+    TEST_CHECK(LevelCrestBlockQ15(&crest_q15, signal_q15, BLOCK_LENGHT) && Close(LevelCrestGetQ15(&crest_q15), 1), "crest factor (Q15) %f, expected 1", LevelCrestGetQ15(&crest_q15));
+
+    /* Envelope and peak hold */
+    if (!EnvelopeStep(ATTACK_MS) || !EnvelopeStep(0)) {
+        return false;
+    }
+    if (!SamplesVsBlocks()) {
+        return false;
+    }
+
+    /* Cost per sample, processing blocks */
+    Tone();
+    LevelEnvelopeInit(&env, SAMPLE_FREQ, ATTACK_MS, HOLD_MS, RELEASE_MS);
+    LevelEnvelopeInitQ15(&env_q15, SAMPLE_FREQ, ATTACK_MS, HOLD_MS, RELEASE_MS);
+    uint32_t ticks[8];
+    uint32_t start = dsp_get_cpu_cycle_count();
+    LevelRMSBlock(&rms, signal, SIGNAL_LENGHT);
+    ticks[0] = dsp_get_cpu_cycle_count() - start;
+    start = dsp_get_cpu_cycle_count();
+    LevelRMSBlockQ15(&rms_q15, signal_q15, SIGNAL_LENGHT);
+    ticks[1] = dsp_get_cpu_cycle_count() - start;
+    start = dsp_get_cpu_cycle_count();
+    LevelRMSBlock(&rms_exp, signal, SIGNAL_LENGHT);
+    ticks[2] = dsp_get_cpu_cycle_count() - start;
+    start = dsp_get_cpu_cycle_count();
+    LevelRMSBlockQ15(&rms_exp_q15, signal_q15, SIGNAL_LENGHT);
+    ticks[3] = dsp_get_cpu_cycle_count() - start;
+    start = dsp_get_cpu_cycle_count();
+    LevelEnvelopeBlock(&env, signal, SIGNAL_LENGHT);
+    ticks[4] = dsp_get_cpu_cycle_count() - start;
+    start = dsp_get_cpu_cycle_count();
+    LevelEnvelopeBlockQ15(&env_q15, signal_q15, SIGNAL_LENGHT);
+    ticks[5] = dsp_get_cpu_cycle_count() - start;
+    start = dsp_get_cpu_cycle_count();
+    LevelCrestBlock(&crest, signal, SIGNAL_LENGHT);
+    ticks[6] = dsp_get_cpu_cycle_count() - start;
+    start = dsp_get_cpu_cycle_count();
+    LevelCrestBlockQ15(&crest_q15, signal_q15, SIGNAL_LENGHT);
+    ticks[7] = dsp_get_cpu_cycle_count() - start;
+
+    printf("\nLevel detectors (" TICKS_UNIT " per sample, blocks of %i samples)\n", SIGNAL_LENGHT);
+    printf("%16s %10s %10s\n", "", "float", "Q15");
+    printf("%16s %10.2f %10.2f\n", "block RMS", (float)ticks[0] / SIGNAL_LENGHT, (float)ticks[1] / SIGNAL_LENGHT);
+    printf("%16s %10.2f %10.2f\n", "exponential RMS", (float)ticks[2] / SIGNAL_LENGHT, (float)ticks[3] / SIGNAL_LENGHT);
+    printf("%16s %10.2f %10.2f\n", "envelope", (float)ticks[4] / SIGNAL_LENGHT, (float)ticks[5] / SIGNAL_LENGHT);
+    printf("%16s %10.2f %10.2f\n", "crest factor", (float)ticks[6] / SIGNAL_LENGHT, (float)ticks[7] / SIGNAL_LENGHT);
+    return true;
+}
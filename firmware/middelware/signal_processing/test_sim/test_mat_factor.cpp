@@ -0,0 +1,128 @@
+/* LU and LDL' decompositions: solutions, inverse and determinant (and Mat::det) with dspm::Mat products, rank one
+ * updates against a new decomposition, and no heap allocations after the constructor */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "mat.h"
+#include "mat_factor.h"
+#include "test_sim.h"
+
+#define N               6
+#define N_RHS           3
+#define MAX_ERROR       1e-4f   /* Relative to the largest value */
+
+uint32_t AllocCount(void);
+
+/* Largest difference against the reference values, relative to the largest reference value */
+static float Error(const dspm::Mat &values, const dspm::Mat &reference)
+{
+    float max_value = 0, max_error = 0;
+    for (int i = 0; i < reference.rows; i++) {
+        for (int j = 0; j < reference.cols; j++) {
+            max_value = fmaxf(max_value, fabsf(reference(i, j)));
+            max_error = fmaxf(max_error, fabsf(values(i, j) - reference(i, j)));
+        }
+    }
+    return max_error / max_value;
+}
+
+static void Random(dspm::Mat &m)
+{
+    for (int i = 0; i < m.rows; i++) {
+        for (int j = 0; j < m.cols; j++) {
+            m(i, j) = (float)rand() / RAND_MAX - 0.5f;
+        }
+    }
+}
+
+extern "C" bool test_mat_factor(void)
+{
+    dspm::Mat A(N, N), M(N, N), b(N, N_RHS), x(N, N_RHS);
+    dspm::Mat I = dspm::Mat::eye(N);
+    float v[N];
+
+    srand(24);
+    Random(A);
+    Random(M);
+    Random(b);
+    for (int i = 0; i < N; i++) {
+        v[i] = (float)rand() / RAND_MAX - 0.5f;
+    }
+    /* Covariance like matrix: S = M*M' + I */
+    dspm::Mat S = M * M.t() + I;
+
+    /* LU: solutions, inverse and determinant */
+    dspm::MatLU lu(A);
+    TEST_CHECK(lu.valid, "MatLU failed");
+    float error = Error(A * lu.solve(b), b);
+    TEST_CHECK(error < MAX_ERROR, "MatLU solve error %g", error);
+    error = Error(A * A.inverse(), I);
+    TEST_CHECK(error < MAX_ERROR, "Mat::inverse error %g", error);
+    /* det(A*A') = det(A)^2 */
+    float det = dspm::MatLDLT(A * A.t()).det();
+    TEST_CHECK(fabsf(lu.det() * lu.det() - det) < MAX_ERROR * det, "MatLU det^2 %g != %g", lu.det() * lu.det(), det);
+    TEST_CHECK(fabsf(A.det(N) - lu.det()) < MAX_ERROR * fabsf(lu.det()), "Mat::det %g != %g", A.det(N), lu.det());
+    float d3 = A(0, 0) * (A(1, 1) * A(2, 2) - A(1, 2) * A(2, 1)) - A(0, 1) * (A(1, 0) * A(2, 2) - A(1, 2) * A(2, 0)) +
+               A(0, 2) * (A(1, 0) * A(2, 1) - A(1, 1) * A(2, 0));
+    TEST_CHECK(fabsf(A.det(3) - d3) < MAX_ERROR, "Mat::det of the 3x3 sub-matrix %g != %g", A.det(3), d3);
+    TEST_CHECK(lu.factor(M) == ESP_OK, "MatLU factor failed");
+    error = Error(M * lu.solve(b), b);
+    TEST_CHECK(error < MAX_ERROR, "MatLU solve error %g after a new decomposition", error);
+
+    /* Singular and wrong size matrices */
+    dspm::Mat singular = A;
+    for (int j = 0; j < N; j++) {
+        singular(N - 1, j) = singular(0, j) + singular(1, j);
+    }
+    TEST_CHECK(lu.factor(singular) == ESP_ERR_DSP_INVALID_PARAM || fabsf(lu.det()) < MAX_ERROR, "MatLU accepted a singular matrix");
+    dspm::Mat zero(N, N);
+    TEST_CHECK(lu.factor(zero) == ESP_ERR_DSP_INVALID_PARAM, "MatLU accepted a zero matrix");
+    TEST_CHECK(lu.solve(b, x) == ESP_ERR_DSP_UNINITIALIZED, "MatLU solved without a decomposition");
+    TEST_CHECK(Error(zero.inverse() + I, I) == 0, "Mat::inverse of a zero matrix is not 0");
+    TEST_CHECK(singular.det(N) == 0 || fabsf(singular.det(N)) < MAX_ERROR, "Mat::det of a singular matrix is %g", singular.det(N));
+    TEST_CHECK(A.det(N + 1) == 0, "Mat::det accepted a size of %i", N + 1);
+    TEST_CHECK(lu.factor(b) == ESP_ERR_DSP_INVALID_LENGTH, "MatLU accepted a %ix%i matrix", N, N_RHS);
+
+    /* LDL': solutions, inverse and determinant of a symmetric matrix */
+    dspm::MatLDLT ldlt(S);
+    TEST_CHECK(ldlt.valid, "MatLDLT failed");
+    error = Error(S * ldlt.solve(b), b);
+    TEST_CHECK(error < MAX_ERROR, "MatLDLT solve error %g", error);
+    error = Error(S * ldlt.inverse(), I);
+    TEST_CHECK(error < MAX_ERROR, "MatLDLT inverse error %g", error);
+    lu.factor(S);
+    TEST_CHECK(fabsf(ldlt.det() - lu.det()) < MAX_ERROR * fabsf(lu.det()), "MatLDLT det %g != %g", ldlt.det(), lu.det());
+    TEST_CHECK(ldlt.factor(zero) == ESP_ERR_DSP_INVALID_PARAM, "MatLDLT accepted a zero matrix");
+
+    /* Rank one update and downdate: same as a new decomposition */
+    dspm::Mat V(v, N, 1);
+    dspm::Mat S_updated = S + V * V.t() * 0.5f;
+    dspm::MatLDLT reference(S_updated);
+    ldlt.factor(S);
+    TEST_CHECK(ldlt.update(v, 0.5f) == ESP_OK, "MatLDLT update failed");
+    error = Error(ldlt.LD, reference.LD);
+    TEST_CHECK(error < MAX_ERROR, "MatLDLT update error %g", error);
+    TEST_CHECK(ldlt.update(v, -0.5f) == ESP_OK, "MatLDLT downdate failed");
+    reference.factor(S);
+    error = Error(ldlt.LD, reference.LD);
+    TEST_CHECK(error < MAX_ERROR, "MatLDLT downdate error %g", error);
+
+    /* Solutions in place, and no allocations after the constructors */
+    dspm::Mat y = b;
+    uint32_t allocs = AllocCount();
+    lu.factor(A);
+    x = b;
+    lu.solve(x, x);
+    ldlt.factor(S);
+    ldlt.update(v, 0.5f);
+    ldlt.solve(y, y);
+    TEST_CHECK(AllocCount() == allocs, "decompositions allocated %u times", AllocCount() - allocs);
+    error = Error(A * x, b);
+    TEST_CHECK(error < MAX_ERROR, "MatLU solve error %g in place", error);
+    error = Error(S_updated * y, b);
+    TEST_CHECK(error < MAX_ERROR, "MatLDLT solve error %g in place after an update", error);
+
+    printf("\nMatrix decompositions: LU and LDL' solve, invert and update without allocations (max error %g)\n", MAX_ERROR);
+    return true;
+}
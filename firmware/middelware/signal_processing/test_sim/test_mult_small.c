@@ -0,0 +1,50 @@
+/* Unrolled 3x3 and 4x4 matrix kernels: same results as dspm_mult_f32_ansi, also in place */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_dsp.h"
+#include "test_sim.h"
+
+typedef esp_err_t (*mult_kernel_t)(const float *A, const float *B, float *C);
+
+static const struct {
+    const char * name;
+    mult_kernel_t kernel;
+    int m, n, k;
+} kernels[] = {
+    {"dspm_mult_3x3x1_f32", dspm_mult_3x3x1_f32, 3, 3, 1},
+    {"dspm_mult_3x3x3_f32", dspm_mult_3x3x3_f32, 3, 3, 3},
+    {"dspm_mult_4x4x1_f32", dspm_mult_4x4x1_f32, 4, 4, 1},
+    {"dspm_mult_4x4x4_f32", dspm_mult_4x4x4_f32, 4, 4, 4},
+};
+
+static float a[16], b[16], expected[16], result[16];
+
+bool test_mult_small(void)
+{
+    srand(23);
+    for (int i = 0; i < 16; i++) {
+        a[i] = (float)rand() / RAND_MAX - 0.5f;
+        b[i] = (float)rand() / RAND_MAX - 0.5f;
+    }
+    for (int t = 0; t < sizeof(kernels) / sizeof(kernels[0]); t++) {
+        int m = kernels[t].m, n = kernels[t].n, k = kernels[t].k;
+        dspm_mult_f32_ansi(a, b, expected, m, n, k);
+        TEST_CHECK(kernels[t].kernel(a, b, result) == ESP_OK, "%s failed", kernels[t].name);
+        TEST_CHECK(memcmp(result, expected, m * k * sizeof(float)) == 0, "%s is not the same as dspm_mult_f32_ansi", kernels[t].name);
+        memset(result, 0, sizeof(result));
+        TEST_CHECK(dspm_mult_shape_f32(a, b, result, m, n, k) == ESP_OK, "dspm_mult_shape_f32 failed");
+        TEST_CHECK(memcmp(result, expected, m * k * sizeof(float)) == 0, "dspm_mult_shape_f32 (%ix%ix%i) is not the same as dspm_mult_f32_ansi", m, n, k);
+        /* Result over the right operand (vectors and square matrices) */
+        memcpy(result, b, sizeof(b));
+        kernels[t].kernel(a, result, result);
+        TEST_CHECK(memcmp(result, expected, m * k * sizeof(float)) == 0, "%s in place is not the same as dspm_mult_f32_ansi", kernels[t].name);
+    }
+    /* Other shapes go to dspm_mult_f32 */
+    dspm_mult_f32_ansi(a, b, expected, 3, 4, 2);
+    dspm_mult_shape_f32(a, b, result, 3, 4, 2);
+    TEST_CHECK(memcmp(result, expected, 6 * sizeof(float)) == 0, "dspm_mult_shape_f32 (3x4x2) is not the same as dspm_mult_f32_ansi");
+    printf("\nSmall matrix kernels: 3x3x1, 3x3x3, 4x4x1 and 4x4x4 match dspm_mult_f32_ansi\n");
+    return true;
+}
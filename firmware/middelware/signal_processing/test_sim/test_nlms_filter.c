@@ -0,0 +1,176 @@
+/* NLMS filters: mains cancelling with a drifting mains frequency, system identification, samples vs blocks, and their cost */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "esp_dsp.h"
+#include "iir_filter.h"
+#include "nlms_filter.h"
+#include "test_sim.h"
+
+#define SAMPLE_FREQ         1000.0f
+#define SIGNAL_LENGHT       10000
+#define SETTLE_LENGHT       2000    /* Samples left out of the residual measurement */
+#define MAINS_DRIFT         0.05f   /* Mains frequency deviation of the tracking test, in Hz */
+#define HARMONICS           3
+#define MAINS_MU            0.04f
+#define PLANT_LENGHT        16      /* Taps of the unknown system of the identification test */
+#define IDENT_MU            0.05f
+#define MIN_MAINS_REJECTION 35.0f   /* dB, float and Q15, at the nominal mains frequency */
+#define MIN_DRIFT_REJECTION 20.0f   /* dB, float and Q15, with a MAINS_DRIFT deviation */
+#define MIN_IDENT_REJECTION 25.0f   /* dB, float and Q15 */
+
+static float clean[SIGNAL_LENGHT];
+static float input[SIGNAL_LENGHT];
+static float reference[SIGNAL_LENGHT];
+static float output[SIGNAL_LENGHT];
+static float output_blocks[SIGNAL_LENGHT];
+static int16_t input_q15[SIGNAL_LENGHT];
+static int16_t reference_q15[SIGNAL_LENGHT];
+static int16_t output_q15[SIGNAL_LENGHT];
+static int16_t output_blocks_q15[SIGNAL_LENGHT];
+static float weights[PLANT_LENGHT];
+static float delay[NLMS_DELAY_LENGHT(PLANT_LENGHT)];
+static int16_t weights_q15[PLANT_LENGHT];
+static int32_t weights_acc[PLANT_LENGHT];
+static int16_t delay_q15[NLMS_DELAY_LENGHT(PLANT_LENGHT)];
+
+/* Interference left in the output against the interference in the input, in dB */
+static float Rejection(const float * out, const int16_t * out_q15)
+{
+    float interference = 0, residual = 0;
+    for (int i = SETTLE_LENGHT; i < SIGNAL_LENGHT; i++) {
+        float value = (out != NULL) ? out[i] : out_q15[i];
+        interference += (input[i] - clean[i]) * (input[i] - clean[i]);
+        residual += (value - clean[i]) * (value - clean[i]);
+    }
+    return 10 * log10f(interference / residual);
+}
+
+/* ECG-like slow signal plus mains with harmonics, drift away from the nominal frequency */
+static void MainsSignal(float drift)
+{
+    srand(19);
+    for (int i = 0; i < SIGNAL_LENGHT; i++) {
+        float t = i / SAMPLE_FREQ;
+        float phase = 2 * M_PI * (MAINS_50HZ + drift) * t;
+        clean[i] = 800.0f * sinf(2 * M_PI * 1.2f * t) + 300.0f * sinf(2 * M_PI * 7.0f * t) + 10.0f * ((float)rand() / RAND_MAX - 0.5f);
+        input[i] = clean[i] + 1500.0f * sinf(phase + 0.7f) + 400.0f * sinf(2 * phase + 2.0f) + 600.0f * sinf(3 * phase - 1.0f);
+        input_q15[i] = (int16_t)lrintf(input[i]);
+    }
+}
+
+/* Noise reference through an unknown FIR system into the input */
+static void IdentificationSignal(float * plant)
+{
+    srand(190);
+    for (int k = 0; k < PLANT_LENGHT; k++) {
+        plant[k] = 0.5f * expf(-0.2f * k) * (((float)rand() / RAND_MAX) - 0.5f);
+    }
+    for (int i = 0; i < SIGNAL_LENGHT; i++) {
+        reference[i] = 8000.0f * ((float)rand() / RAND_MAX - 0.5f);
+        reference_q15[i] = (int16_t)lrintf(reference[i]);
+        float interference = 0;
+        for (int k = 0; k < PLANT_LENGHT && k <= i; k++) {
+            interference += plant[k] * reference_q15[i - k];
+        }
+        clean[i] = 200.0f * sinf(2 * M_PI * 3.0f * i / SAMPLE_FREQ);
+        input[i] = clean[i] + interference;
+        input_q15[i] = (int16_t)lrintf(input[i]);
+    }
+}
+
+bool test_nlms_filter(void)
+{
+    nlms_filter_t filter;
+    nlms_filter_q15_t filter_q15;
+    float plant[PLANT_LENGHT];
+
+    TEST_CHECK(!NLMSFilterInit(&filter, weights, delay, 0, IDENT_MU), "NLMSFilterInit accepted 0 weights");
+    TEST_CHECK(!NLMSFilterInit(&filter, weights, delay, PLANT_LENGHT, 2.0f), "NLMSFilterInit accepted mu = 2");
+    TEST_CHECK(!NLMSFilterInitQ15(&filter_q15, weights_q15, NULL, delay_q15, PLANT_LENGHT, IDENT_MU), "NLMSFilterInitQ15 accepted NULL weights");
+    TEST_CHECK(!NLMSFilterInitMains(&filter, weights, delay, SAMPLE_FREQ, MAINS_50HZ, NLMS_MAX_HARMONICS + 1, MAINS_MU), "NLMSFilterInitMains accepted %i harmonics", NLMS_MAX_HARMONICS + 1);
+    TEST_CHECK(!NLMSFilterInitMainsQ15(&filter_q15, weights_q15, weights_acc, delay_q15, 250.0f, MAINS_50HZ, 3, MAINS_MU), "NLMSFilterInitMainsQ15 accepted a harmonic above fs / 2");
+
+    printf("\nNLMS filters (interference rejection after %i samples)\n", SETTLE_LENGHT);
+    printf("%28s %12s %12s %16s %16s\n", "", "float dB", "Q15 dB", "float " TICKS_UNIT "/smp", "Q15 " TICKS_UNIT "/smp");
+
+    /* Mains canceller at the nominal mains frequency, and tracking a deviation of it */
+    float rejection, rejection_q15;
+    uint32_t start, ticks, ticks_q15;
+    for (int drift = 0; drift < 2; drift++) {
+        MainsSignal(drift * MAINS_DRIFT);
+        TEST_CHECK(NLMSFilterInitMains(&filter, weights, delay, SAMPLE_FREQ, MAINS_50HZ, HARMONICS, MAINS_MU), "NLMSFilterInitMains failed");
+        TEST_CHECK(NLMSFilterInitMainsQ15(&filter_q15, weights_q15, weights_acc, delay_q15, SAMPLE_FREQ, MAINS_50HZ, HARMONICS, MAINS_MU), "NLMSFilterInitMainsQ15 failed");
+        start = dsp_get_cpu_cycle_count();
+        NLMSFilterBlock(&filter, input, NULL, output, SIGNAL_LENGHT);
+        ticks = dsp_get_cpu_cycle_count() - start;
+        start = dsp_get_cpu_cycle_count();
+        NLMSFilterBlockQ15(&filter_q15, input_q15, NULL, output_q15, SIGNAL_LENGHT);
+        ticks_q15 = dsp_get_cpu_cycle_count() - start;
+        rejection = Rejection(output, NULL);
+        rejection_q15 = Rejection(NULL, output_q15);
+        printf("%20s %5.2f Hz %12.1f %12.1f %16.1f %16.1f\n", "mains, 3 harmonics,", MAINS_50HZ + drift * MAINS_DRIFT,
+               rejection, rejection_q15, (float)ticks / SIGNAL_LENGHT, (float)ticks_q15 / SIGNAL_LENGHT);
+        float min_rejection = drift ? MIN_DRIFT_REJECTION : MIN_MAINS_REJECTION;
+        TEST_CHECK(rejection > min_rejection, "mains canceller rejection %.1f dB", rejection);
+        TEST_CHECK(rejection_q15 > min_rejection, "mains canceller (Q15) rejection %.1f dB", rejection_q15);
+    }
+
+    /* Same output processing one sample at a time and in blocks */
+    NLMSFilterReset(&filter);
+    NLMSFilterResetQ15(&filter_q15);
+    for (int i = 0; i < SIGNAL_LENGHT; i++) {
+        output_blocks[i] = NLMSFilterSample(&filter, input[i], 0);
+        output_blocks_q15[i] = NLMSFilterSampleQ15(&filter_q15, input_q15[i], 0);
+    }
+    TEST_CHECK(memcmp(output, output_blocks, sizeof(output)) == 0, "NLMSFilterSample differs from NLMSFilterBlock");
+    TEST_CHECK(memcmp(output_q15, output_blocks_q15, sizeof(output_q15)) == 0, "NLMSFilterSampleQ15 differs from NLMSFilterBlockQ15");
+
+    /* External reference: the filter converges to the unknown system */
+    IdentificationSignal(plant);
+    TEST_CHECK(NLMSFilterInit(&filter, weights, delay, PLANT_LENGHT, IDENT_MU), "NLMSFilterInit failed");
+    TEST_CHECK(NLMSFilterInitQ15(&filter_q15, weights_q15, weights_acc, delay_q15, PLANT_LENGHT, IDENT_MU), "NLMSFilterInitQ15 failed");
+    start = dsp_get_cpu_cycle_count();
+    NLMSFilterBlock(&filter, input, reference, output, SIGNAL_LENGHT);
+    ticks = dsp_get_cpu_cycle_count() - start;
+    start = dsp_get_cpu_cycle_count();
+    NLMSFilterBlockQ15(&filter_q15, input_q15, reference_q15, output_q15, SIGNAL_LENGHT);
+    ticks_q15 = dsp_get_cpu_cycle_count() - start;
+    rejection = Rejection(output, NULL);
+    rejection_q15 = Rejection(NULL, output_q15);
+    printf("%28s %12.1f %12.1f %16.1f %16.1f\n", "external reference, 16 taps", rejection, rejection_q15,
+           (float)ticks / SIGNAL_LENGHT, (float)ticks_q15 / SIGNAL_LENGHT);
+    TEST_CHECK(rejection > MIN_IDENT_REJECTION, "identification rejection %.1f dB", rejection);
+    TEST_CHECK(rejection_q15 > MIN_IDENT_REJECTION, "identification (Q15) rejection %.1f dB", rejection_q15);
+    /* First weight multiplies the oldest reference sample, as in dsps_fir_f32() */
+    float max_error = 0;
+    for (int k = 0; k < PLANT_LENGHT; k++) {
+        max_error = fmaxf(max_error, fabsf(weights[PLANT_LENGHT - 1 - k] - plant[k]));
+    }
+    TEST_CHECK(max_error < 0.01f, "identified weights max error %f", max_error);
+
+    /* Long run with bursts of large reference samples: the running energy stays equal to the samples' energy */
+    float max_power_error = 0;
+    NLMSFilterReset(&filter);
+    srand(1900);
+    for (int burst = 0; burst < 20; burst++) {
+        float amplitude = (burst % 2) ? 1.0f : 30000.0f;
+        for (int i = 0; i < 997; i++) {
+            NLMSFilterSample(&filter, 0, amplitude * ((float)rand() / RAND_MAX - 0.5f));
+        }
+        float power = 0;
+        for (int k = 0; k < PLANT_LENGHT; k++) {
+            power += delay[filter.pos + k] * delay[filter.pos + k];
+        }
+        max_power_error = fmaxf(max_power_error, fabsf(filter.power - power) / power);
+    }
+    TEST_CHECK(max_power_error < 1e-3f, "reference energy error %g after %i samples", max_power_error, 20 * 997);
+
+    /* In place */
+    NLMSFilterReset(&filter);
+    NLMSFilterBlock(&filter, input, reference, input, SIGNAL_LENGHT);
+    TEST_CHECK(memcmp(input, output, sizeof(output)) == 0, "in place NLMSFilterBlock differs");
+    return true;
+}
@@ -0,0 +1,196 @@
+/* QRS detector replaying the ECG table of guia2_ej4 and a synthetic record with noise, baseline wander and mains */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "esp_dsp.h"
+#include "qrs_detector.h"
+#include "test_sim.h"
+
+#define ECG_LENGHT          231
+#define ECG_R_PEAK          133     /* Sample of the R peak in the table */
+#define ECG_TABLE_FREQ      250     /* The table holds one beat at ~65 bpm when sampled at 250 Hz */
+#define DAC_MV              (3300.0f / 255) /* guia2_ej4 writes the table to the DAC, read back in mV */
+#define REPLAY_SECONDS      60
+#define RECORD_SECONDS      300
+#define MAX_R_ERROR_MS      40      /* Reported R peak against the true one (band pass delay) */
+#define MATCH_MS            150     /* A detection within 150 ms of a beat is a true positive */
+#define CONFIRM_MS          500     /* Beats closer than this to the end may not be confirmed yet */
+#define MAX_BEATS           (RECORD_SECONDS * 3)
+
+/* ECG table of projects/guia2_ej4 */
+static const uint8_t ecg[ECG_LENGHT] = {
+    76, 77, 78, 77, 79, 86, 81, 76, 84, 93, 85, 80,
+    89, 95, 89, 85, 93, 98, 94, 88, 98, 105, 96, 91,
+    99, 105, 101, 96, 102, 106, 101, 96, 100, 107, 101,
+    94, 100, 104, 100, 91, 99, 103, 98, 91, 96, 105, 95,
+    88, 95, 100, 94, 85, 93, 99, 92, 84, 91, 96, 87, 80,
+    83, 92, 86, 78, 84, 89, 79, 73, 81, 83, 78, 70, 80, 82,
+    79, 69, 80, 82, 81, 70, 75, 81, 77, 74, 79, 83, 82, 72,
+    80, 87, 79, 76, 85, 95, 87, 81, 88, 93, 88, 84, 87, 94,
+    86, 82, 85, 94, 85, 82, 85, 95, 86, 83, 92, 99, 91, 88,
+    94, 98, 95, 90, 97, 105, 104, 94, 98, 114, 117, 124, 144,
+    180, 210, 236, 253, 227, 171, 99, 49, 34, 29, 43, 69, 89,
+    89, 90, 98, 107, 104, 98, 104, 110, 102, 98, 103, 111, 101,
+    94, 103, 108, 102, 95, 97, 106, 100, 92, 101, 103, 100, 94, 98,
+    103, 96, 90, 98, 103, 97, 90, 99, 104, 95, 90, 99, 104, 100, 93,
+    100, 106, 101, 93, 101, 105, 103, 96, 105, 112, 105, 99, 103, 108,
+    99, 96, 102, 106, 99, 90, 92, 100, 87, 80, 82, 88, 77, 69, 75, 79,
+    74, 67, 71, 78, 72, 67, 73, 81, 77, 71, 75, 84, 79, 77, 77, 76, 76,
+};
+
+static uint32_t true_r[MAX_BEATS];
+static uint32_t detected_r[MAX_BEATS];
+
+/* ECG table value at a time in seconds from the start of the beat (linear interpolation) */
+static float EcgTable(float t)
+{
+    float position = t * ECG_TABLE_FREQ;
+    if ((position < 0) || (position >= ECG_LENGHT - 1)) {
+        return ecg[0];
+    }
+    int i = (int)position;
+    float frac = position - i;
+    return ecg[i] * (1 - frac) + ecg[i + 1] * frac;
+}
+
+/* Beats, detected beats and false detections between the learning phase and the end of the signal */
+static void Match(const uint32_t * reference, int n_reference, const uint32_t * detected, int n_detected,
+                  uint32_t from, uint32_t to, uint16_t sample_freq, int * beats, int * true_positives,
+                  int * false_positives, int * max_error)
+{
+    uint32_t tolerance = MATCH_MS * sample_freq / 1000;
+    to -= CONFIRM_MS * sample_freq / 1000;
+    int d = 0;
+    *beats = 0;
+    *true_positives = 0;
+    *false_positives = 0;
+    *max_error = 0;
+    for (int r = 0; r < n_reference; r++) {
+        if ((reference[r] < from) || (reference[r] > to)) {
+            continue;
+        }
+        (*beats)++;
+        while ((d < n_detected) && (detected[d] + tolerance < reference[r])) {
+            *false_positives += (detected[d] >= from);
+            d++;
+        }
+        if ((d < n_detected) && (abs((int)detected[d] - (int)reference[r]) <= (int)tolerance)) {
+            int error = abs((int)detected[d] - (int)reference[r]) * 1000 / sample_freq;
+            *max_error = (error > *max_error) ? error : *max_error;
+            (*true_positives)++;
+            d++;
+        }
+    }
+    for (; (d < n_detected) && (detected[d] <= to); d++) {
+        (*false_positives)++;
+    }
+}
+
+/* Replay the table in a loop, as guia2_ej4 does */
+static bool TestReplay(uint16_t sample_freq)
+{
+    qrs_detector_t det;
+    qrs_beat_t beat;
+    int n_true = 0, n_detected = 0;
+    uint16_t heart_rate = 0;
+
+    TEST_CHECK(QRSDetectorInit(&det, sample_freq, MAINS_50HZ), "QRSDetectorInit (%i Hz) failed", sample_freq);
+    for (uint32_t n = 0; n < REPLAY_SECONDS * sample_freq; n++) {
+        int i = n % ECG_LENGHT;
+        if ((i == ECG_R_PEAK) && (n_true < MAX_BEATS)) {
+            true_r[n_true++] = n;
+        }
+        if (QRSDetectorProcess(&det, (int16_t)(ecg[i] * DAC_MV), &beat) && (n_detected < MAX_BEATS)) {
+            detected_r[n_detected++] = beat.r_peak;
+            heart_rate = beat.heart_rate;
+        }
+    }
+    int beats, true_positives, false_positives, max_error;
+    Match(true_r, n_true, detected_r, n_detected, 2 * sample_freq, REPLAY_SECONDS * sample_freq, sample_freq,
+          &beats, &true_positives, &false_positives, &max_error);
+    uint16_t expected_rate = (uint16_t)(60.0f * sample_freq / ECG_LENGHT + 0.5f);
+    printf("%6i %8s %8i %8i %8i %10i %8i\n", sample_freq, "table", beats, true_positives, false_positives, max_error, heart_rate);
+    TEST_CHECK(true_positives == beats, "%i Hz: %i of %i beats detected", sample_freq, true_positives, beats);
+    TEST_CHECK(false_positives == 0, "%i Hz: %i false detections", sample_freq, false_positives);
+    TEST_CHECK(max_error <= MAX_R_ERROR_MS, "%i Hz: R peak error of %i ms", sample_freq, max_error);
+    TEST_CHECK(abs(heart_rate - expected_rate) <= 1, "%i Hz: heart rate %i, expected %i", sample_freq, heart_rate, expected_rate);
+    return true;
+}
+
+/* Record built from the table beat with a varying heart rate, noise, baseline wander and 50 Hz */
+static bool TestRecord(uint16_t sample_freq)
+{
+    qrs_detector_t det;
+    qrs_beat_t beat;
+    int n_true = 0, n_detected = 0;
+    uint64_t total_ticks = 0;
+
+    srand(17);
+    /* Beats every 0.45 to 1.2 s (50 to 133 bpm), slowly changing */
+    float t_beat = 0.5f;
+    float rr = 0.8f;
+    while ((t_beat < RECORD_SECONDS) && (n_true < MAX_BEATS)) {
+        true_r[n_true++] = (uint32_t)(t_beat * sample_freq + 0.5f);
+        rr += 0.08f * ((float)rand() / RAND_MAX - 0.5f);
+        rr = fminf(fmaxf(rr, 0.45f), 1.2f);
+        t_beat += rr;
+    }
+
+    TEST_CHECK(QRSDetectorInit(&det, sample_freq, MAINS_50HZ), "QRSDetectorInit (%i Hz) failed", sample_freq);
+    int next = 0;
+    for (uint32_t n = 0; n < RECORD_SECONDS * sample_freq; n++) {
+        float t = (float)n / sample_freq;
+        /* Beats around this sample, with the R peak of the table at true_r */
+        while ((next < n_true) && (true_r[next] + sample_freq < n)) {
+            next++;
+        }
+        float value = 1650.0f;
+        for (int b = next; (b < n_true) && (b < next + 3); b++) {
+            float t_start = (float)true_r[b] / sample_freq - (float)ECG_R_PEAK / ECG_TABLE_FREQ;
+            float amplitude = 0.8f + 0.4f * (b % 5) / 4.0f;
+            value += amplitude * (EcgTable(t - t_start) - ecg[0]) * DAC_MV;
+        }
+        value += 300.0f * sinf(2 * M_PI * 0.3f * t) + 100.0f * sinf(2 * M_PI * 50.0f * t)
+                 + 60.0f * ((float)rand() / RAND_MAX - 0.5f);
+
+        uint32_t start = dsp_get_cpu_cycle_count();
+        bool found = QRSDetectorProcess(&det, (int16_t)value, &beat);
+        total_ticks += dsp_get_cpu_cycle_count() - start;
+        if (found && (n_detected < MAX_BEATS)) {
+            detected_r[n_detected++] = beat.r_peak;
+        }
+    }
+    int beats, true_positives, false_positives, max_error;
+    Match(true_r, n_true, detected_r, n_detected, 2 * sample_freq, RECORD_SECONDS * sample_freq, sample_freq,
+          &beats, &true_positives, &false_positives, &max_error);
+    printf("%6i %8s %8i %8i %8i %10i %8s %12u\n", sample_freq, "record", beats, true_positives, false_positives, max_error, "",
+           (unsigned)(total_ticks / (RECORD_SECONDS * sample_freq)));
+    TEST_CHECK(true_positives * 100 >= beats * 99, "%i Hz: %i of %i beats detected", sample_freq, true_positives, beats);
+    TEST_CHECK(false_positives * 100 <= beats, "%i Hz: %i false detections", sample_freq, false_positives);
+    TEST_CHECK(max_error <= MAX_R_ERROR_MS, "%i Hz: R peak error of %i ms", sample_freq, max_error);
+    return true;
+}
+
+bool test_qrs_detector(void)
+{
+    qrs_detector_t det;
+
+    TEST_CHECK(!QRSDetectorInit(&det, 200, 0), "QRSDetectorInit accepted 200 Hz");
+    TEST_CHECK(!QRSDetectorInit(&det, 2000, 0), "QRSDetectorInit accepted 2000 Hz");
+    TEST_CHECK(!QRSDetectorInit(&det, 250, 200), "QRSDetectorInit accepted a notch above fs / 2");
+
+    printf("\nQRS detector (beats after the 2 s learning phase)\n");
+    printf("%6s %8s %8s %8s %8s %10s %8s %12s\n", "fs", "signal", "beats", "found", "false", "R err ms", "bpm",
+           TICKS_UNIT "/sample");
+    if (!TestReplay(ECG_TABLE_FREQ) || !TestReplay(500)) {
+        return false;
+    }
+    static const uint16_t freqs[] = {250, 360, 500, 1000};
+    for (int f = 0; f < sizeof(freqs) / sizeof(freqs[0]); f++) {
+        if (!TestRecord(freqs[f])) {
+            return false;
+        }
+    }
+    return true;
+}
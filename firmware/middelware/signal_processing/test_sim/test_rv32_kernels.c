@@ -0,0 +1,199 @@
+/* RISC-V C kernels (_rv32): same results as the ANSI reference kernels, for any lenght */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "esp_dsp.h"
+#include "test_sim.h"
+
+#define MAX_LENGHT      259
+#define MAX_TAPS        67
+#define FFT_LENGHT      1024
+#define MAX_FLOAT_ERROR 1e-5f   /* Relative error of the float kernels that change the summation order */
+
+static const int lenghts[] = {1, 2, 3, 4, 5, 7, 8, 31, 64, 255, 259};
+static const int taps[] = {1, 3, 4, 8, 17, 32, 67};
+static const int decims[] = {1, 2, 3, 4};
+
+static float signal[MAX_LENGHT];
+static float signal_b[MAX_LENGHT];
+static float output[MAX_LENGHT];
+static float output_rv32[MAX_LENGHT];
+static int16_t signal_q15[MAX_LENGHT];
+static int16_t signal_b_q15[MAX_LENGHT];
+static int16_t output_q15[MAX_LENGHT];
+static int16_t output_rv32_q15[MAX_LENGHT];
+static float coeffs[MAX_TAPS];
+static float delay[MAX_TAPS + 4];
+static float delay_rv32[MAX_TAPS + 4];
+static int16_t coeffs_q15[MAX_TAPS];
+static int16_t delay_q15[MAX_TAPS];
+static int16_t delay_rv32_q15[MAX_TAPS];
+static int16_t fft_q15[2 * FFT_LENGHT];
+static int16_t fft_rv32_q15[2 * FFT_LENGHT];
+
+static bool Close(float value, float reference, float scale)
+{
+    return fabsf(value - reference) <= MAX_FLOAT_ERROR * (scale + fabsf(reference));
+}
+
+static bool TestDotprod(void)
+{
+    for (int l = 0; l < sizeof(lenghts) / sizeof(lenghts[0]); l++) {
+        int n = lenghts[l];
+        float dot = 0, dot_rv32 = 0;
+        dsps_dotprod_f32_ansi(signal, signal_b, &dot, n);
+        dsps_dotprod_f32_rv32(signal, signal_b, &dot_rv32, n);
+        TEST_CHECK(Close(dot_rv32, dot, n), "dsps_dotprod_f32_rv32 (%i): %f != %f", n, dot_rv32, dot);
+        for (int shift = 0; shift <= 15; shift += 5) {
+            int16_t dot_q15 = 0, dot_rv32_q15 = 0;
+            dsps_dotprod_s16_ansi(signal_q15, signal_b_q15, &dot_q15, n, shift);
+            dsps_dotprod_s16_rv32(signal_q15, signal_b_q15, &dot_rv32_q15, n, shift);
+            TEST_CHECK(dot_rv32_q15 == dot_q15, "dsps_dotprod_s16_rv32 (%i, shift %i): %i != %i", n, shift, dot_rv32_q15, dot_q15);
+        }
+    }
+    return true;
+}
+
+static bool TestFir(void)
+{
+    fir_f32_t fir, fir_rv32;
+    fir_s16_t fir_q15, fir_rv32_q15;
+
+    for (int t = 0; t < sizeof(taps) / sizeof(taps[0]); t++) {
+        for (int d = 0; d < sizeof(decims) / sizeof(decims[0]); d++) {
+            int decim = decims[d];
+            /* Several blocks, so the delay line position wraps at every tap */
+            dsps_fird_init_f32(&fir, coeffs, delay, taps[t], decim);
+            dsps_fird_init_f32(&fir_rv32, coeffs, delay_rv32, taps[t], decim);
+            for (int l = 0; l < sizeof(lenghts) / sizeof(lenghts[0]); l++) {
+                int n = lenghts[l] / decim;
+                int out = (decim == 1) ? (dsps_fir_f32_ansi(&fir, signal, output, n), n) : dsps_fird_f32_ansi(&fir, signal, output, n);
+                int out_rv32 = (decim == 1) ? (dsps_fir_f32_rv32(&fir_rv32, signal, output_rv32, n), n) : dsps_fird_f32_rv32(&fir_rv32, signal, output_rv32, n);
+                TEST_CHECK((out_rv32 == out) && (fir_rv32.pos == fir.pos), "dsps_fird_f32_rv32 (%i taps, decim %i): %i outputs", taps[t], decim, out_rv32);
+                for (int i = 0; i < out; i++) {
+                    TEST_CHECK(Close(output_rv32[i], output[i], 1), "dsps_fird_f32_rv32 (%i taps, decim %i, %i): %f != %f", taps[t], decim, i, output_rv32[i], output[i]);
+                }
+            }
+            if (taps[t] < 2) {
+                continue;   /* dsps_fird_init_s16() needs at least 2 taps */
+            }
+            dsps_fird_init_s16(&fir_q15, coeffs_q15, delay_q15, taps[t], decim, 0, 0);
+            dsps_fird_init_s16(&fir_rv32_q15, coeffs_q15, delay_rv32_q15, taps[t], decim, 0, 0);
+            for (int l = 0; l < sizeof(lenghts) / sizeof(lenghts[0]); l++) {
+                int n = lenghts[l] / decim;
+                int32_t out = dsps_fird_s16_ansi(&fir_q15, signal_q15, output_q15, n);
+                int32_t out_rv32 = dsps_fird_s16_rv32(&fir_rv32_q15, signal_q15, output_rv32_q15, n);
+                TEST_CHECK((out_rv32 == out) && (fir_rv32_q15.pos == fir_q15.pos), "dsps_fird_s16_rv32 (%i taps, decim %i): %i outputs", taps[t], decim, (int)out_rv32);
+                TEST_CHECK(memcmp(output_rv32_q15, output_q15, out * sizeof(int16_t)) == 0, "dsps_fird_s16_rv32 (%i taps, decim %i) output differs", taps[t], decim);
+            }
+        }
+    }
+    return true;
+}
+
+static bool TestBiquad(void)
+{
+    float coef[5];
+    float w[2] = {0, 0}, w_rv32[2] = {0, 0};
+
+    dsps_biquad_gen_lpf_f32(coef, 0.1f, 0.707f);
+    for (int l = 0; l < sizeof(lenghts) / sizeof(lenghts[0]); l++) {
+        int n = lenghts[l];
+        dsps_biquad_f32_ansi(signal, output, n, coef, w);
+        dsps_biquad_f32_rv32(signal, output_rv32, n, coef, w_rv32);
+        TEST_CHECK(memcmp(output_rv32, output, n * sizeof(float)) == 0, "dsps_biquad_f32_rv32 (%i) output differs", n);
+        TEST_CHECK((w_rv32[0] == w[0]) && (w_rv32[1] == w[1]), "dsps_biquad_f32_rv32 (%i) state differs", n);
+    }
+    return true;
+}
+
+static bool TestMath(void)
+{
+    for (int l = 0; l < sizeof(lenghts) / sizeof(lenghts[0]); l++) {
+        for (int step = 1; step <= 2; step++) {
+            int n = lenghts[l] / step;
+            for (int shift = 0; shift <= 15; shift += 15) {
+                dsps_mul_s16_ansi(signal_q15, signal_b_q15, output_q15, n, step, 1, step, shift);
+                dsps_mul_s16_rv32(signal_q15, signal_b_q15, output_rv32_q15, n, step, 1, step, shift);
+                TEST_CHECK(memcmp(output_rv32_q15, output_q15, n * step * sizeof(int16_t)) == 0, "dsps_mul_s16_rv32 (%i, step %i, shift %i) output differs", n, step, shift);
+                dsps_add_s16_ansi(signal_q15, signal_b_q15, output_q15, n, step, 1, step, shift);
+                dsps_add_s16_rv32(signal_q15, signal_b_q15, output_rv32_q15, n, step, 1, step, shift);
+                TEST_CHECK(memcmp(output_rv32_q15, output_q15, n * step * sizeof(int16_t)) == 0, "dsps_add_s16_rv32 (%i, step %i, shift %i) output differs", n, step, shift);
+            }
+        }
+        /* In place: output is the first input */
+        int n = lenghts[l];
+        dsps_mul_s16_ansi(signal_q15, signal_b_q15, output_q15, n, 1, 1, 1, 15);
+        memcpy(output_rv32_q15, signal_q15, n * sizeof(int16_t));
+        dsps_mul_s16_rv32(output_rv32_q15, signal_b_q15, output_rv32_q15, n, 1, 1, 1, 15);
+        TEST_CHECK(memcmp(output_rv32_q15, output_q15, n * sizeof(int16_t)) == 0, "dsps_mul_s16_rv32 (%i) in place output differs", n);
+        dsps_add_s16_ansi(signal_q15, signal_b_q15, output_q15, n, 1, 1, 1, 1);
+        memcpy(output_rv32_q15, signal_q15, n * sizeof(int16_t));
+        dsps_add_s16_rv32(output_rv32_q15, signal_b_q15, output_rv32_q15, n, 1, 1, 1, 1);
+        TEST_CHECK(memcmp(output_rv32_q15, output_q15, n * sizeof(int16_t)) == 0, "dsps_add_s16_rv32 (%i) in place output differs", n);
+    }
+    return true;
+}
+
+static bool TestMatrix(void)
+{
+    /* A[m][n] * B[n][k], with k both multiple and not multiple of the unrolling */
+    static const int sizes[][3] = {{1, 1, 1}, {3, 3, 3}, {4, 4, 4}, {3, 5, 7}, {6, 2, 9}, {8, 16, 5}, {15, 16, 16}};
+
+    for (int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        int m = sizes[s][0], n = sizes[s][1], k = sizes[s][2];
+        dspm_mult_f32_ansi(signal, signal_b, output, m, n, k);
+        dspm_mult_f32_rv32(signal, signal_b, output_rv32, m, n, k);
+        TEST_CHECK(memcmp(output_rv32, output, m * k * sizeof(float)) == 0, "dspm_mult_f32_rv32 (%ix%ix%i) output differs", m, n, k);
+        dspm_mult_s16_ansi(signal_q15, signal_b_q15, output_q15, m, n, k, 15);
+        dspm_mult_s16_rv32(signal_q15, signal_b_q15, output_rv32_q15, m, n, k, 15);
+        TEST_CHECK(memcmp(output_rv32_q15, output_q15, m * k * sizeof(int16_t)) == 0, "dspm_mult_s16_rv32 (%ix%ix%i) output differs", m, n, k);
+    }
+    /* No columns in A: C is 0, and A is not read */
+    output_rv32[0] = output_rv32[3 * 4 - 1] = 1;
+    dspm_mult_f32_rv32(NULL, signal_b, output_rv32, 3, 0, 4);
+    TEST_CHECK((output_rv32[0] == 0) && (output_rv32[3 * 4 - 1] == 0), "dspm_mult_f32_rv32 (3x0x4) output is not 0");
+    return true;
+}
+
+static bool TestFft(void)
+{
+    if (!dsps_fft2r_sc16_initialized) {
+        TEST_CHECK(dsps_fft2r_init_sc16(NULL, CONFIG_DSP_MAX_FFT_SIZE) == ESP_OK, "dsps_fft2r_init_sc16 failed");
+    }
+    for (int n = 2; n <= FFT_LENGHT; n *= 4) {
+        for (int i = 0; i < 2 * n; i++) {
+            fft_q15[i] = (int16_t)rand();
+        }
+        memcpy(fft_rv32_q15, fft_q15, 2 * n * sizeof(int16_t));
+        dsps_fft2r_sc16_ansi(fft_q15, n);
+        TEST_CHECK(dsps_fft2r_sc16_rv32(fft_rv32_q15, n) == ESP_OK, "dsps_fft2r_sc16_rv32 (%i) failed", n);
+        TEST_CHECK(memcmp(fft_rv32_q15, fft_q15, 2 * n * sizeof(int16_t)) == 0, "dsps_fft2r_sc16_rv32 (%i) output differs", n);
+    }
+    TEST_CHECK(dsps_fft2r_sc16_rv32(fft_rv32_q15, 3) == ESP_ERR_DSP_INVALID_LENGTH, "dsps_fft2r_sc16_rv32 accepted a lenght of 3");
+    return true;
+}
+
+bool test_rv32_kernels(void)
+{
+    /* Full scale random signals, so the 16 bits kernels saturate and wrap as the ANSI ones */
+    srand(12);
+    for (int i = 0; i < MAX_LENGHT; i++) {
+        signal[i] = (float)rand() / RAND_MAX - 0.5f;
+        signal_b[i] = (float)rand() / RAND_MAX - 0.5f;
+        signal_q15[i] = (int16_t)rand();
+        signal_b_q15[i] = (int16_t)rand();
+    }
+    for (int i = 0; i < MAX_TAPS; i++) {
+        coeffs[i] = (float)rand() / RAND_MAX - 0.5f;
+        coeffs_q15[i] = (int16_t)(rand() % 2048 - 1024);
+    }
+
+    if (!TestDotprod() || !TestFir() || !TestBiquad() || !TestMath() || !TestMatrix() || !TestFft()) {
+        return false;
+    }
+    printf("RISC-V kernels: dotprod, fir, fird, biquad, mul, add, mult and sc16 FFT match the ANSI kernels\n");
+    return true;
+}
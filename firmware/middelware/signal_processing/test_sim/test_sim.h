@@ -0,0 +1,20 @@
+#ifndef TEST_SIM_H_
+#define TEST_SIM_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "dsp_common.h"
+
+/* On the host dsp_get_cpu_cycle_count() counts nanoseconds, on target it counts CPU cycles */
+#define TICKS_UNIT "ns"
+
+#define TEST_CHECK(condition, ...) \
+    if (!(condition)) { \
+        printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+        printf(__VA_ARGS__); \
+        printf("\n"); \
+        return false; \
+    }
+
+#endif // TEST_SIM_H_
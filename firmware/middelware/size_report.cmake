@@ -0,0 +1,80 @@
+# Flash/RAM size of each middelware module, from the sizes of the objects in the
+# component library (before the linker removes the unused functions).
+#
+#   cmake -DSIZE_TOOL=<toolchain size> -DARCHIVE=<libmiddelware.a>
+#         -DMODULES=<module list> -DOUTPUT=<report> -P size_report.cmake
+#
+# Each line of MODULES is "<module>:<object>,<object>,...". flash = text + data
+# (text includes rodata), RAM = data + bss.
+
+execute_process(COMMAND ${SIZE_TOOL} ${ARCHIVE}
+                OUTPUT_VARIABLE size_output
+                RESULT_VARIABLE size_result)
+if(NOT size_result EQUAL 0)
+    message(WARNING "middelware size report: ${SIZE_TOOL} failed")
+    return()
+endif()
+
+# text, data and bss of each object
+string(REPLACE "\n" ";" size_lines "${size_output}")
+foreach(line ${size_lines})
+    if(line MATCHES "^[ \t]*([0-9]+)[ \t]+([0-9]+)[ \t]+([0-9]+)[ \t]+[0-9]+[ \t]+[0-9a-fA-F]+[ \t]+([^ \t]+)")
+        set(text_${CMAKE_MATCH_4} ${CMAKE_MATCH_1})
+        set(data_${CMAKE_MATCH_4} ${CMAKE_MATCH_2})
+        set(bss_${CMAKE_MATCH_4} ${CMAKE_MATCH_3})
+    endif()
+endforeach()
+
+# Right aligned value in a column of the given width
+function(size_column value width output)
+    string(LENGTH "${value}" value_width)
+    math(EXPR padding "${width} - ${value_width}")
+    if(padding LESS 1)
+        set(padding 1)
+    endif()
+    string(REPEAT " " ${padding} spaces)
+    set(${output} "${spaces}${value}" PARENT_SCOPE)
+endfunction()
+
+set(report "module                flash      RAM     text     data      bss\n")
+set(total_text 0)
+set(total_data 0)
+set(total_bss 0)
+file(STRINGS ${MODULES} module_lines)
+foreach(line ${module_lines})
+    string(REGEX MATCH "^[^:]+" module "${line}")
+    string(REGEX REPLACE "^[^:]+:" "" objects "${line}")
+    string(REPLACE "," ";" objects "${objects}")
+    set(text 0)
+    set(data 0)
+    set(bss 0)
+    foreach(object ${objects})
+        if(DEFINED text_${object})
+            math(EXPR text "${text} + ${text_${object}}")
+            math(EXPR data "${data} + ${data_${object}}")
+            math(EXPR bss "${bss} + ${bss_${object}}")
+        endif()
+    endforeach()
+    math(EXPR flash "${text} + ${data}")
+    math(EXPR ram "${data} + ${bss}")
+    math(EXPR total_text "${total_text} + ${text}")
+    math(EXPR total_data "${total_data} + ${data}")
+    math(EXPR total_bss "${total_bss} + ${bss}")
+    string(LENGTH "${module}" module_width)
+    math(EXPR padding "18 - ${module_width}")
+    string(REPEAT " " ${padding} spaces)
+    set(row "${module}${spaces}")
+    size_column(${flash} 9 column)
+    string(APPEND row "${column}")
+    foreach(value ${ram} ${text} ${data} ${bss})
+        size_column(${value} 9 column)
+        string(APPEND row "${column}")
+    endforeach()
+    string(APPEND report "${row}\n")
+endforeach()
+math(EXPR total_flash "${total_text} + ${total_data}")
+math(EXPR total_ram "${total_data} + ${total_bss}")
+string(APPEND report "total: ${total_flash} bytes of flash, ${total_ram} bytes of RAM\n")
+
+file(WRITE ${OUTPUT} "${report}")
+message(STATUS "middelware size report (${OUTPUT}):\n${report}")